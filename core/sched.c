@@ -37,6 +37,10 @@
 #include "xtimer.h"
 #endif
 
+#ifdef MODULE_SCHEDTRACE
+#include "schedtrace.h"
+#endif
+
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
@@ -104,6 +108,11 @@ int __attribute__((used)) sched_run(void)
     uint32_t now = xtimer_now().ticks32;
 #endif
 
+#ifdef MODULE_SCHEDTRACE
+    /* before the status of the active thread is changed, it tells why it leaves */
+    schedtrace_switch(active_thread, next_thread);
+#endif
+
     if (active_thread) {
         if (active_thread->status == STATUS_RUNNING) {
             active_thread->status = STATUS_PENDING;
@@ -53,7 +53,7 @@ TimerHandle_t xTimerCreate (const char * const pcTimerName,
                             void * const pvTimerID,
                             TimerCallbackFunction_t pxCallbackFunction)
 {
-    freertos_xtimer_t* timer = malloc(sizeof(freertos_xtimer_t));
+    freertos_xtimer_t* timer = calloc(1, sizeof(freertos_xtimer_t));
     if (timer == NULL) {
         return NULL;
     }
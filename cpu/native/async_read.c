@@ -20,22 +20,64 @@
 #include <err.h>
 #include <signal.h>
 #include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 #include <fcntl.h>
+#include <poll.h>
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif
 
 #include "async_read.h"
 #include "native_internal.h"
 
+#ifdef __linux__
+/**
+ * @brief   Number of ready file descriptors fetched per epoll_wait()
+ */
+#define ASYNC_READ_EVENTS (8)
+
+typedef struct {
+    native_async_read_callback_t cb;
+    void *arg;
+} _handler_t;
+
+static int _epfd = -1;
+static int _handlers_numof;
+/* indexed by file descriptor, NULL callback if not monitored */
+static _handler_t *_handlers;
+#else
 static int _next_index;
 static int _fds[ASYNC_READ_NUMOF];
 static void *_args[ASYNC_READ_NUMOF];
 static native_async_read_callback_t _native_async_read_callbacks[ASYNC_READ_NUMOF];
+#endif
 
 #ifdef __MACH__
 static pid_t _sigio_child_pids[ASYNC_READ_NUMOF];
 static void _sigio_child(int fd);
 #endif
 
+#ifdef __linux__
+static void _async_io_isr(void) {
+    struct epoll_event events[ASYNC_READ_EVENTS];
+    int n;
+
+    /* edge-triggered: only descriptors that became readable are returned,
+     * each of them once */
+    do {
+        n = epoll_wait(_epfd, events, ASYNC_READ_EVENTS, 0);
+
+        for (int i = 0; i < n; i++) {
+            int fd = events[i].data.fd;
+
+            if ((fd < _handlers_numof) && _handlers[fd].cb) {
+                _handlers[fd].cb(fd, _handlers[fd].arg);
+            }
+        }
+    } while (n == ASYNC_READ_EVENTS);
+}
+#else
 static void _async_io_isr(void) {
     fd_set rfds;
 
@@ -61,20 +103,41 @@ static void _async_io_isr(void) {
         }
     }
 }
+#endif
 
 void native_async_read_setup(void) {
+#ifdef __linux__
+    if (_epfd < 0) {
+        _epfd = epoll_create1(EPOLL_CLOEXEC);
+        if (_epfd < 0) {
+            err(EXIT_FAILURE, "native_async_read_setup(): epoll_create1");
+        }
+    }
+#endif
     register_interrupt(SIGIO, _async_io_isr);
 }
 
 void native_async_read_cleanup(void) {
     unregister_interrupt(SIGIO);
 
+#ifdef __linux__
+    for (int fd = 0; fd < _handlers_numof; fd++) {
+        if (_handlers[fd].cb) {
+            real_close(fd);
+        }
+    }
+    if (_epfd >= 0) {
+        real_close(_epfd);
+        _epfd = -1;
+    }
+#else
     for (int i = 0; i < _next_index; i++) {
 #ifdef __MACH__
         kill(_sigio_child_pids[i], SIGKILL);
 #endif
         real_close(_fds[i]);
     }
+#endif
 }
 
 void native_async_read_continue(int fd) {
@@ -85,10 +148,55 @@ void native_async_read_continue(int fd) {
             kill(_sigio_child_pids[i], SIGCONT);
         }
     }
+#else
+    struct pollfd pfd = { .fd = fd, .events = POLLIN };
+
+    _native_in_syscall++; /* no switching here */
+
+#ifdef __linux__
+    /* re-arm the descriptor: if there is still something to read, epoll
+     * reports it again although no new data arrived */
+    struct epoll_event ev = { .events = EPOLLIN | EPOLLET, .data = { .fd = fd } };
+    epoll_ctl(_epfd, EPOLL_CTL_MOD, fd, &ev);
+#endif
+    /* work around lost signals: SIGIO is only sent for new data */
+    if (poll(&pfd, 1, 0) == 1) {
+        int sig = SIGIO;
+        extern int _sig_pipefd[2];
+        real_write(_sig_pipefd[1], &sig, sizeof(int));
+        _native_sigpend++;
+    }
+
+    _native_in_syscall--;
 #endif
 }
 
 void native_async_read_add_handler(int fd, void *arg, native_async_read_callback_t handler) {
+#ifdef __linux__
+    if (fd >= _handlers_numof) {
+        int numof = (_handlers_numof > 0) ? _handlers_numof : ASYNC_READ_NUMOF;
+
+        while (numof <= fd) {
+            numof *= 2;
+        }
+        _handler_t *handlers = realloc(_handlers, numof * sizeof(_handler_t));
+        if (handlers == NULL) {
+            err(EXIT_FAILURE, "native_async_read_add_handler(): realloc");
+        }
+        memset(&handlers[_handlers_numof], 0,
+               (numof - _handlers_numof) * sizeof(_handler_t));
+        _handlers = handlers;
+        _handlers_numof = numof;
+    }
+
+    _handlers[fd].arg = arg;
+    _handlers[fd].cb = handler;
+
+    struct epoll_event ev = { .events = EPOLLIN | EPOLLET, .data = { .fd = fd } };
+    if (epoll_ctl(_epfd, EPOLL_CTL_ADD, fd, &ev) == -1) {
+        err(EXIT_FAILURE, "native_async_read_add_handler(): epoll_ctl");
+    }
+#else
     if (_next_index >= ASYNC_READ_NUMOF) {
         err(EXIT_FAILURE, "native_async_read_add_handler(): too many callbacks");
     }
@@ -96,6 +204,7 @@ void native_async_read_add_handler(int fd, void *arg, native_async_read_callback
     _fds[_next_index] = fd;
     _args[_next_index] = arg;
     _native_async_read_callbacks[_next_index] = handler;
+#endif
 
 #ifdef __MACH__
     /* tuntap signalled IO is not working in OSX,
@@ -112,7 +221,9 @@ void native_async_read_add_handler(int fd, void *arg, native_async_read_callback
     }
 #endif /* not OSX */
 
+#ifndef __linux__
     _next_index++;
+#endif
 }
 
 #ifdef __MACH__
@@ -13,6 +13,12 @@
  * @file
  * @brief       Multiple asynchronus read on file descriptors
  *
+ * The file descriptors signal SIGIO when they become readable. On Linux, the
+ * SIGIO handler then fetches the ready descriptors from an edge-triggered
+ * epoll set and calls their callbacks only, so its cost does not grow with
+ * the number of descriptors. Elsewhere, all descriptors are checked with
+ * select().
+ *
  * @author      Takuo Yonezawa <Yonezawa-T2@mail.dnp.co.jp>
  */
 #ifndef ASYNC_READ_H
@@ -24,6 +30,9 @@ extern "C" {
 
 /**
  * @brief   Maximum number of file descriptors
+ *
+ * On Linux, the number of file descriptors is not limited and this is the
+ * initial size of the table of callbacks.
  */
 #ifndef ASYNC_READ_NUMOF
 #define ASYNC_READ_NUMOF 2
@@ -51,7 +60,8 @@ void native_async_read_cleanup(void);
 /**
  * @brief   resume monitoring of file descriptors
  *
- * Call this function after reading file descriptors.
+ * Call this function after reading file descriptors. If there is still
+ * something to read from @p fd, the callback is called again.
  *
  * @param[in] fd  The file descriptor to monitor
  */
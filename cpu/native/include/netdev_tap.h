@@ -15,6 +15,10 @@
  * @brief       Definitions for @ref netdev ethernet driver for host system's
  *              TAP interfaces
  *
+ * On an interrupt, the driver reads up to @ref NETDEV_TAP_RX_FRAMES frames
+ * from the TAP into a staging ring. So netdev_driver_t::recv() reports the
+ * exact length of the next frame, and dropping a frame needs no read.
+ *
  * @author      Kaspar Schleiser <kaspar@schleiser.de>
  */
 #ifndef NETDEV_TAP_H
@@ -27,6 +31,7 @@ extern "C" {
 #include <stdint.h>
 #include "net/netdev.h"
 
+#include "net/ethernet.h"
 #include "net/ethernet/hdr.h"
 
 #ifdef __MACH__
@@ -35,6 +40,13 @@ extern "C" {
 #include "net/if.h"
 #endif
 
+/**
+ * @brief Number of received frames buffered per tap interface
+ */
+#ifndef NETDEV_TAP_RX_FRAMES
+#define NETDEV_TAP_RX_FRAMES    (8U)
+#endif
+
 /**
  * @brief tap interface state
  */
@@ -44,6 +56,13 @@ typedef struct netdev_tap {
     int tap_fd;                         /**< host file descriptor for the TAP */
     uint8_t addr[ETHERNET_ADDR_LEN];    /**< The MAC address of the TAP */
     uint8_t promiscous;                 /**< Flag for promiscous mode */
+    uint8_t rx_head;                    /**< oldest frame in rx_buf */
+    uint8_t rx_numof;                   /**< number of frames in rx_buf */
+    uint16_t rx_len[NETDEV_TAP_RX_FRAMES];  /**< lengths of the frames in rx_buf */
+    /**
+     * @brief   Frames read from the TAP, but not yet received
+     */
+    uint8_t rx_buf[NETDEV_TAP_RX_FRAMES][ETHERNET_FRAME_LEN];
 } netdev_tap_t;
 
 /**
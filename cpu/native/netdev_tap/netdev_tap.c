@@ -94,16 +94,48 @@ static inline int _set_promiscous(netdev_t *netdev, int value)
     return value;
 }
 
+static bool _fill(netdev_tap_t *dev);
+
 static inline void _isr(netdev_t *netdev)
 {
+    netdev_tap_t *dev = (netdev_tap_t*)netdev;
+
     if (netdev->event_callback) {
-        netdev->event_callback(netdev, NETDEV_EVENT_RX_COMPLETE);
+        _fill(dev);
+
+        /* every RX_COMPLETE receives at least one of the frames */
+        for (unsigned i = dev->rx_numof; (i > 0) && (dev->rx_numof > 0); i--) {
+            netdev->event_callback(netdev, NETDEV_EVENT_RX_COMPLETE);
+        }
     }
 #if DEVELHELP
     else {
         puts("netdev_tap: _isr(): no event_callback set.");
     }
 #endif
+
+    /* re-arms the async read, the TAP may also still hold frames that did
+     * not fit into the ring */
+    native_async_read_continue(dev->tap_fd);
+}
+
+static bool _rx_pending(netdev_tap_t *dev)
+{
+    if (dev->rx_numof > 0) {
+        return true;
+    }
+
+    fd_set rfds;
+    struct timeval t;
+    memset(&t, 0, sizeof(t));
+    FD_ZERO(&rfds);
+    FD_SET(dev->tap_fd, &rfds);
+
+    _native_in_syscall++; /* no switching here */
+    bool res = (real_select(dev->tap_fd + 1, &rfds, NULL, NULL, &t) == 1);
+    _native_in_syscall--;
+
+    return res;
 }
 
 static int _get(netdev_t *dev, netopt_t opt, void *value, size_t max_len)
@@ -124,6 +156,11 @@ static int _get(netdev_t *dev, netopt_t opt, void *value, size_t max_len)
             *((bool*)value) = (bool)_get_promiscous(dev);
             res = sizeof(bool);
             break;
+        case NETOPT_RX_PENDING:
+            *((netopt_enable_t *)value) = _rx_pending((netdev_tap_t *)dev)
+                                          ? NETOPT_ENABLE : NETOPT_DISABLE;
+            res = sizeof(netopt_enable_t);
+            break;
         default:
             res = netdev_eth_get(dev, opt, value, max_len);
             break;
@@ -177,104 +214,92 @@ static inline bool _is_addr_multicast(uint8_t *addr)
     return (addr[0] & 0x01);
 }
 
-static void _continue_reading(netdev_tap_t *dev)
+static bool _is_for_me(netdev_tap_t *dev, uint8_t *dst)
 {
-    /* work around lost signals */
-    fd_set rfds;
-    struct timeval t;
-    memset(&t, 0, sizeof(t));
-    FD_ZERO(&rfds);
-    FD_SET(dev->tap_fd, &rfds);
-
-    _native_in_syscall++; /* no switching here */
-
-    if (real_select(dev->tap_fd + 1, &rfds, NULL, NULL, &t) == 1) {
-        int sig = SIGIO;
-        extern int _sig_pipefd[2];
-        extern ssize_t (*real_write)(int fd, const void * buf, size_t count);
-        real_write(_sig_pipefd[1], &sig, sizeof(int));
-        _native_sigpend++;
-        DEBUG("netdev_tap: sigpend++\n");
-    }
-    else {
-        DEBUG("netdev_tap: native_async_read_continue\n");
-        native_async_read_continue(dev->tap_fd);
-    }
-
-    _native_in_syscall--;
+    return dev->promiscous || _is_addr_multicast(dst) ||
+           _is_addr_broadcast(dst) ||
+           (memcmp(dst, dev->addr, ETHERNET_ADDR_LEN) == 0);
 }
 
-static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
+/* reads frames from the TAP into the staging ring until there are no more
+ * or the ring is full, returns true in the latter case */
+static bool _fill(netdev_tap_t *dev)
 {
-    netdev_tap_t *dev = (netdev_tap_t*)netdev;
-    (void)info;
-
-    if (!buf) {
-        if (len > 0) {
-            /* no memory available in pktbuf, discarding the frame */
-            DEBUG("netdev_tap: discarding the frame\n");
-
-            /* repeating `real_read` for small size on tap device results in
-             * freeze for some reason. Using a large buffer for now. */
-            /*
-            uint8_t buf[4];
-            while (real_read(dev->tap_fd, buf, sizeof(buf)) > 0) {
+    while (dev->rx_numof < NETDEV_TAP_RX_FRAMES) {
+        unsigned tail = (dev->rx_head + dev->rx_numof) % NETDEV_TAP_RX_FRAMES;
+        uint8_t *frame = dev->rx_buf[tail];
+        int nread = real_read(dev->tap_fd, frame, ETHERNET_FRAME_LEN);
+
+        DEBUG("netdev_tap: read %d bytes\n", nread);
+        if (nread == -1) {
+            if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) {
+                return false;
             }
-            */
-
-            static uint8_t nullbuf[ETHERNET_FRAME_LEN];
-
-            real_read(dev->tap_fd, nullbuf, sizeof(nullbuf));
-
-            _continue_reading(dev);
+            err(EXIT_FAILURE, "netdev_tap: read");
+        }
+        else if (nread == 0) {
+            DEBUG("_native_handle_tap_input: ignoring null-event\n");
+            return false;
+        }
+        else if ((size_t)nread < sizeof(ethernet_hdr_t)) {
+            DEBUG("netdev_tap: frame too short => Dropped\n");
+            continue;
         }
 
-        /* no way of figuring out packet size without racey buffering,
-         * so we return the maximum possible size */
-        return ETHERNET_FRAME_LEN;
-    }
-
-    int nread = real_read(dev->tap_fd, buf, len);
-    DEBUG("netdev_tap: read %d bytes\n", nread);
-
-    if (nread > 0) {
-        ethernet_hdr_t *hdr = (ethernet_hdr_t *)buf;
-        if (!(dev->promiscous) && !_is_addr_multicast(hdr->dst) &&
-            !_is_addr_broadcast(hdr->dst) &&
-            (memcmp(hdr->dst, dev->addr, ETHERNET_ADDR_LEN) != 0)) {
+        ethernet_hdr_t *hdr = (ethernet_hdr_t *)frame;
+        if (!_is_for_me(dev, hdr->dst)) {
             DEBUG("netdev_tap: received for %02x:%02x:%02x:%02x:%02x:%02x\n"
                   "That's not me => Dropped\n",
                   hdr->dst[0], hdr->dst[1], hdr->dst[2],
                   hdr->dst[3], hdr->dst[4], hdr->dst[5]);
+            continue;
+        }
+        dev->rx_len[tail] = nread;
+        dev->rx_numof++;
+    }
+    return true;
+}
 
-            native_async_read_continue(dev->tap_fd);
+static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
+{
+    netdev_tap_t *dev = (netdev_tap_t*)netdev;
+    (void)info;
 
-            return 0;
+    if (dev->rx_numof == 0) {
+        /* called without an interrupt, e.g. for NETOPT_RX_PENDING */
+        if (_fill(dev)) {
+            native_async_read_continue(dev->tap_fd);
+        }
+        if (dev->rx_numof == 0) {
+            return (buf || len) ? -1 : 0;
         }
+    }
 
-        _continue_reading(dev);
+    unsigned head = dev->rx_head;
+    int nread = dev->rx_len[head];
 
-#ifdef MODULE_NETSTATS_L2
-        netdev->stats.rx_count++;
-        netdev->stats.rx_bytes += nread;
-#endif
-        return nread;
-    }
-    else if (nread == -1) {
-        if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) {
-        }
-        else {
-            err(EXIT_FAILURE, "netdev_tap: read");
+    if (!buf) {
+        if (len == 0) {
+            return nread;
         }
+        /* no memory available in pktbuf, discarding the frame */
+        DEBUG("netdev_tap: discarding the frame\n");
     }
-    else if (nread == 0) {
-        DEBUG("_native_handle_tap_input: ignoring null-event\n");
+    else if (len < (size_t)nread) {
+        DEBUG("netdev_tap: buffer too small, discarding the frame\n");
+        nread = -ENOBUFS;
     }
     else {
-        errx(EXIT_FAILURE, "internal error _rx_event");
+        memcpy(buf, dev->rx_buf[head], nread);
+#ifdef MODULE_NETSTATS_L2
+        netdev->stats.rx_count++;
+        netdev->stats.rx_bytes += nread;
+#endif
     }
+    dev->rx_head = (head + 1) % NETDEV_TAP_RX_FRAMES;
+    dev->rx_numof--;
 
-    return -1;
+    return nread;
 }
 
 static int _send(netdev_t *netdev, const iolist_t *iolist)
@@ -341,6 +366,8 @@ static int _init(netdev_t *netdev)
 #endif
     /* initialize device descriptor */
     dev->promiscous = 0;
+    dev->rx_head = 0;
+    dev->rx_numof = 0;
     /* implicitly create the tap interface */
     if ((dev->tap_fd = real_open(clonedev, O_RDWR | O_NONBLOCK)) == -1) {
         err(EXIT_FAILURE, "open(%s)", clonedev);
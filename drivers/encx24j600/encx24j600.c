@@ -409,6 +409,12 @@ static int _get(netdev_t *dev, netopt_t opt, void *value, size_t max_len)
                 *((netopt_enable_t *)value) = NETOPT_DISABLE;
             }
             return sizeof(netopt_enable_t);
+        case NETOPT_RX_PENDING:
+            lock((encx24j600_t *)dev);
+            *((netopt_enable_t *)value) = _packets_available((encx24j600_t *)dev)
+                                          ? NETOPT_ENABLE : NETOPT_DISABLE;
+            unlock((encx24j600_t *)dev);
+            return sizeof(netopt_enable_t);
         default:
             res = netdev_eth_get(dev, opt, value, max_len);
             break;
@@ -146,7 +146,7 @@ static void _api_at_cmd(xbee_t *dev, uint8_t *cmd, uint8_t size, resp_t *resp)
 
     xtimer_ticks64_t sent_time = xtimer_now64();
 
-    xtimer_t resp_timer;
+    xtimer_t resp_timer = { 0 };
 
     resp_timer.callback = isr_resp_timeout;
     resp_timer.arg = dev;
@@ -146,7 +146,7 @@ int sock_udp_get_remote(sock_udp_t *sock, sock_udp_ep_t *ep)
 int sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
                   uint32_t timeout, sock_udp_ep_t *remote)
 {
-    xtimer_t timeout_timer;
+    xtimer_t timeout_timer = { 0 };
     int blocking = BLOCKING;
     int res = -EIO;
     msg_t msg;
@@ -18,6 +18,8 @@
 * @}
 */
 
+#include <string.h>
+
 #include "crypto/helper.h"
 #include "crypto/modes/ctr.h"
 
@@ -26,24 +28,32 @@ int cipher_encrypt_ctr(cipher_t* cipher, uint8_t nonce_counter[16],
                        uint8_t* output)
 {
     size_t offset = 0;
-    uint8_t stream_block[16] = {0}, block_size;
+    uint8_t stream_block[CIPHER_BATCH_BLOCKS * 16] = {0}, block_size;
 
     block_size = cipher_get_block_size(cipher);
     do {
-        uint8_t block_size_input;
+        size_t numof = 0;
+        size_t stream_len;
+
+        /* the key stream of several counter values is generated at once */
+        do {
+            memcpy(stream_block + numof * block_size, nonce_counter, block_size);
+            crypto_block_inc_ctr(nonce_counter, block_size - nonce_len);
+            numof++;
+        } while ((numof < CIPHER_BATCH_BLOCKS) &&
+                 (offset + numof * block_size < length));
 
-        if (cipher_encrypt(cipher, nonce_counter, stream_block) != 1) {
+        if (cipher_encrypt_blocks(cipher, stream_block, stream_block, numof) != 1) {
             return CIPHER_ERR_ENC_FAILED;
         }
 
-        block_size_input = (length - offset > block_size) ?
-                           block_size : length - offset;
-        for (uint8_t i = 0; i < block_size_input; ++i) {
+        stream_len = (length - offset > numof * block_size) ?
+                     numof * block_size : length - offset;
+        for (size_t i = 0; i < stream_len; ++i) {
             output[offset + i] = stream_block[i] ^ input[offset + i];
         }
 
-        offset += block_size_input;
-        crypto_block_inc_ctr(nonce_counter, block_size - nonce_len);
+        offset += stream_len;
     } while (offset < length);
 
     return offset;
@@ -31,6 +31,261 @@
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
+static void _set_timer(xtimer_t *timer, uint32_t offset_ms)
+{
+    uint64_t offset_us = (uint64_t)offset_ms * US_PER_MS;
+
+    DEBUG("evtimer: now=%" PRIu32 " us setting xtimer to %" PRIu32 ":%" PRIu32 " us\n",
+          xtimer_now_usec(), (uint32_t)(offset_us >> 32), (uint32_t)(offset_us));
+
+    xtimer_set64(timer, offset_us);
+}
+
+#ifdef MODULE_EVTIMER_HEAP
+/*
+ * The events form a pairing heap with evtimer->events as its root: next links
+ * the siblings, child the first child and prev points to the left sibling or,
+ * for the first child, to the parent. offset holds the absolute expiry time in
+ * milliseconds, compared relative to evtimer->base which is never after the
+ * expiry of any pending event.
+ */
+static uint32_t _now_ms(void)
+{
+    uint64_t now = xtimer_now_usec64() >> 3;
+
+    /* wrap around like a 32 bit millisecond counter, div_u64_by_125() only
+     * takes values with a 32 bit result */
+    now = ((uint64_t)((uint32_t)(now >> 32) % 125) << 32) | (uint32_t)now;
+    return div_u64_by_125(now);
+}
+
+static inline int _before(const evtimer_t *evtimer, const evtimer_event_t *a,
+                          const evtimer_event_t *b)
+{
+    return (a->offset - evtimer->base) < (b->offset - evtimer->base);
+}
+
+/* links two roots, the one expiring later becomes the first child */
+static evtimer_event_t *_meld(const evtimer_t *evtimer, evtimer_event_t *a,
+                              evtimer_event_t *b)
+{
+    if (!a) {
+        return b;
+    }
+    if (!b) {
+        return a;
+    }
+    if (_before(evtimer, b, a)) {
+        evtimer_event_t *tmp = a;
+        a = b;
+        b = tmp;
+    }
+    b->prev = a;
+    b->next = a->child;
+    if (a->child) {
+        a->child->prev = b;
+    }
+    a->child = b;
+    return a;
+}
+
+/* melds a list of siblings into a single root, pairwise from left to right
+ * and then the pairs from right to left */
+static evtimer_event_t *_merge_pairs(const evtimer_t *evtimer,
+                                     evtimer_event_t *first)
+{
+    evtimer_event_t *pairs = NULL;
+    evtimer_event_t *root = NULL;
+
+    while (first) {
+        evtimer_event_t *a = first;
+        evtimer_event_t *b = first->next;
+
+        first = (b) ? b->next : NULL;
+        a->next = a->prev = NULL;
+        if (b) {
+            b->next = b->prev = NULL;
+        }
+        a = _meld(evtimer, a, b);
+        a->next = pairs;
+        pairs = a;
+    }
+    while (pairs) {
+        evtimer_event_t *next = pairs->next;
+
+        pairs->next = NULL;
+        root = _meld(evtimer, root, pairs);
+        pairs = next;
+    }
+    return root;
+}
+
+static evtimer_event_t *_pop(evtimer_t *evtimer)
+{
+    evtimer_event_t *event = evtimer->events;
+
+    evtimer->events = _merge_pairs(evtimer, event->child);
+    event->child = NULL;
+    return event;
+}
+
+/* moves the base to now, or to the expiry of the first event if that is due
+ * already, and returns now */
+static uint32_t _update_base(evtimer_t *evtimer)
+{
+    uint32_t now = _now_ms();
+
+    if (evtimer->events &&
+        ((evtimer->events->offset - evtimer->base) <= (now - evtimer->base))) {
+        evtimer->base = evtimer->events->offset;
+    }
+    else {
+        evtimer->base = now;
+    }
+    return now;
+}
+
+static void _update_timer(evtimer_t *evtimer)
+{
+    if (evtimer->events) {
+        uint32_t now = _now_ms() - evtimer->base;
+        uint32_t target = evtimer->events->offset - evtimer->base;
+
+        _set_timer(&evtimer->timer, (target > now) ? (target - now) : 0);
+    }
+    else {
+        xtimer_remove(&evtimer->timer);
+    }
+}
+
+void evtimer_add(evtimer_t *evtimer, evtimer_event_t *event)
+{
+    unsigned state = irq_disable();
+    uint32_t now = _update_base(evtimer);
+    uint32_t late = now - evtimer->base;
+
+    DEBUG("evtimer_add(): adding event with offset %" PRIu32 "\n", event->offset);
+
+    /* the base lags behind now while the first event is overdue, so the
+     * expiry of far events has to be capped to stay comparable */
+    if (event->offset > (UINT32_MAX - late)) {
+        event->offset = evtimer->base + UINT32_MAX;
+    }
+    else {
+        event->offset += now;
+    }
+    event->next = event->prev = event->child = NULL;
+    evtimer->events = _meld(evtimer, evtimer->events, event);
+    if (evtimer->events == event) {
+        _set_timer(&evtimer->timer, event->offset - now);
+    }
+    irq_restore(state);
+    if (sched_context_switch_request) {
+        thread_yield_higher();
+    }
+}
+
+void evtimer_del(evtimer_t *evtimer, evtimer_event_t *event)
+{
+    unsigned state = irq_disable();
+
+    DEBUG("evtimer_del(): removing event with offset %" PRIu32 "\n", event->offset);
+
+    if (evtimer->events == event) {
+        _pop(evtimer);
+        _update_timer(evtimer);
+    }
+    else if (event->prev) {
+        /* none of the children expires before the parent of event, so they
+         * can take its place without touching the rest of the heap */
+        evtimer_event_t *sub = _merge_pairs(evtimer, event->child);
+
+        if (sub) {
+            sub->prev = event->prev;
+            sub->next = event->next;
+            if (event->next) {
+                event->next->prev = sub;
+            }
+        }
+        else {
+            sub = event->next;
+            if (sub) {
+                sub->prev = event->prev;
+            }
+        }
+        if (event->prev->child == event) {
+            event->prev->child = sub;
+        }
+        else {
+            event->prev->next = sub;
+        }
+        event->next = event->prev = event->child = NULL;
+    }
+    /* else: event is not pending */
+    irq_restore(state);
+}
+
+static void _evtimer_handler(void *arg)
+{
+    DEBUG("_evtimer_handler()\n");
+
+    evtimer_t *evtimer = (evtimer_t *)arg;
+    uint32_t base, limit;
+
+    _update_base(evtimer);
+    /* everything due until now is fired in one go, and the first event in any
+     * case as the timer may fire a bit early due to rounding */
+    limit = _now_ms() - evtimer->base;
+    base = evtimer->base;
+    if (evtimer->events && ((evtimer->events->offset - base) > limit)) {
+        limit = evtimer->events->offset - base;
+    }
+    while (evtimer->events) {
+        /* callbacks adding events move the base forward */
+        uint32_t moved = evtimer->base - base;
+
+        if (moved > limit) {
+            break;
+        }
+        limit -= moved;
+        base = evtimer->base;
+        if ((evtimer->events->offset - base) > limit) {
+            break;
+        }
+        evtimer->callback(_pop(evtimer));
+    }
+
+    _update_timer(evtimer);
+}
+
+evtimer_event_t *evtimer_next(const evtimer_t *evtimer, evtimer_event_t *event,
+                              uint32_t *offset)
+{
+    if (!event) {
+        event = evtimer->events;
+    }
+    else if (event->child) {
+        event = event->child;
+    }
+    else {
+        /* climb up until there is a right sibling */
+        while (!event->next) {
+            if (!event->prev) {
+                return NULL;
+            }
+            while (event->prev->child != event) {
+                event = event->prev;
+            }
+            event = event->prev;
+        }
+        event = event->next;
+    }
+    if (event) {
+        *offset = event->offset - evtimer->base;
+    }
+    return event;
+}
+#else
 /* XXX this function is intentionally non-static, since the optimizer can't
  * handle the pointer hack in this function */
 void evtimer_add_event_to_list(evtimer_t *evtimer, evtimer_event_t *event)
@@ -92,16 +347,6 @@ static void _del_event_from_list(evtimer_t *evtimer, evtimer_event_t *event)
     }
 }
 
-static void _set_timer(xtimer_t *timer, uint32_t offset_ms)
-{
-    uint64_t offset_us = (uint64_t)offset_ms * US_PER_MS;
-
-    DEBUG("evtimer: now=%" PRIu32 " us setting xtimer to %" PRIu32 ":%" PRIu32 " us\n",
-          xtimer_now_usec(), (uint32_t)(offset_us >> 32), (uint32_t)(offset_us));
-
-    xtimer_set64(timer, offset_us);
-}
-
 static void _update_timer(evtimer_t *evtimer)
 {
     if (evtimer->events) {
@@ -199,21 +444,36 @@ static void _evtimer_handler(void *arg)
     _update_timer(evtimer);
 }
 
+evtimer_event_t *evtimer_next(const evtimer_t *evtimer, evtimer_event_t *event,
+                              uint32_t *offset)
+{
+    evtimer_event_t *next = (event) ? event->next : evtimer->events;
+
+    if (next) {
+        /* the offsets add up along the list */
+        *offset = ((event) ? *offset : 0) + next->offset;
+    }
+    return next;
+}
+#endif /* MODULE_EVTIMER_HEAP */
+
 void evtimer_init(evtimer_t *evtimer, evtimer_callback_t handler)
 {
     evtimer->callback = handler;
     evtimer->timer.callback = _evtimer_handler;
     evtimer->timer.arg = (void *)evtimer;
     evtimer->events = NULL;
+#ifdef MODULE_EVTIMER_HEAP
+    evtimer->base = 0;
+#endif
 }
 
 void evtimer_print(const evtimer_t *evtimer)
 {
-    evtimer_event_t *list = evtimer->events;
+    evtimer_event_t *event = NULL;
+    uint32_t offset = 0;
 
-    while (list->next) {
-        evtimer_event_t *list_entry = list->next;
-        printf("ev offset=%u\n", (unsigned)list_entry->offset);
-        list = list->next;
+    while ((event = evtimer_next(evtimer, event, &offset))) {
+        printf("ev offset=%u\n", (unsigned)offset);
     }
 }
@@ -38,8 +38,6 @@ typedef uint16_t u16;
 typedef uint8_t u8;
 
 
-/* This controls loop-unrolling in aes_core.c */
-#undef FULL_UNROLL
 # define GETU32(pt) (((u32)(pt)[0] << 24) ^ ((u32)(pt)[1] << 16) ^ \
                              ((u32)(pt)[2] <<  8) ^ ((u32)(pt)[3]))
 # define PUTU32(ct, st) { (ct)[0] = (u8)((st) >> 24); \
@@ -123,6 +121,38 @@ int aes_encrypt(const cipher_context_t *context, const uint8_t *plain_block,
 int aes_decrypt(const cipher_context_t *context, const uint8_t *cipher_block,
                 uint8_t *plain_block);
 
+/**
+ * @brief   encrypts consecutive blocks, the key schedule is computed once
+ *          for all of them
+ *
+ * @param       context       the cipher_context_t-struct to use for this
+ *                            encryption
+ * @param       input         @p numof blocks of plaintext
+ * @param       output        @p numof blocks for the ciphertext, may be
+ *                            @p input
+ * @param       numof         number of blocks
+ *
+ * @return  1
+ */
+int aes_encrypt_blocks(const cipher_context_t *context, const uint8_t *input,
+                       uint8_t *output, size_t numof);
+
+/**
+ * @brief   decrypts consecutive blocks, the key schedule is computed once
+ *          for all of them
+ *
+ * @param       context       the cipher_context_t-struct to use for this
+ *                            decryption
+ * @param       input         @p numof blocks of ciphertext
+ * @param       output        @p numof blocks for the plaintext, may be
+ *                            @p input
+ * @param       numof         number of blocks
+ *
+ * @return  1
+ */
+int aes_decrypt_blocks(const cipher_context_t *context, const uint8_t *input,
+                       uint8_t *output, size_t numof);
+
 #ifdef __cplusplus
 }
 #endif
@@ -22,6 +22,7 @@
 #ifndef CRYPTO_CIPHERS_H
 #define CRYPTO_CIPHERS_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -36,6 +37,13 @@ extern "C" {
 // #define CRYPTO_THREEDES
 // #define CRYPTO_AES
 
+/**
+ * @brief Number of blocks the modes of operation pass to the cipher at once
+ */
+#ifndef CIPHER_BATCH_BLOCKS
+#define CIPHER_BATCH_BLOCKS 4
+#endif
+
 /** @brief the length of keys in bytes */
 #define CIPHERS_MAX_KEY_SIZE 20
 #define CIPHER_MAX_BLOCK_SIZE 16
@@ -96,6 +104,14 @@ typedef struct cipher_interface_st {
     /** the decrypt function */
     int (*decrypt)(const cipher_context_t* ctx, const uint8_t* cipher_block,
                    uint8_t* plain_block);
+
+    /** encrypts consecutive blocks, NULL if the cipher only has encrypt */
+    int (*encrypt_blocks)(const cipher_context_t* ctx, const uint8_t* input,
+                          uint8_t* output, size_t numof);
+
+    /** decrypts consecutive blocks, NULL if the cipher only has decrypt */
+    int (*decrypt_blocks)(const cipher_context_t* ctx, const uint8_t* input,
+                          uint8_t* output, size_t numof);
 } cipher_interface_t;
 
 
@@ -156,6 +172,42 @@ int cipher_encrypt(const cipher_t* cipher, const uint8_t* input, uint8_t* output
 int cipher_decrypt(const cipher_t* cipher, const uint8_t* input, uint8_t* output);
 
 
+/**
+ * @brief Encrypt consecutive blocks of data
+ *
+ * Ciphers that profit from processing several blocks at once (e.g. because
+ * of a key schedule computed per call, or bitslicing) implement this in one
+ * go, for all others cipher_encrypt() is called for each block.
+ *
+ * @param cipher     Already initialized cipher struct
+ * @param input      pointer to @p numof blocks of input data to encrypt
+ * @param output     pointer to allocated memory for @p numof encrypted
+ *                   blocks, may be @p input
+ * @param numof      number of blocks
+ *
+ * @return  1 on success, as cipher_encrypt()
+ */
+int cipher_encrypt_blocks(const cipher_t* cipher, const uint8_t* input,
+                          uint8_t* output, size_t numof);
+
+
+/**
+ * @brief Decrypt consecutive blocks of data
+ *
+ * @see cipher_encrypt_blocks()
+ *
+ * @param cipher     Already initialized cipher struct
+ * @param input      pointer to @p numof blocks of input data to decrypt
+ * @param output     pointer to allocated memory for @p numof decrypted
+ *                   blocks, may be @p input
+ * @param numof      number of blocks
+ *
+ * @return  1 on success, as cipher_decrypt()
+ */
+int cipher_decrypt_blocks(const cipher_t* cipher, const uint8_t* input,
+                          uint8_t* output, size_t numof);
+
+
 /**
  * @brief Get block size of cipher
  * *
@@ -31,6 +31,15 @@
  *   example.
  * - uses @ref sys_xtimer "xtimer" as backend
  *
+ * The pending events are kept in a delta-encoded list, so adding and removing
+ * an event is O(n) with n being the number of pending events. With the
+ * `evtimer_heap` module they are kept in a pairing heap instead: adding an
+ * event is O(1), removing one O(log n) amortized, and all events that are due
+ * are handled in one go. Each event grows by two pointers, and events that
+ * expire at the same millisecond are handled in unspecified order. Events
+ * have to be zero-initialized or added once before they are passed to
+ * evtimer_del(), and must not be cleared while they are pending.
+ *
  * @{
  *
  * @file
@@ -56,7 +65,13 @@ extern "C" {
  */
 typedef struct evtimer_event {
     struct evtimer_event *next; /**< the next event in the queue */
-    uint32_t offset;            /**< offset in milliseconds from previous event */
+#if defined(MODULE_EVTIMER_HEAP) || defined(DOXYGEN)
+    struct evtimer_event *child;    /**< first child in the event heap */
+    struct evtimer_event *prev;     /**< parent or left sibling in the event
+                                         heap */
+#endif
+    uint32_t offset;            /**< offset in milliseconds from previous event,
+                                     absolute expiry with evtimer_heap */
 } evtimer_event_t;
 
 /**
@@ -72,6 +87,10 @@ typedef struct {
     evtimer_callback_t callback;    /**< Handler function for this evtimer's
                                          event type */
     evtimer_event_t *events;        /**< Event queue */
+#if defined(MODULE_EVTIMER_HEAP) || defined(DOXYGEN)
+    uint32_t base;                  /**< Time in milliseconds the expiry of
+                                         events is compared relative to */
+#endif
 } evtimer_t;
 
 /**
@@ -98,6 +117,26 @@ void evtimer_add(evtimer_t *evtimer, evtimer_event_t *event);
  */
 void evtimer_del(evtimer_t *evtimer, evtimer_event_t *event);
 
+/**
+ * @brief   Iterates over the pending events of an event timer
+ *
+ * The events come in the order they expire, with `evtimer_heap` in no
+ * particular order. The event timer must not be changed during the iteration.
+ *
+ * @param[in] evtimer       An event timer
+ * @param[in] event         The event returned by the last call, NULL for
+ *                          the first event
+ * @param[in,out] offset    The offset returned by the last call. Set to the
+ *                          offset in milliseconds of the returned event,
+ *                          relative to the last time the event timer was
+ *                          updated
+ *
+ * @return  the next pending event
+ * @return  NULL, if there are no more events
+ */
+evtimer_event_t *evtimer_next(const evtimer_t *evtimer, evtimer_event_t *event,
+                              uint32_t *offset);
+
 /**
  * @brief   Print overview of current state of an event timer
  *
@@ -24,6 +24,7 @@
 #include "kernel_types.h"
 #include "universal_address.h"
 #include "mutex.h"
+#include "xtimer.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -92,6 +93,31 @@ typedef struct {
     size_t entry_pool_size;
 } fib_sr_meta_t;
 
+#if defined(MODULE_FIB_LPM) || defined(DOXYGEN)
+/**
+ * @brief Node of the longest-prefix-match index of a single hop FIB table
+ *
+ * The index is a path-compressed binary trie over the destination addresses.
+ * A node either holds an entry or branches into two sub-tries.
+ */
+typedef struct fib_lpm_node {
+    /** sub-tries for the next bit being 0 or 1, next free node if unused */
+    struct fib_lpm_node *child[2];
+    /** the entry stored at this node, NULL for pure branching nodes */
+    fib_entry_t *entry;
+    /** the first fib_lpm_node_t::len bits of the key */
+    uint8_t key[UNIVERSAL_ADDRESS_SIZE];
+    /** length of the key in bits */
+    uint16_t len;
+} fib_lpm_node_t;
+
+/**
+ * @brief Number of index nodes required for a FIB table holding @p entries
+ *        entries
+ */
+#define FIB_LPM_NODES_NUMOF(entries)    (2 * (entries))
+#endif
+
 /**
 * @brief FIB table type for single hop entries
 */
@@ -133,6 +159,31 @@ typedef struct {
     *   e.g. when the unreachable destination is covered by the prefix
     */
     universal_address_container_t* prefix_rp[FIB_MAX_REGISTERED_RP];
+    /** timer firing when the earliest lifetime of an entry expires */
+    xtimer_t sweep_timer;
+    /** the earliest expiring lifetime, 0 if none is scheduled */
+    uint64_t next_expiry;
+    /** set by fib_table_t::sweep_timer, expired entries are removed on the
+    *   next access to the table
+    */
+    volatile uint8_t sweep_pending;
+#if defined(MODULE_FIB_LPM) || defined(DOXYGEN)
+    /** node pool of the longest-prefix-match index.
+    *   Must provide FIB_LPM_NODES_NUMOF(fib_table_t::size) nodes,
+    *   NULL disables the index for this table
+    */
+    fib_lpm_node_t *lpm_nodes;
+    /** the number of nodes in fib_table_t::lpm_nodes */
+    size_t lpm_nodes_numof;
+    /** root of the longest-prefix-match index */
+    fib_lpm_node_t *lpm_root;
+    /** list of unused nodes in fib_table_t::lpm_nodes */
+    fib_lpm_node_t *lpm_free;
+    /** number of entries that could not be indexed.
+    *   Lookups fall back to a linear scan of the table while this is not 0
+    */
+    size_t lpm_unindexed;
+#endif
 } fib_table_t;
 
 #ifdef __cplusplus
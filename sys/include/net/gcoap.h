@@ -53,6 +53,11 @@
  * gcoap itself defines a resource for `/.well-known/core` discovery, which
  * lists all of the registered paths.
  *
+ * gcoap_register_listener() adds the resources to a hash index over their
+ * paths, so the cost of finding a resource does not grow with their number.
+ * A resource with the COAP_MATCH_SUBTREE flag also handles all paths below its
+ * own path.
+ *
  * ### Creating a response ###
  *
  * An application resource includes a callback function, a coap_handler_t. After
@@ -117,6 +122,21 @@
  * the request. gcoap also executes the callback when a response is not
  * received within GCOAP_RESPONSE_TIMEOUT.
  *
+ * Up to GCOAP_REQ_WAITING_MAX requests may await a response at the same time.
+ * Responses are matched to their request via a hash index over the token and
+ * the message ID, so this limit can be raised without slowing down gcoap.
+ * GCOAP_NSTART limits the number of requests awaiting a response from the same
+ * endpoint, as RFC 7252, sec. 4.7 asks for. Further requests to the endpoint
+ * are queued and sent when a response arrives or a request times out. A queued
+ * request needs a resend buffer (see GCOAP_RESEND_BUFS_MAX), even if it is
+ * non-confirmable.
+ *
+ * By default, a confirmable request is resent after COAP_ACK_TIMEOUT and the
+ * timeout doubles with each resend. With the `gcoap_cocoa` module, the
+ * retransmission timeout is estimated for each endpoint from the measured round
+ * trip times, following the CoCoA congestion control for CoAP
+ * (draft-ietf-core-cocoa).
+ *
  * Here is the expected sequence for handling a response in the callback.
  *
  * -# Test for a server response or timeout in the _req_state_ callback
@@ -188,7 +208,8 @@
  * for a response, so the gcoap thread does not block while waiting. The user is
  * notified via the same callback, whether the message is received or the wait
  * times out. We track the response with an entry in the
- * `_coap_state.open_reqs` array.
+ * `_coap_state.open_reqs` array, which is also hashed into the
+ * `_coap_state.reqs_by_token` and `_coap_state.reqs_by_mid` indexes.
  *
  * ## Implementation Status ##
  * gcoap includes server and client capability. Available features include:
@@ -274,6 +295,18 @@ extern "C" {
  */
 #define GCOAP_OBS_OPTIONS_BUF   (8)
 
+/**
+ * @brief   Size of the index mapping request paths to resources, must be a
+ *          power of 2
+ *
+ * Holds up to GCOAP_RESOURCE_INDEX_SIZE - 1 resources of all registered
+ * listeners, including `/.well-known/core`. If more resources are registered,
+ * gcoap searches all listeners linearly.
+ */
+#ifndef GCOAP_RESOURCE_INDEX_SIZE
+#define GCOAP_RESOURCE_INDEX_SIZE   (16)
+#endif
+
 /**
  * @brief   Maximum number of requests awaiting a response
  */
@@ -281,6 +314,35 @@ extern "C" {
 #define GCOAP_REQ_WAITING_MAX   (2)
 #endif
 
+/**
+ * @brief   Number of buckets of the indexes matching responses to requests,
+ *          must be a power of 2
+ */
+#ifndef GCOAP_REQ_INDEX_SIZE
+#define GCOAP_REQ_INDEX_SIZE    (4)
+#endif
+
+/**
+ * @brief   Maximum number of requests awaiting a response from the same
+ *          endpoint
+ *
+ * Set to 0 to disable the limit. RFC 7252 recommends COAP_NSTART.
+ */
+#ifndef GCOAP_NSTART
+#define GCOAP_NSTART            (0)
+#endif
+
+/**
+ * @brief   Maximum number of endpoints with open requests
+ *
+ * With the default, every open request can be sent to another endpoint. With
+ * `gcoap_cocoa`, endpoints without open requests keep their RTO estimate until
+ * their entry is needed for another endpoint.
+ */
+#ifndef GCOAP_PEERS_MAX
+#define GCOAP_PEERS_MAX         (GCOAP_REQ_WAITING_MAX)
+#endif
+
 /**
  * @brief   Maximum length in bytes for a token
  */
@@ -311,7 +373,9 @@ extern "C" {
 #define GCOAP_MEMO_WAIT         (1)     /**< Request sent; awaiting response */
 #define GCOAP_MEMO_RESP         (2)     /**< Got response */
 #define GCOAP_MEMO_TIMEOUT      (3)     /**< Timeout waiting for response */
-#define GCOAP_MEMO_ERR          (4)     /**< Error processing response packet */
+#define GCOAP_MEMO_ERR          (4)     /**< Error processing response packet,
+                                             or the request was rejected */
+#define GCOAP_MEMO_QUEUED       (5)     /**< Request waits for GCOAP_NSTART */
 /** @} */
 
 /**
@@ -425,6 +489,7 @@ extern "C" {
 
 /**
  * @brief   Count of PDU buffers available for resending confirmable messages
+ *          and for requests queued for GCOAP_NSTART
  */
 #ifndef GCOAP_RESEND_BUFS_MAX
 #define GCOAP_RESEND_BUFS_MAX      (1)
@@ -460,10 +525,11 @@ typedef struct {
 /**
  * @brief   Memo to handle a response for a request
  */
-typedef struct {
+typedef struct gcoap_request_memo {
     unsigned state;                     /**< State of this memo, a GCOAP_MEMO... */
     int send_limit;                     /**< Remaining resends, 0 if none;
-                                             GCOAP_SEND_LIMIT_NON if non-confirmable */
+                                             GCOAP_SEND_LIMIT_NON if non-confirmable
+                                             and the PDU is not buffered */
     union {
         uint8_t hdr_buf[GCOAP_HEADER_MAXLEN];
                                         /**< Copy of PDU header, if no resends */
@@ -474,8 +540,43 @@ typedef struct {
     gcoap_resp_handler_t resp_handler;  /**< Callback for the response */
     xtimer_t response_timer;            /**< Limits wait for response */
     msg_t timeout_msg;                  /**< For response timer */
+    struct gcoap_peer *peer;            /**< State of the remote endpoint */
+    struct gcoap_request_memo *next_token;  /**< Next memo in the same token
+                                                 bucket, or next unused memo */
+    struct gcoap_request_memo *next_mid;    /**< Next memo in the same message
+                                                 ID bucket */
+    struct gcoap_request_memo *next_queued; /**< Next request queued for the
+                                                 same endpoint */
+#if defined(MODULE_GCOAP_COCOA) || defined(DOXYGEN)
+    uint32_t sent;                      /**< Time of the first transmission,
+                                             0 if no RTT is measured [in usec] */
+    uint32_t timeout;                   /**< Current retransmission timeout
+                                             [in usec] */
+    uint8_t backoff;                    /**< Backoff factor of the timeout,
+                                             in halves */
+#endif
 } gcoap_request_memo_t;
 
+/**
+ * @brief   State of a remote endpoint of requests
+ */
+typedef struct gcoap_peer {
+    sock_udp_ep_t remote;               /**< Remote endpoint */
+    unsigned outstanding;               /**< Requests awaiting a response */
+    gcoap_request_memo_t *queue;        /**< Oldest request waiting for
+                                             GCOAP_NSTART */
+    gcoap_request_memo_t *queue_tail;   /**< Newest request waiting for
+                                             GCOAP_NSTART */
+#if defined(MODULE_GCOAP_COCOA) || defined(DOXYGEN)
+    uint32_t rto;                       /**< Overall RTO estimate [in usec] */
+    uint32_t updated;                   /**< Time of the last update of rto */
+    uint32_t srtt[2];                   /**< Smoothed RTT of the strong and the
+                                             weak estimator [in usec] */
+    uint32_t rttvar[2];                 /**< RTT variation of the strong and the
+                                             weak estimator [in usec] */
+#endif
+} gcoap_peer_t;
+
 /**
  * @brief   Memo for Observe registration and notifications
  */
@@ -566,7 +667,7 @@ static inline ssize_t gcoap_request(coap_pkt_t *pdu, uint8_t *buf, size_t len,
  * @param[in] remote        Destination for the packet
  * @param[in] resp_handler  Callback when response received, may be NULL
  *
- * @return  length of the packet
+ * @return  length of the packet, also if it is queued for GCOAP_NSTART
  * @return  0 if cannot send
  */
 size_t gcoap_req_send2(const uint8_t *buf, size_t len,
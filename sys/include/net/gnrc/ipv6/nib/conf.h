@@ -205,6 +205,32 @@ extern "C" {
 #ifndef GNRC_IPV6_NIB_CONF_MULTIHOP_DAD
 #define GNRC_IPV6_NIB_CONF_MULTIHOP_DAD (0)
 #endif
+
+/**
+ * @brief   Longest-prefix-match index for off-link entries
+ *
+ * Keeps forwarding table, prefix list and destination cache entries in a
+ * binary trie, so the route lookup for a packet does not depend on
+ * @ref GNRC_IPV6_NIB_OFFL_NUMOF anymore. Requires memory for
+ * 2 * @ref GNRC_IPV6_NIB_OFFL_NUMOF trie nodes.
+ */
+#ifndef GNRC_IPV6_NIB_CONF_OFFL_LPM
+#define GNRC_IPV6_NIB_CONF_OFFL_LPM     (0)
+#endif
+
+/**
+ * @brief   Hashed index and least-recently-used replacement for on-link
+ *          entries
+ *
+ * Looks up neighbor cache entries by hashing their address instead of
+ * scanning all @ref GNRC_IPV6_NIB_NUMOF entries, and replaces the least
+ * recently used garbage-collectible entry when the neighbor cache is full.
+ * Requires memory for @ref GNRC_IPV6_NIB_NC_HASH_BUCKETS bucket heads and
+ * four indexes per on-link entry.
+ */
+#ifndef GNRC_IPV6_NIB_CONF_NC_HASH
+#define GNRC_IPV6_NIB_CONF_NC_HASH      (0)
+#endif
 /** @} */
 
 /**
@@ -252,6 +278,17 @@ extern "C" {
 #define GNRC_IPV6_NIB_NUMOF                 (4)
 #endif
 
+#if GNRC_IPV6_NIB_CONF_NC_HASH || defined(DOXYGEN)
+/**
+ * @brief   Number of hash buckets for on-link entries
+ *
+ * @pre     Must be a power of 2
+ */
+#ifndef GNRC_IPV6_NIB_NC_HASH_BUCKETS
+#define GNRC_IPV6_NIB_NC_HASH_BUCKETS       (16U)
+#endif
+#endif
+
 /**
  * @brief   Number of off-link entries in NIB
  *
@@ -14,6 +14,25 @@
  * Network interfaces in the context of GNRC are threads for protocols that are
  * below the network layer.
  *
+ * With the `gnrc_netif_rx_batch` module, an interface reads up to
+ * @ref GNRC_NETIF_RX_BATCH_MAX frames per @ref NETDEV_EVENT_RX_COMPLETE, as
+ * long as the device reports further frames via @ref NETOPT_RX_PENDING, and
+ * dispatches them afterwards. An interrupt that occurs while the interface
+ * thread has not yet handled the previous one is not queued again, so bursts
+ * neither overflow the message queue of the thread nor cost a message per
+ * frame.
+ *
+ * With the `gnrc_netif_txq` module, packets to send are put into a queue of
+ * @ref GNRC_NETIF_TXQ_SIZE packets, ordered by priority class (see
+ * @ref GNRC_NETIF_TXQ_PRIO_CONTROL). The interface sends the head of the queue
+ * whenever it has no other message to handle, so control messages overtake
+ * bulk data that is still waiting. If the device reports `-EBUSY`, the packet
+ * stays in the queue and sending is retried after @ref GNRC_NETIF_TXQ_RETRY.
+ * If the queue is full, the packet of the lowest priority class is dropped
+ * and `ENOBUFS` is reported to its @ref net_gnrc_neterr "subscribers", so
+ * upper layers can back off. With `netstats_l2`, the depth of the queue and
+ * the drops are counted in the @ref netstats_t of the device.
+ *
  * @{
  *
  * @file
@@ -46,6 +65,10 @@
 #endif
 #include "net/netdev.h"
 #include "rmutex.h"
+#ifdef MODULE_GNRC_NETIF_TXQ
+#include "net/gnrc/priority_pktqueue.h"
+#include "xtimer.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -56,6 +79,17 @@ extern "C" {
  */
 typedef struct gnrc_netif_ops gnrc_netif_ops_t;
 
+/**
+ * @brief   Priority classes of the transmit queue, lower classes are sent
+ *          first
+ *
+ * @note    Only used with the `gnrc_netif_txq` module
+ */
+enum {
+    GNRC_NETIF_TXQ_PRIO_CONTROL = 0,    /**< ICMPv6, e.g. neighbor discovery and RPL */
+    GNRC_NETIF_TXQ_PRIO_DATA,           /**< all other packets */
+};
+
 /**
  * @brief   Representation of a network interface
  */
@@ -97,6 +131,42 @@ typedef struct {
     uint8_t cur_hl;                         /**< Current hop-limit for out-going packets */
     uint8_t device_type;                    /**< Device type */
     kernel_pid_t pid;                       /**< PID of the network interface's thread */
+#if defined(MODULE_GNRC_NETIF_RX_BATCH) || DOXYGEN
+    /**
+     * @brief   A @ref NETDEV_MSG_TYPE_EVENT is queued for the thread
+     *
+     * @note    Only available with the `gnrc_netif_rx_batch` module
+     */
+    volatile uint8_t isr_pending;
+#endif
+#if defined(MODULE_GNRC_NETIF_TXQ) || DOXYGEN
+    /**
+     * @brief   Packets waiting for the device
+     *
+     * @note    Only available with the `gnrc_netif_txq` module
+     */
+    gnrc_priority_pktqueue_t txq;
+    /**
+     * @brief   Nodes of gnrc_netif_t::txq, a node is unused if it holds no
+     *          packet
+     *
+     * @note    Only available with the `gnrc_netif_txq` module
+     */
+    gnrc_priority_pktqueue_node_t txq_nodes[GNRC_NETIF_TXQ_SIZE];
+    /**
+     * @brief   Number of packets in gnrc_netif_t::txq
+     *
+     * @note    Only available with the `gnrc_netif_txq` module
+     */
+    uint16_t txq_len;
+    /**
+     * @brief   Retries sending when the device was busy
+     *
+     * @note    Only available with the `gnrc_netif_txq` module
+     */
+    xtimer_t txq_timer;
+    msg_t txq_msg;                          /**< message of gnrc_netif_t::txq_timer */
+#endif
 } gnrc_netif_t;
 
 /**
@@ -124,6 +124,34 @@ extern "C" {
 #define GNRC_NETIF_DEFAULT_HL      (64U)   /**< default hop limit */
 #endif
 
+/**
+ * @brief   Maximum number of frames received per @ref NETDEV_EVENT_RX_COMPLETE
+ *
+ * @note    Only used with the `gnrc_netif_rx_batch` module
+ */
+#ifndef GNRC_NETIF_RX_BATCH_MAX
+#define GNRC_NETIF_RX_BATCH_MAX    (8U)
+#endif
+
+/**
+ * @brief   Maximum number of packets waiting for the device
+ *
+ * @note    Only used with the `gnrc_netif_txq` module
+ */
+#ifndef GNRC_NETIF_TXQ_SIZE
+#define GNRC_NETIF_TXQ_SIZE        (8U)
+#endif
+
+/**
+ * @brief   Time in microseconds after which sending is retried if the device
+ *          was busy
+ *
+ * @note    Only used with the `gnrc_netif_txq` module
+ */
+#ifndef GNRC_NETIF_TXQ_RETRY
+#define GNRC_NETIF_TXQ_RETRY       (1000U)
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -134,6 +134,20 @@ enum {
  * @brief   Network interface is configured in raw mode
  */
 #define GNRC_NETIF_FLAGS_RAWMODE                   (0x00010000U)
+
+/**
+ * @brief   The device calculates the upper layer checksums of outgoing packets
+ *
+ * @see     @ref NETOPT_TX_CSUM_OFFLOAD
+ */
+#define GNRC_NETIF_FLAGS_TX_CSUM_OFFLOAD           (0x00020000U)
+
+/**
+ * @brief   The device verifies the upper layer checksums of incoming packets
+ *
+ * @see     @ref NETOPT_RX_CSUM_OFFLOAD
+ */
+#define GNRC_NETIF_FLAGS_RX_CSUM_OFFLOAD           (0x00040000U)
 /** @} */
 
 #ifdef __cplusplus
@@ -22,6 +22,7 @@
 #define NET_GNRC_NETIF_HDR_H
 
 #include <string.h>
+#include <stdbool.h>
 #include <stdint.h>
 
 #include "net/gnrc/pkt.h"
@@ -85,6 +86,18 @@ extern "C" {
  *          @ref IEEE802154_FCF_FRAME_PEND
  */
 #define GNRC_NETIF_HDR_FLAGS_MORE_DATA  (0x10)
+
+/**
+ * @brief   The upper layer checksum of the packet is valid
+ *
+ * @details For received packets this flag signals that the network device
+ *          already verified the UDP, TCP or ICMPv6 checksum (see
+ *          @ref NETOPT_RX_CSUM_OFFLOAD). When sending, it tells the network
+ *          layer that the sender already set the checksum, e.g. by
+ *          updating it with inet_csum_update(), so it is not calculated
+ *          again.
+ */
+#define GNRC_NETIF_HDR_FLAGS_CSUM_VALID (0x08)
 /**
  * @}
  */
@@ -253,6 +266,24 @@ int gnrc_netif_hdr_get_dstaddr(gnrc_pktsnip_t* pkt, uint8_t** pointer_to_addr);
  */
 int gnrc_netif_hdr_get_srcaddr(gnrc_pktsnip_t* pkt, uint8_t** pointer_to_addr);
 
+/**
+ * @brief   Checks if the upper layer checksum of a packet is known to be valid
+ *
+ * @param[in] pkt   A packet, possibly containing a generic interface header.
+ *
+ * @return  true, if @p pkt contains a generic interface header with
+ *          @ref GNRC_NETIF_HDR_FLAGS_CSUM_VALID set.
+ * @return  false otherwise.
+ */
+static inline bool gnrc_netif_hdr_csum_valid(gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktsnip_t *netif = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_NETIF);
+
+    return (netif != NULL) &&
+           (((gnrc_netif_hdr_t *)netif->data)->flags &
+            GNRC_NETIF_HDR_FLAGS_CSUM_VALID);
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -36,6 +36,11 @@ extern "C" {
  */
 #define NETDEV_MSG_TYPE_EVENT   (0x1234)
 
+/**
+ * @brief   Message type to retry sending the transmit queue
+ */
+#define GNRC_NETIF_MSG_TYPE_TXQ (0x1235)
+
 /**
  * @brief   Acquires exclusive access to the interface
  *
@@ -72,6 +72,31 @@ typedef enum {
 } gnrc_netreg_type_t;
 #endif
 
+#if defined(MODULE_GNRC_NETREG_HASH) || defined(DOXYGEN)
+/**
+ * @brief   Number of hash buckets of the registry
+ *
+ * @note    Only used with the `gnrc_netreg_hash` module. Must be a power of 2.
+ *          Lookups stay constant-time as long as the number of registered
+ *          (type, demux context) pairs does not grossly exceed this value.
+ */
+#ifndef GNRC_NETREG_HASH_BUCKETS
+#define GNRC_NETREG_HASH_BUCKETS    (32U)
+#endif
+#endif
+
+/**
+ * @brief   Trailing initializer for gnrc_netreg_entry_t::nettype in the
+ *          static entry initialization macros
+ *
+ * @internal
+ */
+#ifdef MODULE_GNRC_NETREG_HASH
+#define GNRC_NETREG_ENTRY_INIT_NETTYPE  , GNRC_NETTYPE_UNDEF
+#else
+#define GNRC_NETREG_ENTRY_INIT_NETTYPE
+#endif
+
 /**
  * @brief   Demux context value to get all packets of a certain type.
  *
@@ -96,9 +121,11 @@ typedef enum {
 #if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS)
 #define GNRC_NETREG_ENTRY_INIT_PID(demux_ctx, pid)  { NULL, demux_ctx, \
                                                       GNRC_NETREG_TYPE_DEFAULT, \
-                                                      { pid } }
+                                                      { pid } \
+                                                      GNRC_NETREG_ENTRY_INIT_NETTYPE }
 #else
-#define GNRC_NETREG_ENTRY_INIT_PID(demux_ctx, pid)  { NULL, demux_ctx, { pid } }
+#define GNRC_NETREG_ENTRY_INIT_PID(demux_ctx, pid)  { NULL, demux_ctx, { pid } \
+                                                      GNRC_NETREG_ENTRY_INIT_NETTYPE }
 #endif
 
 #if defined(MODULE_GNRC_NETAPI_MBOX) || defined(DOXYGEN)
@@ -115,7 +142,8 @@ typedef enum {
  */
 #define GNRC_NETREG_ENTRY_INIT_MBOX(demux_ctx, mbox) { NULL, demux_ctx, \
                                                        GNRC_NETREG_TYPE_MBOX, \
-                                                       { .mbox = mbox } }
+                                                       { .mbox = mbox } \
+                                                       GNRC_NETREG_ENTRY_INIT_NETTYPE }
 #endif
 
 #if defined(MODULE_GNRC_NETAPI_CALLBACKS) || defined(DOXYGEN)
@@ -132,7 +160,8 @@ typedef enum {
  */
 #define GNRC_NETREG_ENTRY_INIT_CB(demux_ctx, cbd)   { NULL, demux_ctx, \
                                                       GNRC_NETREG_TYPE_CB, \
-                                                      { .cbd = cbd } }
+                                                      { .cbd = cbd } \
+                                                      GNRC_NETREG_ENTRY_INIT_NETTYPE }
 /** @} */
 
 /**
@@ -210,6 +239,16 @@ typedef struct gnrc_netreg_entry {
         gnrc_netreg_entry_cbd_t *cbd;
 #endif
     } target;                   /**< Target for the registry entry */
+#if defined(MODULE_GNRC_NETREG_HASH) || defined(DOXYGEN)
+    /**
+     * @brief   The protocol type the entry is registered for
+     *
+     * @note    Only available with the `gnrc_netreg_hash` module.
+     *
+     * @internal
+     */
+    gnrc_nettype_t nettype;
+#endif
 } gnrc_netreg_entry_t;
 
 /**
@@ -18,6 +18,13 @@
  *          this *will* lead to alignment problems and can potentially result
  *          in segmentation/hard faults and other unexpected behaviour.
  *
+ * The static implementation `gnrc_pktbuf_static` keeps the unused space of
+ * the buffer in a single first-fit list ordered by address. Allocation and
+ * release get slower the more fragmented the buffer gets. With the
+ * `gnrc_pktbuf_static_sizeclass` module it instead keeps one list per size
+ * class (header-sized, IEEE 802.15.4 frame-sized, MTU-sized, ...). Both
+ * operations then mostly take constant time, independent of fragmentation.
+ *
  * @{
  *
  * @file
@@ -281,7 +288,8 @@ gnrc_pktsnip_t *gnrc_pktbuf_duplicate_upto(gnrc_pktsnip_t *pkt, gnrc_nettype_t t
  *
  * @note    Only available with DEVELHELP defined.
  *
- * @details Statistics include maximum number of reserved bytes.
+ * @details Statistics include maximum number of reserved bytes and the
+ *          fragmentation of the unused space.
  */
 void gnrc_pktbuf_stats(void);
 #endif
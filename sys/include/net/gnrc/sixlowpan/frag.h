@@ -14,6 +14,17 @@
  * @see <a href="https://tools.ietf.org/html/rfc4944#section-5.3">
  *          RFC 4944, section 5.3
  *      </a>
+ *
+ * With the `gnrc_sixlowpan_frag_minfwd` module a router forwards fragmented
+ * datagrams fragment by fragment instead of reassembling them first. The
+ * first fragment is reassembled as usual until its IPv6 header is known. If
+ * the datagram is to be forwarded over a 6LoWPAN interface, the router
+ * remembers the next hop and a new datagram tag for it, sends the fragments
+ * received so far on and relays all further fragments of the datagram right
+ * away. The first fragment is sent with an uncompressed IPv6 header.
+ * @see <a href="https://tools.ietf.org/html/draft-ietf-lwig-6lowpan-virtual-reassembly">
+ *          draft-ietf-lwig-6lowpan-virtual-reassembly
+ *      </a>
  * @{
  *
  * @file
@@ -33,7 +44,9 @@
 #include "net/gnrc/pkt.h"
 #include "net/gnrc/netif/hdr.h"
 #include "net/ieee802154.h"
+#include "net/ipv6.h"
 #include "net/sixlowpan.h"
+#include "xtimer.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -54,6 +67,77 @@ extern "C" {
 #define GNRC_SIXLOWPAN_MSG_FRAG_GC_RBUF     (0x0226)
 /** @} */
 
+/**
+ * @brief   Number of datagrams that can be fragmented at the same time
+ *
+ * The fragments of these datagrams are sent interleaved, one fragment per
+ * datagram in turn.
+ */
+#ifndef GNRC_SIXLOWPAN_MSG_FRAG_SIZE
+#define GNRC_SIXLOWPAN_MSG_FRAG_SIZE        (4U)
+#endif
+
+/**
+ * @brief   Minimum time in microseconds between two fragments of the same
+ *          datagram
+ *
+ * 0 sends the next fragment as soon as the 6LoWPAN thread handled the
+ * messages that were queued in the meantime. Other values give the receiver
+ * (or a forwarding node) time to handle a fragment before the next one of the
+ * same datagram arrives.
+ *
+ * If the 6LoWPAN message queue (see @ref GNRC_SIXLOWPAN_MSG_QUEUE_SIZE) is
+ * full when the interval is over, the next fragment is delayed by another
+ * interval.
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_PACING
+#define GNRC_SIXLOWPAN_FRAG_PACING          (0U)
+#endif
+
+/**
+ * @brief   Number of datagrams that can be reassembled at the same time
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_RBUF_SIZE
+#define GNRC_SIXLOWPAN_FRAG_RBUF_SIZE       (4U)
+#endif
+
+/**
+ * @brief   Maximum number of bytes in the packet buffer that are occupied by
+ *          incomplete datagrams
+ *
+ * The oldest incomplete datagrams are dropped to make room for a new one.
+ * Datagrams larger than this are dropped right away. When the packet buffer
+ * itself is full, a new datagram replaces at most its own size of incomplete
+ * datagrams, or is dropped if they don't add up to that.
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_RBUF_MEM
+#define GNRC_SIXLOWPAN_FRAG_RBUF_MEM        (GNRC_SIXLOWPAN_FRAG_RBUF_SIZE * IPV6_MIN_MTU)
+#endif
+
+/**
+ * @brief   Number of incomplete datagrams of a single source that are not
+ *          replaced by new datagrams of the same source
+ *
+ * When the reassembly buffer is full, a new datagram from a source that
+ * already has this many datagrams in reassembly replaces the oldest of them
+ * instead of the oldest datagram of any source. This way a single neighbor
+ * can not push the datagrams of all others out of the buffer.
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_RBUF_PER_SRC
+#define GNRC_SIXLOWPAN_FRAG_RBUF_PER_SRC    ((GNRC_SIXLOWPAN_FRAG_RBUF_SIZE + 1U) / 2U)
+#endif
+
+/**
+ * @brief   Number of datagrams that can be forwarded fragment by fragment at
+ *          the same time
+ *
+ * @note    Only applicable with the `gnrc_sixlowpan_frag_minfwd` module.
+ *          Datagrams exceeding this are reassembled.
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_MINFWD_SIZE
+#define GNRC_SIXLOWPAN_FRAG_MINFWD_SIZE     (8U)
+#endif
+
 /**
  * @brief   An entry in the 6LoWPAN reassembly buffer.
  *
@@ -93,16 +177,34 @@ typedef struct {
     uint16_t offset;        /**< Offset of the Nth fragment from the beginning of the
                              *   payload datagram */
     kernel_pid_t pid;       /**< PID of the interface */
+    uint16_t tag;           /**< Datagram tag, assigned with the first fragment */
+#if GNRC_SIXLOWPAN_FRAG_PACING || defined(DOXYGEN)
+    xtimer_t timer;         /**< Timer delaying the next fragment */
+    /**
+     * @brief   PID of the 6LoWPAN thread the next fragment is triggered in
+     */
+    kernel_pid_t sixlowpan_pid;
+#endif
 } gnrc_sixlowpan_msg_frag_t;
 
 /**
  * @brief   Allocates a @ref gnrc_sixlowpan_msg_frag_t object
  *
+ * The object is in use as long as gnrc_sixlowpan_msg_frag_t::pkt is not NULL.
+ * Up to @ref GNRC_SIXLOWPAN_MSG_FRAG_SIZE objects are in use at the same time.
+ *
  * @return  A @ref gnrc_sixlowpan_msg_frag_t if available
  * @return  NULL, otherwise
  */
 gnrc_sixlowpan_msg_frag_t *gnrc_sixlowpan_msg_frag_get(void);
 
+/**
+ * @brief   Generates a new datagram tag for sending fragments
+ *
+ * @return  A new datagram tag
+ */
+uint16_t gnrc_sixlowpan_frag_next_tag(void);
+
 /**
  * @brief   Sends a packet fragmented
  *
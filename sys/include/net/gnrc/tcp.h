@@ -109,7 +109,7 @@ int gnrc_tcp_open_active(gnrc_tcp_tcb_t *tcb,  uint8_t address_family,
  *                    or @p target_addr is invalid.
  *            -EISCONN if TCB is already in use.
  *            -ENOMEM if the receive buffer for the TCB could not be allocated.
- *            Hint: Increase "GNRC_TCP_RCV_BUFFERS".
+ *            Hint: Increase "GNRC_TCP_RCV_BUF_CHUNKS".
  */
 int gnrc_tcp_open_passive(gnrc_tcp_tcb_t *tcb, uint8_t address_family,
                           const char *local_addr, uint16_t local_port);
@@ -121,7 +121,9 @@ int gnrc_tcp_open_passive(gnrc_tcp_tcb_t *tcb, uint8_t address_family,
  * @pre @p tcb must not be NULL.
  * @pre @p data must not be NULL.
  *
- * @note Blocks until up to @p len bytes were transmitted or an error occured.
+ * @note Blocks until up to @p len bytes were transmitted and acknowledged or an error
+ *       occured. Up to @ref GNRC_TCP_RETRANSMIT_QUEUE_SIZE segments are in flight at
+ *       the same time, limited by the peers receive window and the congestion window.
  *
  * @param[in,out] tcb                        TCB holding the connection information.
  * @param[in]     data                       Pointer to the data that should be transmitted.
@@ -129,12 +131,15 @@ int gnrc_tcp_open_passive(gnrc_tcp_tcb_t *tcb, uint8_t address_family,
  * @param[in]     user_timeout_duration_us   If not zero and there was not data transmitted
  *                                           the function returns after user_timeout_duration_us.
  *                                           If zero, no timeout will be triggered.
+ *                                           Segments that are not acknowledged when it
+ *                                           expires are discarded and must be sent again.
  *
- * @returns   The number of successfully transmitted bytes.
+ * @returns   The number of successfully transmitted and acknowledged bytes.
  *            -ENOTCONN if connection is not established.
  *            -ECONNRESET if connection was resetted by the peer.
  *            -ECONNABORTED if the connection was aborted.
- *            -ETIMEDOUT if @p user_timeout_duration_us expired.
+ *            -ETIMEDOUT if @p user_timeout_duration_us expired before any byte
+ *            was acknowledged.
  */
 ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
                       const uint32_t user_timeout_duration_us);
@@ -169,6 +174,44 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
 ssize_t gnrc_tcp_recv(gnrc_tcp_tcb_t *tcb, void *data, const size_t max_len,
                       const uint32_t user_timeout_duration_us);
 
+/**
+ * @brief Receive data from the peer without copying it.
+ *
+ * After the first call, received segments are no longer copied into the receive
+ * buffer but kept in the packet buffer, up to @ref GNRC_TCP_RCV_PKT_QUEUE_SIZE
+ * segments per connection. Each call hands the oldest segment to the caller.
+ * Data received before the first call is copied into a new packet once.
+ * gnrc_tcp_recv() can still be used on the same connection.
+ *
+ * @pre gnrc_tcp_tcb_init() must have been successfully called.
+ * @pre @p tcb must not be NULL.
+ * @pre @p pkt must not be NULL.
+ *
+ * @note Function blocks if user_timeout_duration_us is not zero.
+ *
+ * @param[in,out] tcb                        TCB holding the connection information.
+ * @param[out]    pkt                        The received packet. It starts with the payload
+ *                                           snips (type GNRC_NETTYPE_UNDEF), the headers
+ *                                           of the segment may follow. Must be released
+ *                                           with gnrc_pktbuf_release() after consumption.
+ *                                           NULL if no data was received.
+ * @param[in]     user_timeout_duration_us   Timeout for receive in microseconds.
+ *                                           If zero and no data is available, the function
+ *                                           returns immediately. If not zero the function
+ *                                           blocks until data is available or
+ *                                           @p user_timeout_duration_us microseconds passed.
+ *
+ * @returns   The number of payload bytes in @p pkt.
+ *            -ENOTCONN if connection is not established.
+ *            -EAGAIN if  user_timeout_duration_us is zero and no data is available.
+ *            -ECONNRESET if connection was resetted by the peer.
+ *            -ECONNABORTED if the connection was aborted.
+ *            -ETIMEDOUT if @p user_timeout_duration_us expired.
+ *            -ENOMEM if buffered data could not be copied into a packet.
+ */
+ssize_t gnrc_tcp_recv_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **pkt,
+                          const uint32_t user_timeout_duration_us);
+
 /**
  * @brief Close a TCP connection.
  *
@@ -68,19 +68,74 @@ extern "C" {
 #endif
 
 /**
- * @brief Number of preallocated receive buffers
+ * @brief Maximum number of unacknowledged segments in flight per connection
+ *
+ * Every segment is kept in the packet buffer until it is acknowledged.
+ */
+#ifndef GNRC_TCP_RETRANSMIT_QUEUE_SIZE
+#define GNRC_TCP_RETRANSMIT_QUEUE_SIZE (GNRC_TCP_MSS_MULTIPLICATOR)
+#endif
+
+/**
+ * @brief Number of connections that can fill a receive buffer of
+ *        GNRC_TCP_RCV_BUF_SIZE bytes at the same time
  */
 #ifndef GNRC_TCP_RCV_BUFFERS
 #define GNRC_TCP_RCV_BUFFERS (1U)
 #endif
 
 /**
- * @brief Default receive buffer size
+ * @brief Maximum receive buffer size of a connection
  */
 #ifndef GNRC_TCP_RCV_BUF_SIZE
 #define GNRC_TCP_RCV_BUF_SIZE (GNRC_TCP_DEFAULT_WINDOW)
 #endif
 
+/**
+ * @brief Size of the chunks receive buffers are built from
+ *
+ * Connections take chunks from a shared pool as data arrives and return them
+ * as soon as the data was read. An open connection holds at least one chunk.
+ */
+#ifndef GNRC_TCP_RCV_BUF_CHUNK_SIZE
+#define GNRC_TCP_RCV_BUF_CHUNK_SIZE (256U)
+#endif
+
+/**
+ * @brief Number of chunks in the receive buffer pool
+ */
+#ifndef GNRC_TCP_RCV_BUF_CHUNKS
+#define GNRC_TCP_RCV_BUF_CHUNKS ((GNRC_TCP_RCV_BUFFERS * GNRC_TCP_RCV_BUF_SIZE + \
+                                  GNRC_TCP_RCV_BUF_CHUNK_SIZE - 1) / GNRC_TCP_RCV_BUF_CHUNK_SIZE)
+#endif
+
+/**
+ * @brief Maximum number of received segments held per connection for
+ *        gnrc_tcp_recv_pkt()
+ *
+ * The segments stay in the packet buffer until the application releases them.
+ */
+#ifndef GNRC_TCP_RCV_PKT_QUEUE_SIZE
+#define GNRC_TCP_RCV_PKT_QUEUE_SIZE (GNRC_TCP_MSS_MULTIPLICATOR)
+#endif
+
+/**
+ * @brief Number of hash buckets for connections, must be a power of 2
+ *
+ * Incoming segments are mapped to their connection by a hash over the local
+ * port, the peer port and the peer address.
+ */
+#ifndef GNRC_TCP_TCB_HASH_BUCKETS
+#define GNRC_TCP_TCB_HASH_BUCKETS (8U)
+#endif
+
+/**
+ * @brief Number of hash buckets for listening connections, must be a power of 2
+ */
+#ifndef GNRC_TCP_LISTEN_HASH_BUCKETS
+#define GNRC_TCP_LISTEN_HASH_BUCKETS (4U)
+#endif
+
 /**
  * @brief Lower bound for RTO = 1 sec (see RFC 6298)
  */
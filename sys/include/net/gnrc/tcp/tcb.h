@@ -22,9 +22,9 @@
 #ifndef NET_GNRC_TCP_TCB_H
 #define NET_GNRC_TCP_TCB_H
 
+#include <stddef.h>
 #include <stdint.h>
 #include "kernel_types.h"
-#include "ringbuffer.h"
 #include "xtimer.h"
 #include "mutex.h"
 #include "msg.h"
@@ -69,21 +69,37 @@ typedef struct _transmission_control_block {
     uint32_t iss;          /**< Initial sequence sumber */
     uint32_t irs;          /**< Initial received sequence number */
     uint16_t mss;          /**< The peers MSS */
+    uint32_t snd_cwnd;     /**< Congestion window */
+    uint32_t snd_ssthresh; /**< Slow start threshold */
+    uint32_t snd_recover;  /**< Send next at the start of the last loss recovery */
+    uint8_t dup_acks;      /**< Number of consecutive duplicate ACKs */
     uint32_t rtt_start;    /**< Timer value for rtt estimation */
+    uint32_t rtt_seq;      /**< AckNo. completing the running rtt estimation */
     int32_t rtt_var;       /**< Round trip time variance */
     int32_t srtt;          /**< Smoothed round trip time */
     int32_t rto;           /**< Retransmission timeout duration */
     uint8_t retries;       /**< Number of retransmissions */
     xtimer_t tim_tout;     /**< Timer struct for timeouts */
     msg_t msg_tout;        /**< Message, sent on timeouts */
-    gnrc_pktsnip_t *pkt_retransmit;   /**< Pointer to packet in "retransmit queue" */
+    gnrc_pktsnip_t *pkt_retransmit[GNRC_TCP_RETRANSMIT_QUEUE_SIZE]; /**< Retransmit queue */
+    uint8_t pkt_retransmit_cnt;       /**< Number of packets in retransmit queue */
     msg_t mbox_raw[GNRC_TCP_TCB_MBOX_SIZE];   /**< Msg queue for mbox */
     mbox_t mbox;             /**< TCB mbox for synchronization */
-    uint8_t *rcv_buf_raw;    /**< Pointer to the receive buffer */
-    ringbuffer_t rcv_buf;    /**< Receive buffer data structure */
+    struct rcvbuf_chunk *rcv_head;  /**< Receive buffer chunk holding the oldest data */
+    struct rcvbuf_chunk *rcv_tail;  /**< Receive buffer chunk new data is written to */
+    uint16_t rcv_read;       /**< Read offset into rcv_head */
+    uint16_t rcv_write;      /**< Write offset into rcv_tail */
+    size_t rcv_len;          /**< Number of bytes in the receive buffer */
+    uint16_t rcv_reserved;   /**< Number of pool chunks reserved for the window */
+    gnrc_pktsnip_t *rcv_pkt[GNRC_TCP_RCV_PKT_QUEUE_SIZE]; /**< Received segments queue */
+    uint8_t rcv_pkt_cnt;     /**< Number of segments in rcv_pkt */
+    uint16_t rcv_pkt_offset; /**< Bytes already read from the payload of rcv_pkt[0] */
+    size_t rcv_pkt_len;      /**< Number of unread payload bytes in rcv_pkt */
     mutex_t fsm_lock;        /**< Mutex for FSM access synchronization */
     mutex_t function_lock;   /**< Mutex for function call synchronization */
     struct _transmission_control_block *next;   /**< Pointer next TCB */
+    struct _transmission_control_block **bucket;      /**< Hash bucket holding the TCB */
+    struct _transmission_control_block *bucket_next;  /**< Pointer next TCB in bucket */
 } gnrc_tcp_tcb_t;
 
 #ifdef __cplusplus
@@ -73,6 +73,59 @@ static inline uint16_t inet_csum(uint16_t sum, const uint8_t *buf, uint16_t len)
     return inet_csum_slice(sum, buf, len, 0);
 }
 
+/**
+ * @brief   Updates an Internet Checksum after a 16-bit word of its domain was
+ *          changed.
+ *
+ * @see <a href="https://tools.ietf.org/html/rfc1624#section-3">
+ *          RFC 1624, section 3 (eqn. 3)
+ *      </a>
+ *
+ * @details Unlike the other functions here, @p csum and the result are
+ *          normalized, i.e. as found in the header. Protocols that transmit a
+ *          calculated checksum of 0 as 0xffff (like UDP) have to replace a
+ *          result of 0 themselves.
+ *
+ * @param[in] csum      The checksum field before the change.
+ * @param[in] old_val   The old value of the changed word.
+ * @param[in] new_val   The new value of the changed word.
+ *
+ * @return  The checksum field after the change.
+ */
+static inline uint16_t inet_csum_update(uint16_t csum, uint16_t old_val,
+                                        uint16_t new_val)
+{
+    uint32_t sum = (uint16_t)~csum + (uint16_t)~old_val + new_val;
+
+    sum = (sum & 0xffff) + (sum >> 16);
+    sum = (sum & 0xffff) + (sum >> 16);
+    return (uint16_t)~sum;
+}
+
+/**
+ * @brief   Updates an Internet Checksum after a range of its domain was
+ *          changed.
+ *
+ * @see inet_csum_update()
+ *
+ * @param[in] csum      The checksum field before the change.
+ * @param[in] old_buf   The old content of the changed range.
+ * @param[in] new_buf   The new content of the changed range.
+ * @param[in] len       Length of the changed range in byte. Must be even and
+ *                      the range must start at an even offset into the
+ *                      checksum domain.
+ *
+ * @return  The checksum field after the change.
+ */
+static inline uint16_t inet_csum_update_slice(uint16_t csum,
+                                              const uint8_t *old_buf,
+                                              const uint8_t *new_buf,
+                                              uint16_t len)
+{
+    return inet_csum_update(csum, inet_csum(0, old_buf, len),
+                            inet_csum(0, new_buf, len));
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -26,6 +26,20 @@
  * capital precede lower case). nanocoap provides the
  * COAP_WELL_KNOWN_CORE_DEFAULT_HANDLER entry for `/.well-known/core`.
  *
+ * Requests are mapped to their resource by a hash index over the resource
+ * paths, built on the first request. A resource with the COAP_MATCH_SUBTREE
+ * flag also handles all paths below its own, e.g. `/fw` handles `/fw/1/data`.
+ * The resource with the longest matching path wins.
+ *
+ * ### Option index ###
+ *
+ * coap_parse() records the position of the first occurrence of every option.
+ * With the `nanocoap_optindex` module, it also records the position and the
+ * length of its value and the position of its last occurrence, so the
+ * coap_opt_get_xxx() functions read an option without decoding its header
+ * again. Options with a number below 64 are found without a search. This
+ * costs 6 bytes per entry of the options array and 8 bytes per packet.
+ *
  * ### Handler functions ###
  *
  * For each resource, you must implement a ::coap_handler_t handler function.
@@ -170,6 +184,8 @@ extern "C" {
 #define COAP_POST               (0x2)
 #define COAP_PUT                (0x4)
 #define COAP_DELETE             (0x8)
+#define COAP_MATCH_SUBTREE      (0x8000) /**< Path is also a prefix for all
+                                              *  paths below it */
 /** @} */
 
 /**
@@ -187,6 +203,16 @@ extern "C" {
                                             *  transfer as power of 2 */
 /** @} */
 
+/**
+ * @brief   Size of the resource index of coap_handle_req(), must be a power of 2
+ *
+ * The index holds up to NANOCOAP_RESOURCE_INDEX_SIZE - 1 resources. If
+ * `coap_resources` has more entries, coap_handle_req() searches linearly.
+ */
+#ifndef NANOCOAP_RESOURCE_INDEX_SIZE
+#define NANOCOAP_RESOURCE_INDEX_SIZE    (16)
+#endif
+
 #ifdef MODULE_GCOAP
 #define NANOCOAP_URL_MAX        NANOCOAP_URI_MAX
 #define NANOCOAP_QS_MAX         (64)
@@ -220,6 +246,11 @@ typedef struct __attribute__((packed)) {
 typedef struct {
     uint16_t opt_num;           /**< full CoAP option number    */
     uint16_t offset;            /**< offset in packet           */
+#if defined(MODULE_NANOCOAP_OPTINDEX) || defined(DOXYGEN)
+    uint16_t last;              /**< offset of last occurrence  */
+    uint16_t value;             /**< offset of value in packet  */
+    uint16_t len;               /**< length of value            */
+#endif
 } coap_optpos_t;
 
 /**
@@ -232,6 +263,10 @@ typedef struct {
     uint16_t payload_len;                       /**< length of payload       */
     uint16_t options_len;                       /**< length of options array */
     coap_optpos_t options[NANOCOAP_NOPTS_MAX];  /**< option offset array     */
+#if defined(MODULE_NANOCOAP_OPTINDEX) || defined(DOXYGEN)
+    uint32_t options_map[2];                    /**< options below 64 in
+                                                 *   options array       */
+#endif
 #ifdef MODULE_GCOAP
     uint8_t url[NANOCOAP_URI_MAX];              /**< parsed request URL      */
     uint8_t qs[NANOCOAP_QS_MAX];                /**< parsed query string     */
@@ -255,6 +290,24 @@ typedef struct {
     void *context;                  /**< ptr to user defined context data   */
 } coap_resource_t;
 
+/**
+ * @brief   Entry of a resource index
+ */
+typedef struct {
+    const coap_resource_t *resource;    /**< indexed resource, NULL if unused */
+    uint32_t hash;                      /**< hash of the resource path        */
+} coap_resource_index_entry_t;
+
+/**
+ * @brief   Hash index mapping request paths to resources
+ */
+typedef struct {
+    coap_resource_index_entry_t *entries;   /**< hash table, open addressing */
+    unsigned size;                          /**< number of entries, power of 2 */
+    unsigned numof;                         /**< number of used entries */
+    bool overflow;                          /**< a resource did not fit */
+} coap_resource_index_t;
+
 /**
  * @brief   Block1 helper struct
  */
@@ -659,6 +712,32 @@ size_t coap_opt_put_block2(uint8_t *buf, uint16_t lastonum, coap_block_slicer_t
  */
 unsigned coap_get_content_type(coap_pkt_t *pkt);
 
+/**
+ * @brief   Get the value of the first occurrence of an option
+ *
+ * @param[in]   pkt         packet to read from
+ * @param[in]   optnum      absolute option number
+ * @param[out]  value       start of the option value
+ *
+ * @return      length of the option value
+ * @return      -ENOENT if @p pkt does not contain the option
+ */
+ssize_t coap_opt_get_opaque(const coap_pkt_t *pkt, uint16_t optnum,
+                            uint8_t **value);
+
+/**
+ * @brief   Get the value of an option as unsigned integer
+ *
+ * @param[in]   pkt         packet to read from
+ * @param[in]   optnum      absolute option number
+ * @param[out]  value       value of the option
+ *
+ * @return      0 on success
+ * @return      -ENOENT if @p pkt does not contain the option
+ * @return      -ENOSPC if the option value is longer than 4 bytes
+ */
+int coap_opt_get_uint(const coap_pkt_t *pkt, uint16_t optnum, uint32_t *value);
+
 /**
  * @brief   Read a full option as null terminated string into the target buffer
  *
@@ -1016,6 +1095,62 @@ static inline unsigned coap_method2flag(unsigned code)
     return (1 << (code - 1));
 }
 
+/**
+ * @brief   Initializes an empty resource index
+ *
+ * @param[out]  index       index to initialize
+ * @param[in]   entries     storage for the hash table
+ * @param[in]   size        number of @p entries, must be a power of 2
+ */
+void coap_resource_index_init(coap_resource_index_t *index,
+                              coap_resource_index_entry_t *entries, unsigned size);
+
+/**
+ * @brief   Adds a resource to an index
+ *
+ * Resources with the same path are found in the order they were added.
+ *
+ * @param[in,out]   index       index to add @p resource to
+ * @param[in]       resource    resource to add
+ *
+ * @returns     0 on success
+ * @returns     -ENOMEM if @p index is full, index->overflow is set then
+ */
+int coap_resource_index_add(coap_resource_index_t *index,
+                            const coap_resource_t *resource);
+
+/**
+ * @brief   Finds the resource for a request path in an index
+ *
+ * A resource matches if its path equals @p path, or if it has the
+ * COAP_MATCH_SUBTREE flag and its path is a parent of @p path. The longest
+ * match allowing @p method_flag wins.
+ *
+ * @param[in]   index       index to search
+ * @param[in]   path        request path, e.g. from coap_get_uri_path()
+ * @param[in]   method_flag request method, see coap_method2flag()
+ * @param[out]  resource    the matching resource
+ *
+ * @returns     0 on success
+ * @returns     -ENOENT if no resource matches @p path
+ * @returns     -ENOTSUP if matching resources do not allow @p method_flag
+ */
+int coap_resource_index_find(const coap_resource_index_t *index, const char *path,
+                             unsigned method_flag, const coap_resource_t **resource);
+
+/**
+ * @brief   Matches a request path against a single resource
+ *
+ * Linear search counterpart of coap_resource_index_find().
+ *
+ * @param[in]   resource    resource to match
+ * @param[in]   path        request path
+ *
+ * @returns     length of the matching resource path, a longer match is better
+ * @returns     -1 if @p resource does not match @p path
+ */
+int coap_match_path(const coap_resource_t *resource, const char *path);
+
 #if defined(MODULE_GCOAP) || defined(DOXYGEN)
 /**
  * @brief   Identifies a packet containing an observe option
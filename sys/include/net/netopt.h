@@ -554,6 +554,34 @@ typedef enum {
      */
     NETOPT_PHY_BUSY,
 
+    /**
+     * @brief   (@ref netopt_enable_t) frames pending, read-only
+     *
+     * Returns NETOPT_ENABLE if the device holds further received frames that
+     * can be read with netdev_driver_t::recv() right away, without waiting
+     * for another @ref NETDEV_EVENT_ISR.
+     */
+    NETOPT_RX_PENDING,
+
+    /**
+     * @brief   (@ref netopt_enable_t) transmit checksum offload, read-only
+     *
+     * Returns NETOPT_ENABLE if the device calculates the UDP, TCP and ICMPv6
+     * checksums of outgoing frames itself. The stack then leaves the checksum
+     * fields of the packets it sends over this device as they are.
+     */
+    NETOPT_TX_CSUM_OFFLOAD,
+
+    /**
+     * @brief   (@ref netopt_enable_t) receive checksum offload, read-only
+     *
+     * Returns NETOPT_ENABLE if the device verifies the UDP, TCP and ICMPv6
+     * checksums of incoming frames and drops frames with invalid ones. The
+     * stack then does not verify the checksums of packets received by this
+     * device again.
+     */
+    NETOPT_RX_CSUM_OFFLOAD,
+
     /* add more options if needed */
 
     /**
@@ -51,6 +51,12 @@ typedef struct {
     uint32_t tx_bytes;          /**< sent bytes */
     uint32_t rx_count;          /**< received (data) packets */
     uint32_t rx_bytes;          /**< received bytes */
+#if defined(MODULE_GNRC_NETIF_TXQ) || DOXYGEN
+    uint32_t tx_queue_drops;    /**< packets dropped because the transmit
+                                     queue was full (`gnrc_netif_txq`) */
+    uint16_t tx_queue_max;      /**< maximum number of packets in the
+                                     transmit queue (`gnrc_netif_txq`) */
+#endif
 } netstats_t;
 
 #ifdef __cplusplus
@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2018 OverDriveGain
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_schedtrace Scheduler trace
+ * @ingroup     sys
+ * @brief       Records context switches into a ring buffer
+ *
+ * Every context switch is recorded with a time stamp, the thread leaving the
+ * CPU, the thread entering it and the reason the former left. The reason is
+ * derived from the status of the leaving thread, so no blocking primitive has
+ * to be instrumented.
+ *
+ * Recording happens in sched_run() with interrupts disabled. It costs one read
+ * of the low level xtimer timer, a table lookup and five stores, and nothing at
+ * all if the scheduler keeps the running thread. With this module,
+ * bench_msg_pingpong and bench_sched_nop must stay within 5% of their results
+ * without it (run them with `SCHEDTRACE=1`).
+ *
+ * The ring is written by the scheduler only and read without locking: readers
+ * detect and skip events that were overwritten while they copied them.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Scheduler trace interface
+ *
+ * @author      OverDriveGain
+ */
+
+#ifndef SCHEDTRACE_H
+#define SCHEDTRACE_H
+
+#include <stdint.h>
+#include "kernel_types.h"
+#include "thread.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Number of events kept in the ring, must be a power of 2
+ */
+#ifndef SCHEDTRACE_SIZE
+#define SCHEDTRACE_SIZE     (64U)
+#endif
+
+/**
+ * @brief Reasons for a context switch
+ */
+typedef enum {
+    SCHEDTRACE_EXIT = 0,    /**< thread terminated */
+    SCHEDTRACE_SLEEP,       /**< thread went to sleep */
+    SCHEDTRACE_MUTEX,       /**< thread blocked on a mutex */
+    SCHEDTRACE_MSG,         /**< thread blocked sending or receiving a msg */
+    SCHEDTRACE_FLAGS,       /**< thread blocked waiting for thread flags */
+    SCHEDTRACE_MBOX,        /**< thread blocked on a mbox */
+    SCHEDTRACE_YIELD,       /**< thread yielded to a thread of the same priority */
+    SCHEDTRACE_PREEMPT,     /**< thread was preempted by a higher priority thread */
+    SCHEDTRACE_REASON_NUMOF /**< number of reasons */
+} schedtrace_reason_t;
+
+/**
+ * @brief A recorded context switch
+ */
+typedef struct {
+    uint32_t time;          /**< low level xtimer ticks, wrapping at XTIMER_WIDTH */
+    kernel_pid_t from;      /**< leaving thread, KERNEL_PID_UNDEF if unknown */
+    kernel_pid_t to;        /**< entering thread */
+    uint8_t reason;         /**< @ref schedtrace_reason_t */
+} schedtrace_event_t;
+
+/**
+ * @brief Records a context switch
+ *
+ * @note Called by the scheduler with interrupts disabled.
+ *
+ * @param[in] from  thread leaving the CPU, may be NULL
+ * @param[in] to    thread entering the CPU
+ */
+void schedtrace_switch(const thread_t *from, const thread_t *to);
+
+/**
+ * @brief Copies recorded events, oldest first
+ *
+ * Events that were overwritten before they could be read are skipped.
+ *
+ * @param[in,out] pos   position to start reading at, 0 for the oldest event
+ *                      in the ring. Updated to the position after the last
+ *                      event read.
+ * @param[out]    buf   buffer for the events
+ * @param[in]     len   maximum number of events to copy into @p buf
+ *
+ * @return  number of events copied into @p buf
+ */
+unsigned schedtrace_read(uint32_t *pos, schedtrace_event_t *buf, unsigned len);
+
+/**
+ * @brief Returns the total number of recorded context switches
+ *
+ * @return  the position after the latest event
+ */
+uint32_t schedtrace_count(void);
+
+/**
+ * @brief Returns a printable name for a reason
+ *
+ * @param[in] reason    @ref schedtrace_reason_t
+ *
+ * @return  name of @p reason
+ */
+const char *schedtrace_reason_str(uint8_t reason);
+
+/**
+ * @brief Prints the events in the ring to stdout
+ */
+void schedtrace_print(void);
+
+#if defined(CPU_NATIVE) || defined(DOXYGEN)
+/**
+ * @brief Writes the events in the ring to a file of the host
+ *
+ * One line per event: `time,from,to,reason`
+ *
+ * @note Only available on native.
+ *
+ * @param[in] path  path of the file, it is replaced if it exists
+ *
+ * @return  number of events written
+ * @return  -errno if the file could not be written
+ */
+int schedtrace_dump(const char *path);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SCHEDTRACE_H */
+/** @} */
@@ -20,6 +20,13 @@
  * number of active timers.  The reason for this is that multiplexing is
  * realized by next-first singly linked lists.
  *
+ * With the `xtimer_heap` module, pairing heaps take the place of the lists.
+ * Insertion becomes O(1) and removal O(log n) amortized, at the cost of two
+ * additional pointers in every @ref xtimer_t. Timers with the same target
+ * expire in unspecified order then. Removing a timer follows these pointers,
+ * so a timer must be zeroed before it is set or removed for the first time,
+ * e.g. with `xtimer_t timer = { 0 };` on the stack.
+ *
  * @{
  * @file
  * @brief   xtimer interface definitions
@@ -69,6 +76,10 @@ typedef void (*xtimer_callback_t)(void*);
  */
 typedef struct xtimer {
     struct xtimer *next;         /**< reference to next timer in timer lists */
+#if defined(MODULE_XTIMER_HEAP) || defined(DOXYGEN)
+    struct xtimer *child;        /**< first child in the timer heap */
+    struct xtimer *prev;         /**< parent or left sibling in the timer heap */
+#endif
     uint32_t target;             /**< lower 32bit absolute target time */
     uint32_t long_target;        /**< upper 32bit absolute target time */
     xtimer_callback_t callback;  /**< callback function to call when timer
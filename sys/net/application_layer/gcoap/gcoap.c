@@ -49,8 +49,25 @@ static ssize_t _finish_pdu(coap_pkt_t *pdu, uint8_t *buf, size_t len);
 static void _expire_request(gcoap_request_memo_t *memo);
 static void _find_req_memo(gcoap_request_memo_t **memo_ptr, coap_pkt_t *pdu,
                            const sock_udp_ep_t *remote);
+static gcoap_request_memo_t *_find_req_memo_by_mid(coap_pkt_t *pdu,
+                                                   const sock_udp_ep_t *remote);
+static void _handle_empty(coap_pkt_t *pdu, const sock_udp_ep_t *remote);
+static coap_hdr_t *_memo_hdr(gcoap_request_memo_t *memo);
+static void _add_req_memo(gcoap_request_memo_t *memo);
+static gcoap_request_memo_t *_release_memo(gcoap_request_memo_t *memo);
+static void _finish_memo(gcoap_request_memo_t *memo);
+static void _notify_req(gcoap_request_memo_t *memo, unsigned state);
+static ssize_t _send_req(gcoap_request_memo_t *memo, const uint8_t *buf,
+                         size_t len);
+static uint32_t _con_timeout(gcoap_request_memo_t *memo);
+static gcoap_peer_t *_get_peer(const sock_udp_ep_t *remote);
+#ifdef MODULE_GCOAP_COCOA
+static void _cocoa_start(gcoap_request_memo_t *memo);
+static void _cocoa_measure(gcoap_request_memo_t *memo);
+#endif
 static int _find_resource(coap_pkt_t *pdu, const coap_resource_t **resource_ptr,
                                             gcoap_listener_t **listener_ptr);
+static void _index_listener(gcoap_listener_t *listener);
 static int _find_observer(sock_udp_ep_t **observer, sock_udp_ep_t *remote);
 static int _find_obs_memo(gcoap_observe_memo_t **memo, sock_udp_ep_t *remote,
                                                        coap_pkt_t *pdu);
@@ -68,14 +85,26 @@ static gcoap_listener_t _default_listener = {
     NULL
 };
 
+static coap_resource_index_entry_t _index_entries[GCOAP_RESOURCE_INDEX_SIZE];
+
 /* Container for the state of gcoap itself */
 typedef struct {
     mutex_t lock;                       /* Shares state attributes safely */
     gcoap_listener_t *listeners;        /* List of registered listeners */
+    coap_resource_index_t index;        /* Resources of all listeners, by path */
     gcoap_request_memo_t open_reqs[GCOAP_REQ_WAITING_MAX];
-                                        /* Storage for open requests; if first
-                                           byte of an entry is zero, the entry
-                                           is available */
+                                        /* Storage for open requests */
+    gcoap_request_memo_t *free_reqs;    /* Unused open_reqs entries, chained
+                                           via next_token */
+    unsigned open_reqs_numof;           /* Number of used open_reqs entries */
+    gcoap_request_memo_t *reqs_by_token[GCOAP_REQ_INDEX_SIZE];
+                                        /* Open requests, hashed by token */
+    gcoap_request_memo_t *reqs_by_mid[GCOAP_REQ_INDEX_SIZE];
+                                        /* Open requests, hashed by message ID */
+    gcoap_peer_t peers[GCOAP_PEERS_MAX];
+                                        /* Endpoints of open requests; an entry
+                                           without outstanding and queued
+                                           requests is available */
     atomic_uint next_message_id;        /* Next message ID to use */
     sock_udp_ep_t observers[GCOAP_OBS_CLIENTS_MAX];
                                         /* Observe clients; allows reuse for
@@ -90,6 +119,10 @@ typedef struct {
 
 static gcoap_state_t _coap_state = {
     .listeners   = &_default_listener,
+    .index       = {
+        .entries = _index_entries,
+        .size    = GCOAP_RESOURCE_INDEX_SIZE,
+    },
 };
 
 static kernel_pid_t _pid = KERNEL_PID_UNDEF;
@@ -126,18 +159,19 @@ static void *_event_loop(void *arg)
             case GCOAP_MSG_TYPE_TIMEOUT: {
                 gcoap_request_memo_t *memo = (gcoap_request_memo_t *)msg_rcvd.content.ptr;
 
+                /* response handled while the timeout message was queued */
+                if (memo->state != GCOAP_MEMO_WAIT) {
+                    break;
+                }
                 /* no retries remaining */
                 if ((memo->send_limit == GCOAP_SEND_LIMIT_NON)
                         || (memo->send_limit == 0)) {
                     _expire_request(memo);
                 }
-                /* reduce retries remaining, double timeout and resend */
+                /* reduce retries remaining, back off timeout and resend */
                 else {
                     memo->send_limit--;
-                    unsigned i        = COAP_MAX_RETRANSMIT - memo->send_limit;
-                    uint32_t timeout  = ((uint32_t)COAP_ACK_TIMEOUT << i) * US_PER_SEC;
-                    uint32_t variance = ((uint32_t)COAP_ACK_VARIANCE << i) * US_PER_SEC;
-                    timeout = random_uint32_range(timeout, timeout + variance);
+                    uint32_t timeout = _con_timeout(memo);
 
                     ssize_t bytes = sock_udp_send(&_sock, memo->msg.data.pdu_buf,
                                                   memo->msg.data.pdu_len,
@@ -171,7 +205,7 @@ static void _listen(sock_udp_t *sock)
     uint8_t buf[GCOAP_PDU_BUF_SIZE];
     sock_udp_ep_t remote;
     gcoap_request_memo_t *memo = NULL;
-    uint8_t open_reqs = gcoap_op_state();
+    unsigned open_reqs = _coap_state.open_reqs_numof;
 
     /* We expect a -EINTR response here when unlimited waiting (SOCK_NO_TIMEOUT)
      * is interrupted when sending a message in gcoap_req_send2(). While a
@@ -198,7 +232,7 @@ static void _listen(sock_udp_t *sock)
     }
 
     if (pdu.hdr->code == COAP_CODE_EMPTY) {
-        DEBUG("gcoap: empty messages not handled yet\n");
+        _handle_empty(&pdu, &remote);
         return;
     }
 
@@ -225,32 +259,42 @@ static void _listen(sock_udp_t *sock)
     case COAP_CLASS_SUCCESS:
     case COAP_CLASS_CLIENT_FAILURE:
     case COAP_CLASS_SERVER_FAILURE:
-        _find_req_memo(&memo, &pdu, &remote);
-        if (memo) {
-            switch (coap_get_type(&pdu)) {
-            case COAP_TYPE_NON:
-            case COAP_TYPE_ACK:
-                xtimer_remove(&memo->response_timer);
+        switch (coap_get_type(&pdu)) {
+        case COAP_TYPE_CON: {
+            /* acknowledge a separate response, also if it is a duplicate */
+            uint8_t ack[sizeof(coap_hdr_t)];
+
+            coap_build_hdr((coap_hdr_t *)ack, COAP_TYPE_ACK, NULL, 0,
+                           COAP_CODE_EMPTY, coap_get_id(&pdu));
+            sock_udp_send(sock, ack, sizeof(ack), &remote);
+        }
+        /* fall through */
+        case COAP_TYPE_NON:
+        case COAP_TYPE_ACK:
+            mutex_lock(&_coap_state.lock);
+            _find_req_memo(&memo, &pdu, &remote);
+            if (memo) {
                 memo->state = GCOAP_MEMO_RESP;
+            }
+            mutex_unlock(&_coap_state.lock);
+
+            if (memo) {
+                xtimer_remove(&memo->response_timer);
+#ifdef MODULE_GCOAP_COCOA
+                _cocoa_measure(memo);
+#endif
                 if (memo->resp_handler) {
                     memo->resp_handler(memo->state, &pdu, &remote);
                 }
-
-                if (memo->send_limit >= 0) {        /* if confirmable */
-                    *memo->msg.data.pdu_buf = 0;    /* clear resend PDU buffer */
-                }
-                memo->state = GCOAP_MEMO_UNUSED;
-                break;
-            case COAP_TYPE_CON:
-                DEBUG("gcoap: separate CON response not handled yet\n");
-                break;
-            default:
-                DEBUG("gcoap: illegal response type: %u\n", coap_get_type(&pdu));
-                break;
+                _finish_memo(memo);
             }
-        }
-        else {
-            DEBUG("gcoap: msg not found for ID: %u\n", coap_get_id(&pdu));
+            else {
+                DEBUG("gcoap: msg not found for ID: %u\n", coap_get_id(&pdu));
+            }
+            break;
+        default:
+            DEBUG("gcoap: illegal response type: %u\n", coap_get_type(&pdu));
+            break;
         }
         break;
     default:
@@ -388,39 +432,72 @@ static int _find_resource(coap_pkt_t *pdu, const coap_resource_t **resource_ptr,
 {
     int ret = GCOAP_RESOURCE_NO_PATH;
     unsigned method_flag = coap_method2flag(coap_get_code_detail(pdu));
+    const coap_resource_t *found = NULL;
 
-    /* Find path for CoAP msg among listener resources and execute callback. */
-    gcoap_listener_t *listener = _coap_state.listeners;
-    while (listener) {
-        const coap_resource_t *resource = listener->resources;
-        for (size_t i = 0; i < listener->resources_len; i++) {
-            if (i) {
-                resource++;
-            }
+    if (!_coap_state.index.overflow) {
+        int res = coap_resource_index_find(&_coap_state.index, (char *)&pdu->url[0],
+                                           method_flag, &found);
+        if (res == 0) {
+            ret = GCOAP_RESOURCE_FOUND;
+        }
+        else if (res == -ENOTSUP) {
+            ret = GCOAP_RESOURCE_WRONG_METHOD;
+        }
+    }
+    else {
+        /* Find longest matching path among listener resources. */
+        int best = -1;
 
-            int res = strcmp((char *)&pdu->url[0], resource->path);
-            if (res > 0) {
-                continue;
-            }
-            else if (res < 0) {
-                /* resources expected in alphabetical order */
-                break;
-            }
-            else {
+        for (gcoap_listener_t *listener = _coap_state.listeners; listener;
+             listener = listener->next) {
+            for (size_t i = 0; i < listener->resources_len; i++) {
+                const coap_resource_t *resource = &listener->resources[i];
+                int res = coap_match_path(resource, (char *)&pdu->url[0]);
+
+                if (res < 0) {
+                    continue;
+                }
                 if (! (resource->methods & method_flag)) {
-                    ret = GCOAP_RESOURCE_WRONG_METHOD;
+                    if (ret == GCOAP_RESOURCE_NO_PATH) {
+                        ret = GCOAP_RESOURCE_WRONG_METHOD;
+                    }
                     continue;
                 }
-
-                *resource_ptr = resource;
-                *listener_ptr = listener;
-                return GCOAP_RESOURCE_FOUND;
+                if (res > best) {
+                    best = res;
+                    found = resource;
+                    ret = GCOAP_RESOURCE_FOUND;
+                }
             }
         }
-        listener = listener->next;
     }
 
-    return ret;
+    if (ret != GCOAP_RESOURCE_FOUND) {
+        return ret;
+    }
+
+    /* Look up the listener owning the resource. */
+    for (gcoap_listener_t *listener = _coap_state.listeners; listener;
+         listener = listener->next) {
+        if ((found >= listener->resources) &&
+            (found < listener->resources + listener->resources_len)) {
+            *listener_ptr = listener;
+            break;
+        }
+    }
+    *resource_ptr = found;
+    return GCOAP_RESOURCE_FOUND;
+}
+
+/* Adds the resources of a listener to the resource index. */
+static void _index_listener(gcoap_listener_t *listener)
+{
+    for (size_t i = 0; i < listener->resources_len; i++) {
+        if (coap_resource_index_add(&_coap_state.index, &listener->resources[i]) < 0) {
+            DEBUG("gcoap: resource index full, searching linearly\n");
+            return;
+        }
+    }
 }
 
 /*
@@ -446,10 +523,55 @@ static ssize_t _finish_pdu(coap_pkt_t *pdu, uint8_t *buf, size_t len)
     }
 }
 
+/* Returns the header of the request of a memo */
+static coap_hdr_t *_memo_hdr(gcoap_request_memo_t *memo)
+{
+    if (memo->send_limit == GCOAP_SEND_LIMIT_NON) {
+        return (coap_hdr_t *)&memo->msg.hdr_buf[0];
+    }
+    return (coap_hdr_t *)memo->msg.data.pdu_buf;
+}
+
+/* Returns the bucket of the token index for the token of a header */
+static gcoap_request_memo_t **_token_bucket(const coap_hdr_t *hdr)
+{
+    unsigned tkl  = hdr->ver_t_tkl & 0xf;
+    unsigned hash = 0;
+
+    for (unsigned i = 0; i < tkl; i++) {
+        hash = (hash * 31) + hdr->data[i];
+    }
+    return &_coap_state.reqs_by_token[hash & (GCOAP_REQ_INDEX_SIZE - 1)];
+}
+
+/* Returns the bucket of the message ID index for the ID of a header */
+static gcoap_request_memo_t **_mid_bucket(const coap_hdr_t *hdr)
+{
+    /* message IDs are sequential */
+    return &_coap_state.reqs_by_mid[ntohs(hdr->id) & (GCOAP_REQ_INDEX_SIZE - 1)];
+}
+
+/* Adds a memo to the token and message ID indexes; lock must be held */
+static void _add_req_memo(gcoap_request_memo_t *memo)
+{
+    gcoap_request_memo_t **bucket;
+    coap_hdr_t *hdr = _memo_hdr(memo);
+
+    bucket = _token_bucket(hdr);
+    memo->next_token = *bucket;
+    *bucket = memo;
+
+    bucket = _mid_bucket(hdr);
+    memo->next_mid = *bucket;
+    *bucket = memo;
+}
+
 /*
  * Finds the memo for an outstanding request within the _coap_state.open_reqs
  * array. Matches on remote endpoint and token.
  *
+ * Lock must be held.
+ *
  * memo_ptr[out] -- Registered request memo, or NULL if not found
  * src_pdu[in] -- PDU for token to match
  * remote[in] -- Remote endpoint to match
@@ -457,31 +579,165 @@ static ssize_t _finish_pdu(coap_pkt_t *pdu, uint8_t *buf, size_t len)
 static void _find_req_memo(gcoap_request_memo_t **memo_ptr, coap_pkt_t *src_pdu,
                            const sock_udp_ep_t *remote)
 {
+    unsigned cmplen = coap_get_token_len(src_pdu);
+
     *memo_ptr = NULL;
-    /* no need to initialize struct; we only care about buffer contents below */
-    coap_pkt_t memo_pdu_data;
-    coap_pkt_t *memo_pdu = &memo_pdu_data;
-    unsigned cmplen      = coap_get_token_len(src_pdu);
+    if (cmplen > GCOAP_TOKENLEN_MAX) {
+        return;
+    }
 
-    for (int i = 0; i < GCOAP_REQ_WAITING_MAX; i++) {
-        if (_coap_state.open_reqs[i].state == GCOAP_MEMO_UNUSED)
-            continue;
+    for (gcoap_request_memo_t *memo = *_token_bucket(src_pdu->hdr); memo;
+         memo = memo->next_token) {
+        coap_hdr_t *memo_hdr = _memo_hdr(memo);
 
-        gcoap_request_memo_t *memo = &_coap_state.open_reqs[i];
-        if (memo->send_limit == GCOAP_SEND_LIMIT_NON) {
-            memo_pdu->hdr = (coap_hdr_t *) &memo->msg.hdr_buf[0];
+        if ((memo->state == GCOAP_MEMO_WAIT)
+                && ((memo_hdr->ver_t_tkl & 0xf) == cmplen)
+                && (memcmp(src_pdu->token, &memo_hdr->data[0], cmplen) == 0)
+                && sock_udp_ep_equal(&memo->remote_ep, remote)) {
+            *memo_ptr = memo;
+            break;
         }
-        else {
-            memo_pdu->hdr = (coap_hdr_t *) memo->msg.data.pdu_buf;
+    }
+}
+
+/*
+ * Finds the memo for an outstanding confirmable request by the message ID of
+ * an empty ACK or RST. Lock must be held.
+ */
+static gcoap_request_memo_t *_find_req_memo_by_mid(coap_pkt_t *pdu,
+                                                   const sock_udp_ep_t *remote)
+{
+    for (gcoap_request_memo_t *memo = *_mid_bucket(pdu->hdr); memo;
+         memo = memo->next_mid) {
+        if ((memo->state == GCOAP_MEMO_WAIT)
+                && (memo->send_limit != GCOAP_SEND_LIMIT_NON)
+                && (_memo_hdr(memo)->id == pdu->hdr->id)
+                && (coap_get_type(pdu) == COAP_TYPE_RST
+                    || ((_memo_hdr(memo)->ver_t_tkl & 0x30) >> 4) == COAP_TYPE_CON)
+                && sock_udp_ep_equal(&memo->remote_ep, remote)) {
+            return memo;
+        }
+    }
+    return NULL;
+}
+
+/* Handles an empty ACK or RST for a request */
+static void _handle_empty(coap_pkt_t *pdu, const sock_udp_ep_t *remote)
+{
+    gcoap_request_memo_t *memo;
+    unsigned type = coap_get_type(pdu);
+
+    if ((type != COAP_TYPE_ACK) && (type != COAP_TYPE_RST)) {
+        DEBUG("gcoap: empty messages not handled yet\n");
+        return;
+    }
+
+    mutex_lock(&_coap_state.lock);
+    memo = _find_req_memo_by_mid(pdu, remote);
+    if (memo && (type == COAP_TYPE_RST)) {
+        memo->state = GCOAP_MEMO_ERR;
+    }
+    mutex_unlock(&_coap_state.lock);
+
+    if (!memo) {
+        DEBUG("gcoap: msg not found for ID: %u\n", coap_get_id(pdu));
+        return;
+    }
+
+    xtimer_remove(&memo->response_timer);
+    if (type == COAP_TYPE_RST) {
+        /* the server rejected the request */
+        _notify_req(memo, GCOAP_MEMO_ERR);
+        _finish_memo(memo);
+    }
+    else {
+        /* the response follows separately; stop resending and wait for it
+         * like for a non-confirmable request */
+#ifdef MODULE_GCOAP_COCOA
+        _cocoa_measure(memo);
+#endif
+        memo->send_limit = 0;
+        if (GCOAP_NON_TIMEOUT > 0) {
+            xtimer_set_msg(&memo->response_timer, GCOAP_NON_TIMEOUT,
+                           &memo->timeout_msg, _pid);
         }
+    }
+}
+
+/* Passes the request of a memo to its handler, on timeout or error */
+static void _notify_req(gcoap_request_memo_t *memo, unsigned state)
+{
+    memo->state = state;
+    if (memo->resp_handler) {
+        coap_pkt_t req;
+
+        req.hdr = _memo_hdr(memo);   /* for reference */
+        memo->resp_handler(memo->state, &req, NULL);
+    }
+}
+
+/*
+ * Puts a memo back to the unused memos. Returns the next request queued for
+ * the endpoint of the memo, if it may be sent now. Lock must be held.
+ */
+static gcoap_request_memo_t *_release_memo(gcoap_request_memo_t *memo)
+{
+    gcoap_peer_t *peer = memo->peer;
+    coap_hdr_t *hdr = _memo_hdr(memo);
+    gcoap_request_memo_t **ptr;
+
+    /* remove from indexes */
+    for (ptr = _token_bucket(hdr); *ptr != memo; ptr = &(*ptr)->next_token) {}
+    *ptr = memo->next_token;
+    for (ptr = _mid_bucket(hdr); *ptr != memo; ptr = &(*ptr)->next_mid) {}
+    *ptr = memo->next_mid;
+
+    if (memo->send_limit != GCOAP_SEND_LIMIT_NON) {
+        *memo->msg.data.pdu_buf = 0;    /* clear resend buffer */
+    }
+    memo->state = GCOAP_MEMO_UNUSED;
+    memo->next_token = _coap_state.free_reqs;
+    _coap_state.free_reqs = memo;
+    _coap_state.open_reqs_numof--;
+    peer->outstanding--;
+
+    memo = peer->queue;
+#if GCOAP_NSTART > 0
+    if (peer->outstanding >= GCOAP_NSTART) {
+        return NULL;
+    }
+#endif
+    if (memo) {
+        peer->queue = memo->next_queued;
+        memo->state = GCOAP_MEMO_WAIT;
+        peer->outstanding++;
+#ifdef MODULE_GCOAP_COCOA
+        if (memo->send_limit > 0) {
+            _cocoa_start(memo);
+        }
+#endif
+        return memo;
+    }
+    return NULL;
+}
+
+/*
+ * Releases the memo of a completed request and sends the next request queued
+ * for its endpoint.
+ */
+static void _finish_memo(gcoap_request_memo_t *memo)
+{
+    while (memo) {
+        mutex_lock(&_coap_state.lock);
+        memo = _release_memo(memo);
+        mutex_unlock(&_coap_state.lock);
 
-        if (coap_get_token_len(memo_pdu) == cmplen) {
-            memo_pdu->token = &memo_pdu->hdr->data[0];
-            if ((memcmp(src_pdu->token, memo_pdu->token, cmplen) == 0)
-                    && sock_udp_ep_equal(&memo->remote_ep, remote)) {
-                *memo_ptr = memo;
+        if (memo) {
+            if (_send_req(memo, memo->msg.data.pdu_buf, memo->msg.data.pdu_len) > 0) {
                 break;
             }
+            DEBUG("gcoap: sock send failed for queued request\n");
+            _notify_req(memo, GCOAP_MEMO_ERR);
         }
     }
 }
@@ -491,22 +747,9 @@ static void _expire_request(gcoap_request_memo_t *memo)
 {
     DEBUG("coap: received timeout message\n");
     if (memo->state == GCOAP_MEMO_WAIT) {
-        memo->state = GCOAP_MEMO_TIMEOUT;
         /* Pass response to handler */
-        if (memo->resp_handler) {
-            coap_pkt_t req;
-            if (memo->send_limit == GCOAP_SEND_LIMIT_NON) {
-                req.hdr = (coap_hdr_t *)&memo->msg.hdr_buf[0];   /* for reference */
-            }
-            else {
-                req.hdr = (coap_hdr_t *)memo->msg.data.pdu_buf;
-            }
-            memo->resp_handler(memo->state, &req, NULL);
-        }
-        if (memo->send_limit != GCOAP_SEND_LIMIT_NON) {
-            *memo->msg.data.pdu_buf = 0;    /* clear resend buffer */
-        }
-        memo->state = GCOAP_MEMO_UNUSED;
+        _notify_req(memo, GCOAP_MEMO_TIMEOUT);
+        _finish_memo(memo);
     }
     else {
         /* Response already handled; timeout must have fired while response */
@@ -514,6 +757,186 @@ static void _expire_request(gcoap_request_memo_t *memo)
     }
 }
 
+/*
+ * Returns an endpoint entry for remote, or NULL if all entries are in use.
+ * Lock must be held.
+ */
+static gcoap_peer_t *_get_peer(const sock_udp_ep_t *remote)
+{
+    gcoap_peer_t *idle = NULL;
+
+    for (unsigned i = 0; i < GCOAP_PEERS_MAX; i++) {
+        gcoap_peer_t *peer = &_coap_state.peers[i];
+
+        if (sock_udp_ep_equal(&peer->remote, remote)) {
+            return peer;
+        }
+        if (!idle && (peer->outstanding == 0) && (peer->queue == NULL)) {
+            idle = peer;
+        }
+    }
+    if (idle) {
+        memset(idle, 0, sizeof(gcoap_peer_t));
+        memcpy(&idle->remote, remote, sizeof(sock_udp_ep_t));
+    }
+    return idle;
+}
+
+/*
+ * Returns the timeout for the transmission of a confirmable request, with
+ * send_limit already reduced for a resend
+ */
+static uint32_t _con_timeout(gcoap_request_memo_t *memo)
+{
+#ifdef MODULE_GCOAP_COCOA
+    /* the first timeout is set by _cocoa_start() */
+    if (memo->send_limit < COAP_MAX_RETRANSMIT) {
+        memo->timeout = (memo->timeout / 2) * memo->backoff;
+    }
+    return memo->timeout;
+#else
+    unsigned i        = COAP_MAX_RETRANSMIT - memo->send_limit;
+    uint32_t timeout  = ((uint32_t)COAP_ACK_TIMEOUT << i) * US_PER_SEC;
+    uint32_t variance = ((uint32_t)COAP_ACK_VARIANCE << i) * US_PER_SEC;
+
+    return random_uint32_range(timeout, timeout + variance);
+#endif
+}
+
+#ifdef MODULE_GCOAP_COCOA
+/* Bounds for the RTO estimate of an endpoint */
+#define COCOA_RTO_INIT  ((uint32_t)COAP_ACK_TIMEOUT * US_PER_SEC)
+#define COCOA_RTO_MAX   (32U * US_PER_SEC)
+
+/*
+ * Sets the first retransmission timeout of a confirmable request from the
+ * RTO estimate of its endpoint. Lock must be held.
+ */
+static void _cocoa_start(gcoap_request_memo_t *memo)
+{
+    gcoap_peer_t *peer = memo->peer;
+    uint32_t now = xtimer_now_usec();
+
+    /* age an estimate that was not updated for a while */
+    if (peer->rto == 0) {
+        peer->rto = COCOA_RTO_INIT;
+        peer->updated = now;
+    }
+    else if ((peer->rto < US_PER_SEC) && ((now - peer->updated) > 16 * peer->rto)) {
+        peer->rto *= 2;
+        peer->updated = now;
+    }
+    else if ((peer->rto > 3 * US_PER_SEC) && ((now - peer->updated) > 4 * peer->rto)) {
+        peer->rto = (peer->rto + COCOA_RTO_INIT) / 2;
+        peer->updated = now;
+    }
+
+    /* variable backoff factor, in halves */
+    if (peer->rto < US_PER_SEC) {
+        memo->backoff = 6;
+    }
+    else if (peer->rto > 3 * US_PER_SEC) {
+        memo->backoff = 3;
+    }
+    else {
+        memo->backoff = 4;
+    }
+    memo->timeout = random_uint32_range(peer->rto, peer->rto + peer->rto / 2);
+    memo->sent = now;
+}
+
+/*
+ * Updates the RTO estimate of the endpoint of a confirmable request with the
+ * RTT measured for the request. The strong estimator takes requests that were
+ * not resent, the weak estimator requests resent once or twice.
+ */
+static void _cocoa_measure(gcoap_request_memo_t *memo)
+{
+    gcoap_peer_t *peer = memo->peer;
+    unsigned resends = COAP_MAX_RETRANSMIT - memo->send_limit;
+
+    if ((memo->sent == 0) || (memo->send_limit == GCOAP_SEND_LIMIT_NON)
+            || (resends > 2)) {
+        return;
+    }
+
+    mutex_lock(&_coap_state.lock);
+    uint32_t now = xtimer_now_usec();
+    uint32_t rtt = now - memo->sent;
+    unsigned weak = (resends > 0);
+    uint32_t *srtt = &peer->srtt[weak];
+    uint32_t *rttvar = &peer->rttvar[weak];
+
+    if (*srtt == 0) {
+        *srtt = rtt;
+        *rttvar = rtt / 2;
+    }
+    else {
+        uint32_t diff = (*srtt > rtt) ? (*srtt - rtt) : (rtt - *srtt);
+
+        *rttvar = (3 * *rttvar + diff) / 4;
+        *srtt = (7 * *srtt + rtt) / 8;
+    }
+    if (weak) {
+        peer->rto = (3 * peer->rto + (*srtt + *rttvar)) / 4;
+    }
+    else {
+        peer->rto = (peer->rto + (*srtt + 4 * *rttvar)) / 2;
+    }
+    if (peer->rto > COCOA_RTO_MAX) {
+        peer->rto = COCOA_RTO_MAX;
+    }
+    peer->updated = now;
+    memo->sent = 0;
+    mutex_unlock(&_coap_state.lock);
+}
+#endif
+
+/*
+ * Sends a request and starts the timer for its response. The memo must be
+ * in GCOAP_MEMO_WAIT state.
+ */
+static ssize_t _send_req(gcoap_request_memo_t *memo, const uint8_t *buf,
+                         size_t len)
+{
+    uint32_t timeout;
+
+    if ((memo->send_limit == GCOAP_SEND_LIMIT_NON) || (memo->send_limit == 0)) {
+        /* timeout may be zero for non-confirmable */
+        timeout = GCOAP_NON_TIMEOUT;
+    }
+    else {
+        timeout = _con_timeout(memo);
+    }
+
+    if (timeout > 0) {
+        if (thread_getpid() != _pid) {
+            /* When there are no outstanding requests, gcoap blocks
+             * indefinitely in _listen() at sock_udp_recv(). Put a message in
+             * the mbox for the sock udp object to interrupt it. While the
+             * request is outstanding, sock_udp_recv() is called with a short
+             * timeout, so the request timer below, also on the gcoap thread,
+             * is processed in a timely manner. If the mbox is full, gcoap
+             * wakes up anyway. */
+            msg_t mbox_msg;
+            mbox_msg.type          = GCOAP_MSG_TYPE_INTR;
+            mbox_msg.content.value = 0;
+            mbox_try_put(&_sock.reg.mbox, &mbox_msg);
+        }
+        /* start the timer before sending, the response may arrive before
+         * sock_udp_send() returns */
+        memo->timeout_msg.type        = GCOAP_MSG_TYPE_TIMEOUT;
+        memo->timeout_msg.content.ptr = (char *)memo;
+        xtimer_set_msg(&memo->response_timer, timeout, &memo->timeout_msg, _pid);
+    }
+
+    ssize_t res = sock_udp_send(&_sock, buf, len, &memo->remote_ep);
+    if (res <= 0) {
+        xtimer_remove(&memo->response_timer);
+    }
+    return res;
+}
+
 /*
  * Handler for /.well-known/core. Lists registered handlers, except for
  * /.well-known/core itself.
@@ -691,6 +1114,7 @@ kernel_pid_t gcoap_init(void)
     if (_pid != KERNEL_PID_UNDEF) {
         return -EEXIST;
     }
+    _index_listener(&_default_listener);
     _pid = thread_create(_msg_stack, sizeof(_msg_stack), THREAD_PRIORITY_MAIN - 1,
                             THREAD_CREATE_STACKTEST, _event_loop, NULL, "coap");
 
@@ -700,6 +1124,11 @@ kernel_pid_t gcoap_init(void)
     memset(&_coap_state.observers[0], 0, sizeof(_coap_state.observers));
     memset(&_coap_state.observe_memos[0], 0, sizeof(_coap_state.observe_memos));
     memset(&_coap_state.resend_bufs[0], 0, sizeof(_coap_state.resend_bufs));
+    /* chain all memos into the list of unused memos */
+    for (unsigned i = 0; i < GCOAP_REQ_WAITING_MAX; i++) {
+        _coap_state.open_reqs[i].next_token = _coap_state.free_reqs;
+        _coap_state.free_reqs = &_coap_state.open_reqs[i];
+    }
     /* randomize initial value */
     atomic_init(&_coap_state.next_message_id, (unsigned)random_uint32());
 
@@ -716,6 +1145,8 @@ void gcoap_register_listener(gcoap_listener_t *listener)
 
     listener->next = NULL;
     _last->next = listener;
+
+    _index_listener(listener);
 }
 
 int gcoap_req_init(coap_pkt_t *pdu, uint8_t *buf, size_t len,
@@ -794,107 +1225,106 @@ size_t gcoap_req_send2(const uint8_t *buf, size_t len,
                        gcoap_resp_handler_t resp_handler)
 {
     gcoap_request_memo_t *memo = NULL;
+    gcoap_peer_t *peer = NULL;
     unsigned msg_type  = (*buf & 0x30) >> 4;
-    uint32_t timeout   = 0;
+    bool queue         = false;
+    ssize_t res;
 
     assert(remote != NULL);
 
     /* Only allocate memory if necessary (i.e. if user is interested in the
      * response or request is confirmable) */
-    if ((resp_handler != NULL) || (msg_type == COAP_TYPE_CON)) {
-        mutex_lock(&_coap_state.lock);
-        /* Find empty slot in list of open requests. */
-        for (int i = 0; i < GCOAP_REQ_WAITING_MAX; i++) {
-            if (_coap_state.open_reqs[i].state == GCOAP_MEMO_UNUSED) {
-                memo = &_coap_state.open_reqs[i];
-                memo->state = GCOAP_MEMO_WAIT;
+    if ((resp_handler == NULL) && (msg_type != COAP_TYPE_CON)) {
+        res = sock_udp_send(&_sock, buf, len, remote);
+        if (res <= 0) {
+            DEBUG("gcoap: sock send failed: %d\n", (int)res);
+        }
+        return (size_t)((res > 0) ? res : 0);
+    }
+    if ((msg_type != COAP_TYPE_CON) && (msg_type != COAP_TYPE_NON)) {
+        DEBUG("gcoap: illegal msg type %u\n", msg_type);
+        return 0;
+    }
+
+    mutex_lock(&_coap_state.lock);
+    memo = _coap_state.free_reqs;
+    if (memo) {
+        peer = _get_peer(remote);
+    }
+    if (!peer) {
+        mutex_unlock(&_coap_state.lock);
+        DEBUG("gcoap: dropping request; no space for response tracking\n");
+        return 0;
+    }
+#if GCOAP_NSTART > 0
+    queue = (peer->outstanding >= GCOAP_NSTART);
+#endif
+
+    /* a confirmable request is kept for resending, a queued request for
+     * sending it later */
+    if ((msg_type == COAP_TYPE_CON) || queue) {
+        memo->msg.data.pdu_buf = NULL;
+        for (int i = 0; (i < GCOAP_RESEND_BUFS_MAX) && (len <= GCOAP_PDU_BUF_SIZE); i++) {
+            if (!_coap_state.resend_bufs[i][0]) {
+                memo->msg.data.pdu_buf = &_coap_state.resend_bufs[i][0];
+                memcpy(memo->msg.data.pdu_buf, buf, len);
+                memo->msg.data.pdu_len = len;
                 break;
             }
         }
-        if (!memo) {
+        if (!memo->msg.data.pdu_buf) {
             mutex_unlock(&_coap_state.lock);
-            DEBUG("gcoap: dropping request; no space for response tracking\n");
+            DEBUG("gcoap: no space for PDU in resend bufs\n");
             return 0;
         }
+        memo->send_limit = (msg_type == COAP_TYPE_CON) ? COAP_MAX_RETRANSMIT : 0;
+    }
+    else {
+        memo->send_limit = GCOAP_SEND_LIMIT_NON;
+        memcpy(&memo->msg.hdr_buf[0], buf, GCOAP_HEADER_MAXLEN);
+    }
 
-        memo->resp_handler = resp_handler;
-        memcpy(&memo->remote_ep, remote, sizeof(sock_udp_ep_t));
-
-        switch (msg_type) {
-        case COAP_TYPE_CON:
-            /* copy buf to resend_bufs record */
-            memo->msg.data.pdu_buf = NULL;
-            for (int i = 0; i < GCOAP_RESEND_BUFS_MAX; i++) {
-                if (!_coap_state.resend_bufs[i][0]) {
-                    memo->msg.data.pdu_buf = &_coap_state.resend_bufs[i][0];
-                    memcpy(memo->msg.data.pdu_buf, buf, GCOAP_PDU_BUF_SIZE);
-                    memo->msg.data.pdu_len = len;
-                    break;
-                }
-            }
-            if (memo->msg.data.pdu_buf) {
-                memo->send_limit  = COAP_MAX_RETRANSMIT;
-                timeout           = (uint32_t)COAP_ACK_TIMEOUT * US_PER_SEC;
-                uint32_t variance = (uint32_t)COAP_ACK_VARIANCE * US_PER_SEC;
-                timeout = random_uint32_range(timeout, timeout + variance);
-            }
-            else {
-                memo->state = GCOAP_MEMO_UNUSED;
-                DEBUG("gcoap: no space for PDU in resend bufs\n");
-            }
-            break;
+    _coap_state.free_reqs = memo->next_token;
+    _coap_state.open_reqs_numof++;
+    memo->resp_handler = resp_handler;
+    memo->peer = peer;
+    memo->next_queued = NULL;
+    memcpy(&memo->remote_ep, remote, sizeof(sock_udp_ep_t));
+#ifdef MODULE_GCOAP_COCOA
+    memo->sent = 0;
+#endif
+    _add_req_memo(memo);
 
-        case COAP_TYPE_NON:
-            memo->send_limit = GCOAP_SEND_LIMIT_NON;
-            memcpy(&memo->msg.hdr_buf[0], buf, GCOAP_HEADER_MAXLEN);
-            timeout = GCOAP_NON_TIMEOUT;
-            break;
-        default:
-            memo->state = GCOAP_MEMO_UNUSED;
-            DEBUG("gcoap: illegal msg type %u\n", msg_type);
-            break;
+    if (queue) {
+        memo->state = GCOAP_MEMO_QUEUED;
+        if (peer->queue) {
+            peer->queue_tail->next_queued = memo;
         }
-        mutex_unlock(&_coap_state.lock);
-        if (memo->state == GCOAP_MEMO_UNUSED) {
-            return 0;
+        else {
+            peer->queue = memo;
         }
+        peer->queue_tail = memo;
     }
-
-    /* Memos complete; send msg and start timer */
-    ssize_t res = sock_udp_send(&_sock, buf, len, remote);
-
-    /* timeout may be zero for non-confirmable */
-    if ((memo != NULL) && (res > 0) && (timeout > 0)) {
-        /* We assume gcoap_req_send2() is called on some thread other than
-         * gcoap's. First, put a message in the mbox for the sock udp object,
-         * which will interrupt listening on the gcoap thread. (When there are
-         * no outstanding requests, gcoap blocks indefinitely in _listen() at
-         * sock_udp_recv().) While the message sent here is outstanding, the
-         * sock_udp_recv() call will be set to a short timeout so the request
-         * timer below, also on the gcoap thread, is processed in a timely
-         * manner. */
-        msg_t mbox_msg;
-        mbox_msg.type          = GCOAP_MSG_TYPE_INTR;
-        mbox_msg.content.value = 0;
-        if (mbox_try_put(&_sock.reg.mbox, &mbox_msg)) {
-            /* start response wait timer on the gcoap thread */
-            memo->timeout_msg.type        = GCOAP_MSG_TYPE_TIMEOUT;
-            memo->timeout_msg.content.ptr = (char *)memo;
-            xtimer_set_msg(&memo->response_timer, timeout, &memo->timeout_msg, _pid);
-        }
-        else {
-            res = 0;
-            DEBUG("gcoap: can't wake up mbox; no timeout for msg\n");
+    else {
+        memo->state = GCOAP_MEMO_WAIT;
+        peer->outstanding++;
+#ifdef MODULE_GCOAP_COCOA
+        if (msg_type == COAP_TYPE_CON) {
+            _cocoa_start(memo);
         }
+#endif
+    }
+    mutex_unlock(&_coap_state.lock);
+
+    if (queue) {
+        /* sent when a request to the endpoint completes */
+        return len;
     }
+
+    res = _send_req(memo, buf, len);
     if (res <= 0) {
-        if (memo != NULL) {
-            if (msg_type == COAP_TYPE_CON) {
-                *memo->msg.data.pdu_buf = 0;    /* clear resend buffer */
-            }
-            memo->state = GCOAP_MEMO_UNUSED;
-        }
         DEBUG("gcoap: sock send failed: %d\n", (int)res);
+        _finish_memo(memo);
     }
     return (size_t)((res > 0) ? res : 0);
 }
@@ -969,13 +1399,9 @@ size_t gcoap_obs_send(const uint8_t *buf, size_t len,
 
 uint8_t gcoap_op_state(void)
 {
-    uint8_t count = 0;
-    for (int i = 0; i < GCOAP_REQ_WAITING_MAX; i++) {
-        if (_coap_state.open_reqs[i].state != GCOAP_MEMO_UNUSED) {
-            count++;
-        }
-    }
-    return count;
+    unsigned count = _coap_state.open_reqs_numof;
+
+    return (count > UINT8_MAX) ? UINT8_MAX : count;
 }
 
 int gcoap_get_resource_list(void *buf, size_t maxlen, uint8_t cf)
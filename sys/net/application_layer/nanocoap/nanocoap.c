@@ -26,6 +26,9 @@
 #include <string.h>
 
 #include "net/nanocoap.h"
+#ifdef MODULE_NANOCOAP_OPTINDEX
+#include "bitarithm.h"
+#endif
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
@@ -80,6 +83,10 @@ int coap_parse(coap_pkt_t *pkt, uint8_t *buf, size_t len)
     coap_optpos_t *optpos = pkt->options;
     unsigned option_count = 0;
     unsigned option_nr = 0;
+#ifdef MODULE_NANOCOAP_OPTINDEX
+    pkt->options_map[0] = 0;
+    pkt->options_map[1] = 0;
+#endif
 
     /* parse options */
     while (pkt_pos != pkt_end) {
@@ -106,12 +113,29 @@ int coap_parse(coap_pkt_t *pkt, uint8_t *buf, size_t len)
             DEBUG("option count=%u nr=%u len=%i\n", option_count, option_nr, option_len);
 
             if (option_delta) {
+                if (option_count == NANOCOAP_NOPTS_MAX) {
+                    DEBUG("nanocoap: too many options\n");
+                    return -ENOMEM;
+                }
                 optpos->opt_num = option_nr;
                 optpos->offset = (uintptr_t)option_start - (uintptr_t)hdr;
                 DEBUG("optpos option_nr=%u %u\n", (unsigned)option_nr, (unsigned)optpos->offset);
+#ifdef MODULE_NANOCOAP_OPTINDEX
+                optpos->last = optpos->offset;
+                optpos->value = (uintptr_t)pkt_pos - (uintptr_t)hdr;
+                optpos->len = option_len;
+                if (option_nr < 64) {
+                    pkt->options_map[option_nr >> 5] |= 1UL << (option_nr & 0x1f);
+                }
+#endif
                 optpos++;
                 option_count++;
             }
+#ifdef MODULE_NANOCOAP_OPTINDEX
+            else if (option_count) {
+                optpos[-1].last = (uintptr_t)option_start - (uintptr_t)hdr;
+            }
+#endif
 
             pkt_pos += option_len;
 
@@ -144,19 +168,56 @@ int coap_parse(coap_pkt_t *pkt, uint8_t *buf, size_t len)
     return 0;
 }
 
-uint8_t *coap_find_option(const coap_pkt_t *pkt, unsigned opt_num)
+#ifdef MODULE_NANOCOAP_OPTINDEX
+/* The options array is ordered by option number, so the number of options
+ * below opt_num is the position of opt_num in it. For options below 64 it is
+ * counted in the bitmap of the option numbers. */
+static const coap_optpos_t *_find_optpos(const coap_pkt_t *pkt, unsigned opt_num)
+{
+    unsigned pos = bitarithm_bits_set_u32(pkt->options_map[0]);
+
+    if (opt_num < 64) {
+        uint32_t map = pkt->options_map[opt_num >> 5];
+        uint32_t bit = 1UL << (opt_num & 0x1f);
+
+        if (!(map & bit)) {
+            return NULL;
+        }
+        return &pkt->options[((opt_num < 32) ? 0 : pos) +
+                             bitarithm_bits_set_u32(map & (bit - 1))];
+    }
+
+    /* skip all options below 64 */
+    pos += bitarithm_bits_set_u32(pkt->options_map[1]);
+    for (; pos < pkt->options_len; pos++) {
+        if (pkt->options[pos].opt_num == opt_num) {
+            return &pkt->options[pos];
+        }
+    }
+    return NULL;
+}
+#else
+static const coap_optpos_t *_find_optpos(const coap_pkt_t *pkt, unsigned opt_num)
 {
     const coap_optpos_t *optpos = pkt->options;
     unsigned opt_count = pkt->options_len;
 
     while (opt_count--) {
         if (optpos->opt_num == opt_num) {
-            return (uint8_t*)pkt->hdr + optpos->offset;
+            return optpos;
         }
         optpos++;
     }
     return NULL;
 }
+#endif
+
+uint8_t *coap_find_option(const coap_pkt_t *pkt, unsigned opt_num)
+{
+    const coap_optpos_t *optpos = _find_optpos(pkt, opt_num);
+
+    return (optpos) ? (uint8_t *)pkt->hdr + optpos->offset : NULL;
+}
 
 static uint8_t *_parse_option(const coap_pkt_t *pkt,
                               uint8_t *pkt_pos, uint16_t *delta, int *opt_len)
@@ -175,29 +236,56 @@ static uint8_t *_parse_option(const coap_pkt_t *pkt,
     return pkt_pos;
 }
 
-int coap_get_option_uint(coap_pkt_t *pkt, unsigned opt_num, uint32_t *target)
+/* returns the value of the first occurrence of an option */
+static uint8_t *_opt_value(const coap_pkt_t *pkt, const coap_optpos_t *optpos,
+                           int *opt_len)
 {
-    assert(target);
+#ifdef MODULE_NANOCOAP_OPTINDEX
+    *opt_len = optpos->len;
+    return (uint8_t *)pkt->hdr + optpos->value;
+#else
+    uint16_t delta;
 
-    uint8_t *opt_pos = coap_find_option(pkt, opt_num);
-    if (opt_pos) {
-        uint16_t delta;
-        int option_len = 0;
-        uint8_t *pkt_pos = _parse_option(pkt, opt_pos, &delta, &option_len);
-        if (option_len >= 0) {
-            if (option_len > 4) {
-                DEBUG("nanocoap: uint option with len > 4 (unsupported).\n");
-                return -ENOSPC;
-            }
-            *target = _decode_uint(pkt_pos, option_len);
-            return 0;
-        }
-        else {
-            DEBUG("nanocoap: discarding packet with invalid option length.\n");
-            return -EBADMSG;
-        }
+    return _parse_option(pkt, (uint8_t *)pkt->hdr + optpos->offset, &delta, opt_len);
+#endif
+}
+
+ssize_t coap_opt_get_opaque(const coap_pkt_t *pkt, uint16_t optnum,
+                            uint8_t **value)
+{
+    const coap_optpos_t *optpos = _find_optpos(pkt, optnum);
+    int opt_len;
+
+    if (!optpos) {
+        return -ENOENT;
     }
-    return -1;
+    *value = _opt_value(pkt, optpos, &opt_len);
+    return opt_len;
+}
+
+int coap_opt_get_uint(const coap_pkt_t *pkt, uint16_t optnum, uint32_t *value)
+{
+    assert(value);
+
+    uint8_t *opt_val;
+    ssize_t opt_len = coap_opt_get_opaque(pkt, optnum, &opt_val);
+
+    if (opt_len < 0) {
+        return opt_len;
+    }
+    if (opt_len > 4) {
+        DEBUG("nanocoap: uint option with len > 4 (unsupported).\n");
+        return -ENOSPC;
+    }
+    *value = _decode_uint(opt_val, opt_len);
+    return 0;
+}
+
+int coap_get_option_uint(coap_pkt_t *pkt, unsigned opt_num, uint32_t *target)
+{
+    int res = coap_opt_get_uint(pkt, opt_num, target);
+
+    return (res == -ENOENT) ? -1 : res;
 }
 
 uint8_t *coap_iterate_option(const coap_pkt_t *pkt, uint8_t **optpos,
@@ -219,21 +307,17 @@ uint8_t *coap_iterate_option(const coap_pkt_t *pkt, uint8_t **optpos,
 
 unsigned coap_get_content_type(coap_pkt_t *pkt)
 {
-    uint8_t *opt_pos = coap_find_option(pkt, COAP_OPT_CONTENT_FORMAT);
+    uint8_t *opt_val;
+    ssize_t opt_len = coap_opt_get_opaque(pkt, COAP_OPT_CONTENT_FORMAT, &opt_val);
     unsigned content_type = COAP_FORMAT_NONE;
-    if (opt_pos) {
-        uint16_t delta;
-        int option_len = 0;
-        uint8_t *pkt_pos = _parse_option(pkt, opt_pos, &delta, &option_len);
-
-        if (option_len == 0) {
-            content_type = 0;
-        } else if (option_len == 1) {
-            content_type = *pkt_pos;
-        } else if (option_len == 2) {
-            memcpy(&content_type, pkt_pos, 2);
-            content_type = ntohs(content_type);
-        }
+
+    if (opt_len == 0) {
+        content_type = 0;
+    } else if (opt_len == 1) {
+        content_type = *opt_val;
+    } else if (opt_len == 2) {
+        memcpy(&content_type, opt_val, 2);
+        content_type = ntohs(content_type);
     }
 
     return content_type;
@@ -244,29 +328,34 @@ ssize_t coap_opt_get_string(const coap_pkt_t *pkt, uint16_t optnum,
 {
     assert(pkt && target && (max_len > 1));
 
-    uint8_t *opt_pos = coap_find_option(pkt, optnum);
-    if (!opt_pos) {
+    const coap_optpos_t *optpos = _find_optpos(pkt, optnum);
+    if (!optpos) {
         *target++ = (uint8_t)separator;
         *target = '\0';
         return 2;
     }
 
     unsigned left = max_len - 1;
-    uint8_t *part_start = NULL;
-    do {
-        int opt_len;
-        part_start = coap_iterate_option(pkt, &opt_pos, &opt_len,
-                                         (part_start == NULL));
-        if (part_start) {
-            if (left < (unsigned)(opt_len + 1)) {
-                return -ENOSPC;
-            }
-            *target++ = (uint8_t)separator;
-            memcpy(target, part_start, opt_len);
-            target += opt_len;
-            left -= (opt_len + 1);
+    int opt_len;
+    uint8_t *part_start = _opt_value(pkt, optpos, &opt_len);
+    uint8_t *opt_pos = part_start + opt_len;
+    while (part_start) {
+        if (left < (unsigned)(opt_len + 1)) {
+            return -ENOSPC;
+        }
+        *target++ = (uint8_t)separator;
+        memcpy(target, part_start, opt_len);
+        target += opt_len;
+        left -= (opt_len + 1);
+
+#ifdef MODULE_NANOCOAP_OPTINDEX
+        /* the position of the last part is known */
+        if (opt_pos > (uint8_t *)pkt->hdr + optpos->last) {
+            break;
         }
-    } while(opt_pos);
+#endif
+        part_start = coap_iterate_option(pkt, &opt_pos, &opt_len, 0);
+    }
 
     *target = '\0';
 
@@ -275,20 +364,17 @@ ssize_t coap_opt_get_string(const coap_pkt_t *pkt, uint16_t optnum,
 
 int coap_get_blockopt(coap_pkt_t *pkt, uint16_t option, uint32_t *blknum, unsigned *szx)
 {
-    uint8_t *optpos = coap_find_option(pkt, option);
-    if (!optpos) {
+    uint8_t *data_start;
+    ssize_t option_len = coap_opt_get_opaque(pkt, option, &data_start);
+    if (option_len < 0) {
         *blknum = 0;
         *szx = 0;
         return -1;
     }
 
-    int option_len;
-    uint16_t delta;
-
-    uint8_t *data_start = _parse_option(pkt, optpos, &delta, &option_len);
     uint32_t blkopt = _decode_uint(data_start, option_len);
 
-    DEBUG("nanocoap: blkopt len: %i\n", option_len);
+    DEBUG("nanocoap: blkopt len: %i\n", (int)option_len);
     DEBUG("nanocoap: blkopt: 0x%08x\n", (unsigned)blkopt);
     *blknum = blkopt >> COAP_BLOCKWISE_NUM_OFF;
     *szx = blkopt & COAP_BLOCKWISE_SZX_MASK;
@@ -319,25 +405,142 @@ ssize_t coap_handle_req(coap_pkt_t *pkt, uint8_t *resp_buf, unsigned resp_buf_le
 #endif
     DEBUG("nanocoap: URI path: \"%s\"\n", uri);
 
-    for (unsigned i = 0; i < coap_resources_numof; i++) {
-        const coap_resource_t *resource = &coap_resources[i];
-        if (!(resource->methods & method_flag)) {
-            continue;
+    static coap_resource_index_entry_t _entries[NANOCOAP_RESOURCE_INDEX_SIZE];
+    static coap_resource_index_t _index;
+    const coap_resource_t *resource = NULL;
+
+    /* build index on first request */
+    if (_index.entries == NULL) {
+        coap_resource_index_init(&_index, _entries, NANOCOAP_RESOURCE_INDEX_SIZE);
+        for (unsigned i = 0; i < coap_resources_numof; i++) {
+            if (coap_resource_index_add(&_index, &coap_resources[i]) < 0) {
+                DEBUG("nanocoap: resource index full, searching linearly\n");
+                break;
+            }
         }
+    }
 
-        int res = strcmp((char *)uri, resource->path);
-        if (res > 0) {
-            continue;
+    if (!_index.overflow) {
+        coap_resource_index_find(&_index, (char *)uri, method_flag, &resource);
+    }
+    else {
+        int best = -1;
+
+        for (unsigned i = 0; i < coap_resources_numof; i++) {
+            if (coap_resources[i].methods & method_flag) {
+                int res = coap_match_path(&coap_resources[i], (char *)uri);
+                if (res > best) {
+                    best = res;
+                    resource = &coap_resources[i];
+                }
+            }
         }
-        else if (res < 0) {
-            break;
+    }
+
+    if (resource) {
+        return resource->handler(pkt, resp_buf, resp_buf_len, resource->context);
+    }
+
+    return coap_build_reply(pkt, COAP_CODE_404, resp_buf, resp_buf_len, 0);
+}
+
+/* FNV-1a over the first len characters of path */
+static uint32_t _path_hash(const char *path, size_t len)
+{
+    uint32_t hash = 2166136261U;
+
+    for (size_t i = 0; i < len; i++) {
+        hash = (hash ^ (uint8_t)path[i]) * 16777619U;
+    }
+    return hash;
+}
+
+void coap_resource_index_init(coap_resource_index_t *index,
+                              coap_resource_index_entry_t *entries, unsigned size)
+{
+    assert((size & (size - 1)) == 0);
+
+    memset(entries, 0, size * sizeof(*entries));
+    index->entries = entries;
+    index->size = size;
+    index->numof = 0;
+    index->overflow = false;
+}
+
+int coap_resource_index_add(coap_resource_index_t *index,
+                            const coap_resource_t *resource)
+{
+    /* keep one entry free, so every probe sequence ends */
+    if (index->numof + 1 >= index->size) {
+        index->overflow = true;
+        return -ENOMEM;
+    }
+
+    uint32_t hash = _path_hash(resource->path, strlen(resource->path));
+    unsigned i = hash & (index->size - 1);
+    while (index->entries[i].resource) {
+        i = (i + 1) & (index->size - 1);
+    }
+    index->entries[i].hash = hash;
+    index->entries[i].resource = resource;
+    index->numof++;
+    return 0;
+}
+
+int coap_resource_index_find(const coap_resource_index_t *index, const char *path,
+                             unsigned method_flag, const coap_resource_t **resource)
+{
+    int ret = -ENOENT;
+    size_t len = strlen(path);
+    bool exact = true;
+
+    /* try the full path, then its parents from the longest to "/" */
+    while (len > 0) {
+        uint32_t hash = _path_hash(path, len);
+
+        for (unsigned i = hash & (index->size - 1); index->entries[i].resource;
+             i = (i + 1) & (index->size - 1)) {
+            const coap_resource_t *entry = index->entries[i].resource;
+
+            if ((index->entries[i].hash != hash) ||
+                (!exact && !(entry->methods & COAP_MATCH_SUBTREE)) ||
+                (strncmp(entry->path, path, len) != 0) || (entry->path[len] != '\0')) {
+                continue;
+            }
+            if (entry->methods & method_flag) {
+                *resource = entry;
+                return 0;
+            }
+            ret = -ENOTSUP;
         }
-        else {
-            return resource->handler(pkt, resp_buf, resp_buf_len, resource->context);
+
+        if (len == 1) {
+            break;
         }
+        do {
+            len--;
+        } while ((len > 1) && (path[len] != '/'));
+        exact = false;
     }
+    return ret;
+}
 
-    return coap_build_reply(pkt, COAP_CODE_404, resp_buf, resp_buf_len, 0);
+int coap_match_path(const coap_resource_t *resource, const char *path)
+{
+    size_t len = strlen(resource->path);
+
+    if (strncmp(resource->path, path, len) != 0) {
+        return -1;
+    }
+    if (path[len] == '\0') {
+        return len;
+    }
+    /* a parent path ends right before a '/', except for the root path */
+    if ((resource->methods & COAP_MATCH_SUBTREE) &&
+        ((path[len] == '/') || (len == 1))) {
+        return len;
+    }
+    return -1;
 }
 
 ssize_t coap_reply_simple(coap_pkt_t *pkt,
@@ -689,9 +892,30 @@ static ssize_t _add_opt_pkt(coap_pkt_t *pkt, uint16_t optnum, uint8_t *val,
     size_t optlen = coap_put_option(pkt->payload, lastonum, optnum, val, val_len);
     assert(pkt->payload_len > optlen);
 
+#ifdef MODULE_NANOCOAP_OPTINDEX
+    uint16_t offset = pkt->payload - (uint8_t *)pkt->hdr;
+
+    /* a repeated option only moves the last occurrence of its entry */
+    if (pkt->options_len && (optnum == lastonum)) {
+        pkt->options[pkt->options_len - 1].last = offset;
+    }
+    else {
+        coap_optpos_t *optpos = &pkt->options[pkt->options_len++];
+
+        optpos->opt_num = optnum;
+        optpos->offset = offset;
+        optpos->last = offset;
+        optpos->value = offset + optlen - val_len;
+        optpos->len = val_len;
+        if (optnum < 64) {
+            pkt->options_map[optnum >> 5] |= 1UL << (optnum & 0x1f);
+        }
+    }
+#else
     pkt->options[pkt->options_len].opt_num = optnum;
     pkt->options[pkt->options_len].offset = pkt->payload - (uint8_t *)pkt->hdr;
     pkt->options_len++;
+#endif
     pkt->payload += optlen;
     pkt->payload_len -= optlen;
 
@@ -14,12 +14,91 @@
 
 #include <inttypes.h>
 #include <stdio.h>
+#include <string.h>
+#include "byteorder.h"
 #include "od.h"
 #include "net/inet_csum.h"
 
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
+/* The 1's complement sum does not depend on the byte order the words are
+ * added in (RFC 1071, section 2B), so _sum_words() adds in host byte order
+ * and the result is swapped once. @p len is even and at most UINT16_MAX, so
+ * neither the 32-bit vector lanes nor the 64-bit accumulator can overflow. */
+static uint64_t _sum_words(const uint8_t *buf, size_t len)
+{
+    uint64_t sum = 0;
+
+#if defined(__AVX2__)
+    if (len >= 32) {
+        const __m256i zero = _mm256_setzero_si256();
+        __m256i acc = zero;
+
+        for (; len >= 32; buf += 32, len -= 32) {
+            __m256i v = _mm256_loadu_si256((const __m256i *)buf);
+            acc = _mm256_add_epi32(acc, _mm256_unpacklo_epi16(v, zero));
+            acc = _mm256_add_epi32(acc, _mm256_unpackhi_epi16(v, zero));
+        }
+        uint32_t lanes[8];
+        _mm256_storeu_si256((__m256i *)lanes, acc);
+        for (unsigned i = 0; i < 8; i++) {
+            sum += lanes[i];
+        }
+    }
+#elif defined(__SSE2__)
+    if (len >= 16) {
+        const __m128i zero = _mm_setzero_si128();
+        __m128i acc = zero;
+
+        for (; len >= 16; buf += 16, len -= 16) {
+            __m128i v = _mm_loadu_si128((const __m128i *)buf);
+            acc = _mm_add_epi32(acc, _mm_unpacklo_epi16(v, zero));
+            acc = _mm_add_epi32(acc, _mm_unpackhi_epi16(v, zero));
+        }
+        uint32_t lanes[4];
+        _mm_storeu_si128((__m128i *)lanes, acc);
+        for (unsigned i = 0; i < 4; i++) {
+            sum += lanes[i];
+        }
+    }
+#endif
+
+    /* memcpy() compiles to a single (unaligned) load on x86 and ARMv7-M,
+     * the 64-bit additions to add-with-carry pairs on 32-bit CPUs */
+    for (; len >= 8; buf += 8, len -= 8) {
+        uint32_t w[2];
+        memcpy(w, buf, sizeof(w));
+        sum += w[0];
+        sum += w[1];
+    }
+    if (len >= 4) {
+        uint32_t w;
+        memcpy(&w, buf, sizeof(w));
+        sum += w;
+        buf += 4;
+        len -= 4;
+    }
+    if (len >= 2) {
+        uint16_t w;
+        memcpy(&w, buf, sizeof(w));
+        sum += w;
+    }
+    return sum;
+}
+
+static inline uint32_t _fold(uint64_t sum)
+{
+    while (sum >> 16) {
+        sum = (sum & 0xffff) + (sum >> 16);
+    }
+    return (uint32_t)sum;
+}
+
 uint16_t inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len, size_t accum_len)
 {
     uint32_t csum = sum;
@@ -44,10 +123,9 @@ uint16_t inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len, size_t
         accum_len++;
     }
 
-    for (unsigned i = 0; i < (len >> 1); buf += 2, i++) {
-        csum += (uint16_t)(*buf << 8) + *(buf + 1); /* group bytes by 16-byte words */
-                                                    /* and add them */
-    }
+    /* group bytes by 16-bit words and add them */
+    csum += ntohs((uint16_t)_fold(_sum_words(buf, len & ~1U)));
+    buf += len & ~1U;
 
     if ((accum_len + len) & 1)          /* if accumulated length is odd */
         csum += (uint16_t)(*buf << 8);  /* add last byte as top half of 16-byte word */
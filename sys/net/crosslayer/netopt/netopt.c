@@ -92,6 +92,9 @@ static const char *_netopt_strmap[] = {
     [NETOPT_BLE_CTX]               = "NETOPT_BLE_CTX",
     [NETOPT_CHECKSUM]              = "NETOPT_CHECKSUM",
     [NETOPT_PHY_BUSY]              = "NETOPT_PHY_BUSY",
+    [NETOPT_RX_PENDING]            = "NETOPT_RX_PENDING",
+    [NETOPT_TX_CSUM_OFFLOAD]       = "NETOPT_TX_CSUM_OFFLOAD",
+    [NETOPT_RX_CSUM_OFFLOAD]       = "NETOPT_RX_CSUM_OFFLOAD",
     [NETOPT_NUMOF]                 = "NETOPT_NUMOF",
 };
 
@@ -1216,6 +1216,25 @@ static void _update_l2addr_from_dev(gnrc_netif_t *netif)
     }
 }
 
+static bool _enabled(netdev_t *dev, netopt_t opt)
+{
+    netopt_enable_t enabled;
+
+    return (dev->driver->get(dev, opt, &enabled,
+                             sizeof(enabled)) == sizeof(enabled)) &&
+           (enabled == NETOPT_ENABLE);
+}
+
+static void _init_csum_offload(gnrc_netif_t *netif)
+{
+    if (_enabled(netif->dev, NETOPT_TX_CSUM_OFFLOAD)) {
+        netif->flags |= GNRC_NETIF_FLAGS_TX_CSUM_OFFLOAD;
+    }
+    if (_enabled(netif->dev, NETOPT_RX_CSUM_OFFLOAD)) {
+        netif->flags |= GNRC_NETIF_FLAGS_RX_CSUM_OFFLOAD;
+    }
+}
+
 static void _init_from_device(gnrc_netif_t *netif)
 {
     int res;
@@ -1274,6 +1293,7 @@ static void _init_from_device(gnrc_netif_t *netif)
             break;
     }
     _update_l2addr_from_dev(netif);
+    _init_csum_offload(netif);
 }
 
 static void _configure_netdev(netdev_t *dev)
@@ -1292,6 +1312,110 @@ static void _configure_netdev(netdev_t *dev)
 #endif
 }
 
+#ifdef MODULE_GNRC_NETIF_TXQ
+static netstats_t *_txq_stats(gnrc_netif_t *netif)
+{
+#ifdef MODULE_NETSTATS_L2
+    return &netif->dev->stats;
+#else
+    (void)netif;
+    return NULL;
+#endif
+}
+
+static unsigned _txq_prio(gnrc_pktsnip_t *pkt)
+{
+#ifdef MODULE_GNRC_ICMPV6
+    for (; pkt != NULL; pkt = pkt->next) {
+        if (pkt->type == GNRC_NETTYPE_ICMPV6) {
+            return GNRC_NETIF_TXQ_PRIO_CONTROL;
+        }
+    }
+#else
+    (void)pkt;
+#endif
+    return GNRC_NETIF_TXQ_PRIO_DATA;
+}
+
+static void _txq_push(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
+{
+    gnrc_priority_pktqueue_node_t *node = NULL;
+    netstats_t *stats = _txq_stats(netif);
+    unsigned prio = _txq_prio(pkt);
+
+    for (unsigned i = 0; i < GNRC_NETIF_TXQ_SIZE; i++) {
+        if (netif->txq_nodes[i].pkt == NULL) {
+            node = &netif->txq_nodes[i];
+            break;
+        }
+    }
+    if (node == NULL) {
+        /* queue is full: drop the last packet if it is of a lower priority
+         * class, else the new one */
+        priority_queue_node_t *tail = netif->txq.first;
+
+        while (tail->next != NULL) {
+            tail = tail->next;
+        }
+        node = (gnrc_priority_pktqueue_node_t *)tail;
+        if (node->priority <= prio) {
+            node = NULL;
+        }
+        else {
+            priority_queue_remove(&netif->txq, tail);
+            DEBUG("gnrc_netif: transmit queue full, dropping %p\n",
+                  (void *)node->pkt);
+            gnrc_pktbuf_release_error(node->pkt, ENOBUFS);
+        }
+        if (stats) {
+            stats->tx_queue_drops++;
+        }
+        if (node == NULL) {
+            DEBUG("gnrc_netif: transmit queue full, dropping %p\n", (void *)pkt);
+            gnrc_pktbuf_release_error(pkt, ENOBUFS);
+            return;
+        }
+    }
+    else {
+        netif->txq_len++;
+        if (stats && (netif->txq_len > stats->tx_queue_max)) {
+            stats->tx_queue_max = netif->txq_len;
+        }
+    }
+    gnrc_priority_pktqueue_node_init(node, prio, pkt);
+    gnrc_priority_pktqueue_push(&netif->txq, node);
+}
+
+/* sends the head of the transmit queue, returns false if there is nothing
+ * to send right now */
+static bool _txq_send(gnrc_netif_t *netif)
+{
+    gnrc_pktsnip_t *pkt = gnrc_priority_pktqueue_head(&netif->txq);
+    int res;
+
+    if (pkt == NULL) {
+        return false;
+    }
+    /* keep the packet for a retry, send() releases it */
+    gnrc_pktbuf_hold(pkt, 1);
+    res = netif->ops->send(netif, pkt);
+    if (res == -EBUSY) {
+        /* retried with the next message, at the latest the one of the timer */
+        DEBUG("gnrc_netif: device busy, retrying %p later\n", (void *)pkt);
+        xtimer_set_msg(&netif->txq_timer, GNRC_NETIF_TXQ_RETRY,
+                       &netif->txq_msg, netif->pid);
+        return false;
+    }
+    if (res < 0) {
+        DEBUG("gnrc_netif: error sending packet %p (code: %u)\n",
+              (void *)pkt, res);
+    }
+    gnrc_pktbuf_release(gnrc_priority_pktqueue_pop(&netif->txq));
+    netif->txq_len--;
+    return true;
+}
+#endif
+
 static void *_gnrc_netif_thread(void *args)
 {
     gnrc_netapi_opt_t *opt;
@@ -1332,26 +1456,48 @@ static void *_gnrc_netif_thread(void *args)
     if (netif->ops->init) {
         netif->ops->init(netif);
     }
+#ifdef MODULE_GNRC_NETIF_TXQ
+    gnrc_priority_pktqueue_init(&netif->txq);
+    netif->txq_msg.type = GNRC_NETIF_MSG_TYPE_TXQ;
+#endif
     /* now let rest of GNRC use the interface */
     gnrc_netif_release(netif);
 
     while (1) {
+#ifdef MODULE_GNRC_NETIF_TXQ
+        /* send queued packets while no other message waits, so packets
+         * sent meanwhile are queued by their priority */
+        while (!msg_avail() && _txq_send(netif)) {}
+#endif
         DEBUG("gnrc_netif: waiting for incoming messages\n");
         msg_receive(&msg);
         /* dispatch netdev, MAC and gnrc_netapi messages */
         switch (msg.type) {
             case NETDEV_MSG_TYPE_EVENT:
                 DEBUG("gnrc_netif: GNRC_NETDEV_MSG_TYPE_EVENT received\n");
+#ifdef MODULE_GNRC_NETIF_RX_BATCH
+                /* an interrupt from now on needs another event */
+                netif->isr_pending = 0;
+#endif
                 dev->driver->isr(dev);
                 break;
             case GNRC_NETAPI_MSG_TYPE_SND:
                 DEBUG("gnrc_netif: GNRC_NETDEV_MSG_TYPE_SND received\n");
+#ifdef MODULE_GNRC_NETIF_TXQ
+                _txq_push(netif, msg.content.ptr);
+#else
                 res = netif->ops->send(netif, msg.content.ptr);
                 if (res < 0) {
                     DEBUG("gnrc_netif: error sending packet %p (code: %u)\n",
                           msg.content.ptr, res);
                 }
+#endif
+                break;
+#ifdef MODULE_GNRC_NETIF_TXQ
+            case GNRC_NETIF_MSG_TYPE_TXQ:
+                DEBUG("gnrc_netif: retry sending queued packets\n");
                 break;
+#endif
             case GNRC_NETAPI_MSG_TYPE_SET:
                 opt = msg.content.ptr;
 #ifdef MODULE_NETOPT
@@ -1399,8 +1545,15 @@ static void *_gnrc_netif_thread(void *args)
     return NULL;
 }
 
-static void _pass_on_packet(gnrc_pktsnip_t *pkt)
+static void _pass_on_packet(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
 {
+    if (netif->flags & GNRC_NETIF_FLAGS_RX_CSUM_OFFLOAD) {
+        gnrc_pktsnip_t *hdr = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_NETIF);
+
+        if (hdr != NULL) {
+            ((gnrc_netif_hdr_t *)hdr->data)->flags |= GNRC_NETIF_HDR_FLAGS_CSUM_VALID;
+        }
+    }
     /* throw away packet if no one is interested */
     if (!gnrc_netapi_dispatch_receive(pkt->type, GNRC_NETREG_DEMUX_CTX_ALL, pkt)) {
         DEBUG("gnrc_netif: unable to forward packet of type %i\n", pkt->type);
@@ -1409,6 +1562,30 @@ static void _pass_on_packet(gnrc_pktsnip_t *pkt)
     }
 }
 
+#ifdef MODULE_GNRC_NETIF_RX_BATCH
+static void _recv_batch(gnrc_netif_t *netif)
+{
+    gnrc_pktsnip_t *pkts[GNRC_NETIF_RX_BATCH_MAX];
+    unsigned numof = 0;
+
+    /* read all pending frames first, so the device is free to receive
+     * further frames while they are dispatched */
+    for (unsigned i = 0; i < GNRC_NETIF_RX_BATCH_MAX; i++) {
+        if ((i > 0) && !_enabled(netif->dev, NETOPT_RX_PENDING)) {
+            break;
+        }
+        pkts[numof] = netif->ops->recv(netif);
+        if (pkts[numof]) {
+            numof++;
+        }
+    }
+    DEBUG("gnrc_netif: received %u frames\n", numof);
+    for (unsigned i = 0; i < numof; i++) {
+        _pass_on_packet(netif, pkts[i]);
+    }
+}
+#endif
+
 static void _event_cb(netdev_t *dev, netdev_event_t event)
 {
     gnrc_netif_t *netif = (gnrc_netif_t *) dev->context;
@@ -1417,19 +1594,33 @@ static void _event_cb(netdev_t *dev, netdev_event_t event)
         msg_t msg = { .type = NETDEV_MSG_TYPE_EVENT,
                       .content = { .ptr = netif } };
 
+#ifdef MODULE_GNRC_NETIF_RX_BATCH
+        /* the queued event also handles this interrupt */
+        if (netif->isr_pending) {
+            return;
+        }
+        netif->isr_pending = 1;
+#endif
         if (msg_send(&msg, netif->pid) <= 0) {
             puts("gnrc_netif: possibly lost interrupt.");
+#ifdef MODULE_GNRC_NETIF_RX_BATCH
+            netif->isr_pending = 0;
+#endif
         }
     }
     else {
         DEBUG("gnrc_netif: event triggered -> %i\n", event);
         switch (event) {
             case NETDEV_EVENT_RX_COMPLETE: {
+#ifdef MODULE_GNRC_NETIF_RX_BATCH
+                    _recv_batch(netif);
+#else
                     gnrc_pktsnip_t *pkt = netif->ops->recv(netif);
 
                     if (pkt) {
-                        _pass_on_packet(pkt);
+                        _pass_on_packet(netif, pkt);
                     }
+#endif
                 }
                 break;
 #ifdef MODULE_NETSTATS_L2
@@ -13,6 +13,7 @@
  */
 
 #include <errno.h>
+#include <stdbool.h>
 #include <string.h>
 
 #include "assert.h"
@@ -28,13 +29,51 @@
 
 #define _INVALID_TYPE(type) (((type) < GNRC_NETTYPE_UNDEF) || ((type) >= GNRC_NETTYPE_NUMOF))
 
+#ifdef MODULE_GNRC_NETREG_HASH
+#if (GNRC_NETREG_HASH_BUCKETS & (GNRC_NETREG_HASH_BUCKETS - 1)) != 0
+#error "GNRC_NETREG_HASH_BUCKETS must be a power of 2"
+#endif
+
+#define _NETREG_NUMOF       (GNRC_NETREG_HASH_BUCKETS)
+#define _LIST(type, ctx)    (netreg[_hash(type, ctx)])
+
+/* The registry as hash table by gnrc_nettype_t and demux context. Entries of
+ * the same type and demux context always share a bucket, so their order of
+ * registration is kept within the bucket */
+static gnrc_netreg_entry_t *netreg[_NETREG_NUMOF];
+
+static inline unsigned _hash(gnrc_nettype_t type, uint32_t demux_ctx)
+{
+    /* Knuth's multiplicative hash, taking the well-mixed upper bits */
+    uint32_t key = (demux_ctx ^ ((uint32_t)type << 24)) * 2654435761U;
+
+    return (key >> 16) & (GNRC_NETREG_HASH_BUCKETS - 1);
+}
+
+static inline bool _matches(const gnrc_netreg_entry_t *entry,
+                            gnrc_nettype_t type, uint32_t demux_ctx)
+{
+    return (entry->nettype == type) && (entry->demux_ctx == demux_ctx);
+}
+#else
+#define _NETREG_NUMOF       (GNRC_NETTYPE_NUMOF)
+#define _LIST(type, ctx)    (netreg[type])
+
 /* The registry as lookup table by gnrc_nettype_t */
-static gnrc_netreg_entry_t *netreg[GNRC_NETTYPE_NUMOF];
+static gnrc_netreg_entry_t *netreg[_NETREG_NUMOF];
+
+static inline bool _matches(const gnrc_netreg_entry_t *entry,
+                            gnrc_nettype_t type, uint32_t demux_ctx)
+{
+    (void)type;
+    return (entry->demux_ctx == demux_ctx);
+}
+#endif
 
 void gnrc_netreg_init(void)
 {
     /* set all pointers in registry to NULL */
-    memset(netreg, 0, GNRC_NETTYPE_NUMOF * sizeof(gnrc_netreg_entry_t *));
+    memset(netreg, 0, _NETREG_NUMOF * sizeof(gnrc_netreg_entry_t *));
 }
 
 int gnrc_netreg_register(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
@@ -59,7 +98,10 @@ int gnrc_netreg_register(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
         return -EINVAL;
     }
 
-    LL_PREPEND(netreg[type], entry);
+#ifdef MODULE_GNRC_NETREG_HASH
+    entry->nettype = type;
+#endif
+    LL_PREPEND(_LIST(type, entry->demux_ctx), entry);
 
     return 0;
 }
@@ -70,7 +112,7 @@ void gnrc_netreg_unregister(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
         return;
     }
 
-    LL_DELETE(netreg[type], entry);
+    LL_DELETE(_LIST(type, entry->demux_ctx), entry);
 }
 
 /**
@@ -78,7 +120,7 @@ void gnrc_netreg_unregister(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
  *          parameters, start lookup from beginning or given entry.
  *
  * @param[in] from      A registry entry to lookup from or NULL to start fresh
- * @param[in] type      Type of the protocol.
+ * @param[in] type      Type of the protocol. Ignored if @p from is given.
  * @param[in] demux_ctx The demultiplexing context for the registered thread.
  *                      See gnrc_netreg_entry_t::demux_ctx.
  *
@@ -91,9 +133,18 @@ static gnrc_netreg_entry_t *_netreg_lookup(gnrc_netreg_entry_t *from,
 {
     gnrc_netreg_entry_t *res = NULL;
 
-    if (from || !_INVALID_TYPE(type)) {
-        gnrc_netreg_entry_t *head = (from) ? from->next : netreg[type];
-        LL_SEARCH_SCALAR(head, res, demux_ctx, demux_ctx);
+    if (from) {
+#ifdef MODULE_GNRC_NETREG_HASH
+        type = from->nettype;
+#endif
+        res = from->next;
+    }
+    else if (!_INVALID_TYPE(type)) {
+        res = _LIST(type, demux_ctx);
+    }
+
+    while ((res != NULL) && !_matches(res, type, demux_ctx)) {
+        res = res->next;
     }
 
     return res;
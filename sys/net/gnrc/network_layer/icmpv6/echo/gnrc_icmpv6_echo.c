@@ -15,6 +15,7 @@
 #include "net/gnrc.h"
 
 #include "od.h"
+#include "net/inet_csum.h"
 #include "net/gnrc/icmpv6.h"
 #include "net/gnrc/icmpv6/echo.h"
 #include "net/gnrc/ipv6/hdr.h"
@@ -61,6 +62,7 @@ void gnrc_icmpv6_echo_req_handle(gnrc_netif_t *netif, ipv6_hdr_t *ipv6_hdr,
 {
     uint8_t *payload = ((uint8_t *)echo) + sizeof(icmpv6_echo_t);
     gnrc_pktsnip_t *hdr, *pkt;
+    uint8_t netif_hdr_flags = 0;
 
     if ((echo == NULL) || (len < sizeof(icmpv6_echo_t))) {
         DEBUG("icmpv6_echo: echo was NULL or len (%" PRIu16
@@ -81,6 +83,17 @@ void gnrc_icmpv6_echo_req_handle(gnrc_netif_t *netif, ipv6_hdr_t *ipv6_hdr,
         hdr = gnrc_ipv6_hdr_build(pkt, NULL, &ipv6_hdr->src);
     }
     else {
+        icmpv6_echo_t *reply = pkt->data;
+
+        /* the reply differs from the (verified) request only in its type and
+         * code, swapping the addresses does not change the sum of the pseudo
+         * header: update the checksum of the request instead of calculating
+         * it over the whole payload again */
+        reply->csum = byteorder_htons(
+            inet_csum_update(byteorder_ntohs(echo->csum),
+                             (echo->type << 8) | echo->code,
+                             (reply->type << 8) | reply->code));
+        netif_hdr_flags |= GNRC_NETIF_HDR_FLAGS_CSUM_VALID;
         hdr = gnrc_ipv6_hdr_build(pkt, &ipv6_hdr->dst, &ipv6_hdr->src);
     }
 
@@ -92,6 +105,12 @@ void gnrc_icmpv6_echo_req_handle(gnrc_netif_t *netif, ipv6_hdr_t *ipv6_hdr,
 
     pkt = hdr;
     hdr = gnrc_netif_hdr_build(NULL, 0, NULL, 0);
+    if (hdr == NULL) {
+        DEBUG("icmpv6_echo: no space left in packet buffer\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    ((gnrc_netif_hdr_t *)hdr->data)->flags = netif_hdr_flags;
 
     if (netif != NULL) {
         ((gnrc_netif_hdr_t *)hdr->data)->if_pid = netif->pid;
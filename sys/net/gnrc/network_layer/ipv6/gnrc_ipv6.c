@@ -53,6 +53,13 @@ static char _stack[GNRC_IPV6_STACK_SIZE];
  */
 static fib_entry_t _fib_entries[GNRC_IPV6_FIB_TABLE_SIZE];
 
+#ifdef MODULE_FIB_LPM
+/**
+ * @brief buffer to store the nodes of the longest-prefix-match index
+ */
+static fib_lpm_node_t _fib_lpm_nodes[FIB_LPM_NODES_NUMOF(GNRC_IPV6_FIB_TABLE_SIZE)];
+#endif
+
 /**
  * @brief the IPv6 forwarding table
  */
@@ -87,6 +94,10 @@ kernel_pid_t gnrc_ipv6_init(void)
     gnrc_ipv6_fib_table.data.entries = _fib_entries;
     gnrc_ipv6_fib_table.table_type = FIB_TABLE_TYPE_SH;
     gnrc_ipv6_fib_table.size = GNRC_IPV6_FIB_TABLE_SIZE;
+#ifdef MODULE_FIB_LPM
+    gnrc_ipv6_fib_table.lpm_nodes = _fib_lpm_nodes;
+    gnrc_ipv6_fib_table.lpm_nodes_numof = FIB_LPM_NODES_NUMOF(GNRC_IPV6_FIB_TABLE_SIZE);
+#endif
     fib_init(&gnrc_ipv6_fib_table);
 #endif
 
@@ -377,7 +388,17 @@ static bool _is_ipv6_hdr(gnrc_pktsnip_t *hdr)
 #endif
 }
 
-static int _fill_ipv6_hdr(gnrc_netif_t *netif, gnrc_pktsnip_t *ipv6)
+/* the upper layer checksum is calculated unless the sender already set it or
+ * the device of the interface does */
+static inline bool _calc_csum(const gnrc_netif_t *netif, uint8_t netif_hdr_flags)
+{
+    return !(netif_hdr_flags & GNRC_NETIF_HDR_FLAGS_CSUM_VALID) &&
+           ((netif == NULL) ||
+            !(netif->flags & GNRC_NETIF_FLAGS_TX_CSUM_OFFLOAD));
+}
+
+static int _fill_ipv6_hdr(gnrc_netif_t *netif, gnrc_pktsnip_t *ipv6,
+                          bool calc_csum)
 {
     int res;
     ipv6_hdr_t *hdr = ipv6->data;
@@ -425,6 +446,11 @@ static int _fill_ipv6_hdr(gnrc_netif_t *netif, gnrc_pktsnip_t *ipv6)
         }
     }
 
+    if (!calc_csum) {
+        DEBUG("ipv6: checksum already set or calculated by device\n");
+        return 0;
+    }
+
     DEBUG("ipv6: write protect up to payload to calculate checksum\n");
     payload = ipv6;
     prev = ipv6;
@@ -453,9 +479,9 @@ static int _fill_ipv6_hdr(gnrc_netif_t *netif, gnrc_pktsnip_t *ipv6)
 }
 
 static bool _safe_fill_ipv6_hdr(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt,
-                                bool prep_hdr)
+                                bool prep_hdr, bool calc_csum)
 {
-    if (prep_hdr && (_fill_ipv6_hdr(netif, pkt) < 0)) {
+    if (prep_hdr && (_fill_ipv6_hdr(netif, pkt, calc_csum) < 0)) {
         /* error on filling up header */
         gnrc_pktbuf_release(pkt);
         return false;
@@ -480,7 +506,8 @@ static void _send_unicast(gnrc_pktsnip_t *pkt, bool prep_hdr,
     }
     netif = gnrc_netif_get_by_pid(gnrc_ipv6_nib_nc_get_iface(&nce));
     assert(netif != NULL);
-    if (_safe_fill_ipv6_hdr(netif, pkt, prep_hdr)) {
+    if (_safe_fill_ipv6_hdr(netif, pkt, prep_hdr,
+                            _calc_csum(netif, netif_hdr_flags))) {
         DEBUG("ipv6: add interface header to packet\n");
         if ((pkt = _create_netif_hdr(nce.l2addr, nce.l2addr_len, pkt,
                                      netif_hdr_flags)) == NULL) {
@@ -548,7 +575,8 @@ static void _send_multicast(gnrc_pktsnip_t *pkt, bool prep_hdr,
                     gnrc_pktbuf_release(pkt);
                     return;
                 }
-                if (_fill_ipv6_hdr(netif, tmp) < 0) {
+                if (_fill_ipv6_hdr(netif, tmp,
+                                   _calc_csum(netif, netif_hdr_flags)) < 0) {
                     /* error on filling up header */
                     if (tmp != pkt) {
                         gnrc_pktbuf_release(tmp);
@@ -561,7 +589,8 @@ static void _send_multicast(gnrc_pktsnip_t *pkt, bool prep_hdr,
         }
     }
     else {
-        if (_safe_fill_ipv6_hdr(netif, pkt, prep_hdr)) {
+        if (_safe_fill_ipv6_hdr(netif, pkt, prep_hdr,
+                                _calc_csum(netif, netif_hdr_flags))) {
             _send_multicast_over_iface(pkt, netif, netif_hdr_flags);
         }
     }
@@ -575,19 +604,22 @@ static void _send_multicast(gnrc_pktsnip_t *pkt, bool prep_hdr,
             return;
         }
     }
-    if (_safe_fill_ipv6_hdr(netif, pkt, prep_hdr)) {
+    if (_safe_fill_ipv6_hdr(netif, pkt, prep_hdr,
+                            _calc_csum(netif, netif_hdr_flags))) {
         _send_multicast_over_iface(pkt, netif, netif_hdr_flags);
     }
 #endif  /* GNRC_NETIF_NUMOF */
 }
 
 static void _send_to_self(gnrc_pktsnip_t *pkt, bool prep_hdr,
-                          gnrc_netif_t *netif)
+                          gnrc_netif_t *netif, uint8_t netif_hdr_flags)
 {
     uint8_t *rcv_data;
     gnrc_pktsnip_t *ptr = pkt, *rcv_pkt;
 
-    if (!_safe_fill_ipv6_hdr(netif, pkt, prep_hdr)) {
+    /* the packet does not pass a device, so the receiver checks the checksum */
+    if (!_safe_fill_ipv6_hdr(netif, pkt, prep_hdr,
+                             _calc_csum(NULL, netif_hdr_flags))) {
         return;
     }
     rcv_pkt = gnrc_pktbuf_add(NULL, NULL, gnrc_pkt_len(pkt), GNRC_NETTYPE_IPV6);
@@ -676,7 +708,7 @@ static void _send(gnrc_pktsnip_t *pkt, bool prep_hdr)
         if (ipv6_addr_is_loopback(&ipv6_hdr->dst) ||    /* dst is loopback address */
             /* or dst registered to a local interface */
             (tmp_netif != NULL)) {
-            _send_to_self(pkt, prep_hdr, tmp_netif);
+            _send_to_self(pkt, prep_hdr, tmp_netif, netif_hdr_flags);
         }
         else {
             _send_unicast(pkt, prep_hdr, netif, ipv6_hdr, netif_hdr_flags);
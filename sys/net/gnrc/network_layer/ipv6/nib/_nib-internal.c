@@ -32,7 +32,9 @@
 
 /* pointers for default router selection */
 _nib_dr_entry_t *_prime_def_router = NULL;
+#if !GNRC_IPV6_NIB_CONF_NC_HASH
 static clist_node_t _next_removable = { NULL };
+#endif  /* !GNRC_IPV6_NIB_CONF_NC_HASH */
 
 static _nib_onl_entry_t _nodes[GNRC_IPV6_NIB_NUMOF];
 static _nib_offl_entry_t _dsts[GNRC_IPV6_NIB_OFFL_NUMOF];
@@ -42,6 +44,62 @@ static _nib_dr_entry_t _def_routers[GNRC_IPV6_NIB_DEFAULT_ROUTER_NUMOF];
 static _nib_abr_entry_t _abrs[GNRC_IPV6_NIB_ABR_NUMOF];
 #endif  /* GNRC_IPV6_NIB_CONF_MULTIHOP_P6C */
 
+#if GNRC_IPV6_NIB_CONF_OFFL_LPM
+/**
+ * @brief   Node of the path-compressed binary trie over the prefixes of the
+ *          off-link entries
+ */
+typedef struct _lpm_node {
+    struct _lpm_node *child[2]; /**< sub-tries for next bit 0 or 1, next free
+                                 *   node in child[0] if unused */
+    _nib_offl_entry_t *entry;   /**< entry with prefix _lpm_node::key, NULL
+                                 *   for pure branching nodes */
+    ipv6_addr_t key;            /**< prefix of the node */
+    uint8_t len;                /**< length of _lpm_node::key in bits */
+} _lpm_node_t;
+
+/* every prefix requires at most one leaf and one branching node */
+static _lpm_node_t _lpm_nodes[2 * GNRC_IPV6_NIB_OFFL_NUMOF];
+static _lpm_node_t *_lpm_root;
+static _lpm_node_t *_lpm_free;
+
+static void _lpm_init(void);
+static void _lpm_insert(_nib_offl_entry_t *entry);
+static void _lpm_remove(_nib_offl_entry_t *entry);
+#endif  /* GNRC_IPV6_NIB_CONF_OFFL_LPM */
+
+#if GNRC_IPV6_NIB_CONF_NC_HASH
+/* end of a bucket chain and head of the replacement order */
+#define _NC_NIL     (GNRC_IPV6_NIB_NUMOF)
+
+/* Every entry of _nodes is chained into the bucket of its current address.
+ * The chains are sorted by index into _nodes, so a lookup finds the same
+ * entry as a linear scan over _nodes would. */
+static uint16_t _nc_buckets[GNRC_IPV6_NIB_NC_HASH_BUCKETS];
+static uint16_t _nc_chain[GNRC_IPV6_NIB_NUMOF];
+static uint16_t _nc_bucket_of[GNRC_IPV6_NIB_NUMOF];
+/* neighbor cache entries in replacement order, least recently used first.
+ * Entries not in the order link to themselves. */
+static uint16_t _nc_lru_prev[GNRC_IPV6_NIB_NUMOF + 1];
+static uint16_t _nc_lru_next[GNRC_IPV6_NIB_NUMOF + 1];
+
+static inline unsigned _nc_hash(const ipv6_addr_t *addr)
+{
+    uint32_t hash = addr->u32[0].u32 ^ addr->u32[1].u32 ^
+                    addr->u32[2].u32 ^ addr->u32[3].u32;
+
+    hash ^= hash >> 16;
+    hash *= 0x45d9f3bU;
+    hash ^= hash >> 16;
+    return hash & (GNRC_IPV6_NIB_NC_HASH_BUCKETS - 1);
+}
+
+static void _nc_init(void);
+static _nib_onl_entry_t *_nc_alloc_match(const ipv6_addr_t *addr,
+                                         unsigned iface);
+static void _nc_lru_push(unsigned idx);
+#endif  /* GNRC_IPV6_NIB_CONF_NC_HASH */
+
 static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 
 mutex_t _nib_mutex = MUTEX_INIT;
@@ -55,7 +113,9 @@ void _nib_init(void)
 {
 #ifdef TEST_SUITES
     _prime_def_router = NULL;
+#if !GNRC_IPV6_NIB_CONF_NC_HASH
     _next_removable.next = NULL;
+#endif  /* !GNRC_IPV6_NIB_CONF_NC_HASH */
     memset(_nodes, 0, sizeof(_nodes));
     memset(_def_routers, 0, sizeof(_def_routers));
     memset(_dsts, 0, sizeof(_dsts));
@@ -63,6 +123,12 @@ void _nib_init(void)
     memset(_abrs, 0, sizeof(_abrs));
 #endif  /* GNRC_IPV6_NIB_CONF_MULTIHOP_P6C */
 #endif  /* TEST_SUITES */
+#if GNRC_IPV6_NIB_CONF_OFFL_LPM
+    _lpm_init();
+#endif  /* GNRC_IPV6_NIB_CONF_OFFL_LPM */
+#if GNRC_IPV6_NIB_CONF_NC_HASH
+    _nc_init();
+#endif  /* GNRC_IPV6_NIB_CONF_NC_HASH */
     evtimer_init_msg(&_nib_evtimer);
     /* TODO: load ABR information from persistent memory */
 }
@@ -81,6 +147,13 @@ _nib_onl_entry_t *_nib_onl_alloc(const ipv6_addr_t *addr, unsigned iface)
     DEBUG("nib: Allocating on-link node entry (addr = %s, iface = %u)\n",
           (addr == NULL) ? "NULL" : ipv6_addr_to_str(addr_str, addr,
                                                      sizeof(addr_str)), iface);
+#if GNRC_IPV6_NIB_CONF_NC_HASH
+    if ((addr != NULL) && ((node = _nc_alloc_match(addr, iface)) != NULL)) {
+        DEBUG("  %p is an exact match\n", (void *)node);
+        _override_node(addr, iface, node);
+        return node;
+    }
+#endif  /* GNRC_IPV6_NIB_CONF_NC_HASH */
     for (unsigned i = 0; i < GNRC_IPV6_NIB_NUMOF; i++) {
         _nib_onl_entry_t *tmp = &_nodes[i];
 
@@ -113,6 +186,40 @@ static inline bool _is_gc(_nib_onl_entry_t *node)
             GNRC_IPV6_NIB_NC_INFO_AR_STATE_GC);
 }
 
+#if GNRC_IPV6_NIB_CONF_NC_HASH
+static inline _nib_onl_entry_t *_cache_out_onl_entry(const ipv6_addr_t *addr,
+                                                     unsigned iface,
+                                                     uint16_t cstate)
+{
+    DEBUG("nib: Searching for replaceable entries (addr = %s, iface = %u)\n",
+          ipv6_addr_to_str(addr_str, addr, sizeof(addr_str)), iface);
+    /* replace least recently used entry that is garbage collectible */
+    for (unsigned i = _nc_lru_next[_NC_NIL]; i != _NC_NIL;
+         i = _nc_lru_next[i]) {
+        _nib_onl_entry_t *tmp = &_nodes[i];
+
+        if (_is_gc(tmp)) {
+            DEBUG("nib: Removing neighbor cache entry (addr = %s, "
+                  "iface = %u) ",
+                  ipv6_addr_to_str(addr_str, &tmp->ipv6,
+                                   sizeof(addr_str)),
+                  _nib_onl_get_if(tmp));
+            DEBUG("for (addr = %s, iface = %u)\n",
+                  ipv6_addr_to_str(addr_str, addr, sizeof(addr_str)),
+                  iface);
+            /* call _nib_nc_remove to remove timers from _evtimer */
+            _nib_nc_remove(tmp);
+            _override_node(addr, iface, tmp);
+            /* cstate masked in _nib_nc_add() already */
+            tmp->info |= cstate;
+            tmp->mode = _NC;
+            _nc_lru_push(i);
+            return tmp;
+        }
+    }
+    return NULL;
+}
+#else   /* GNRC_IPV6_NIB_CONF_NC_HASH */
 static inline _nib_onl_entry_t *_cache_out_onl_entry(const ipv6_addr_t *addr,
                                                      unsigned iface,
                                                      uint16_t cstate)
@@ -154,6 +261,7 @@ static inline _nib_onl_entry_t *_cache_out_onl_entry(const ipv6_addr_t *addr,
     } while ((tmp != first) && (res != NULL));
     return res;
 }
+#endif  /* GNRC_IPV6_NIB_CONF_NC_HASH */
 
 _nib_onl_entry_t *_nib_nc_add(const ipv6_addr_t *addr, unsigned iface,
                               uint16_t cstate)
@@ -175,12 +283,17 @@ _nib_onl_entry_t *_nib_nc_add(const ipv6_addr_t *addr, unsigned iface,
         node->info |= cstate;
         node->mode |= _NC;
     }
+#if GNRC_IPV6_NIB_CONF_NC_HASH
+    /* (re-)queue as most recently used */
+    _nc_lru_push(node - _nodes);
+#else   /* GNRC_IPV6_NIB_CONF_NC_HASH */
     if (node->next == NULL) {
         DEBUG("nib: queueing (addr = %s, iface = %u) for potential removal\n",
               ipv6_addr_to_str(addr_str, addr, sizeof(addr_str)), iface);
         /* add to next removable list, if not already in it */
         clist_rpush(&_next_removable, (clist_node_t *)node);
     }
+#endif  /* GNRC_IPV6_NIB_CONF_NC_HASH */
     return node;
 }
 
@@ -203,7 +316,12 @@ _nib_onl_entry_t *_nib_onl_get(const ipv6_addr_t *addr, unsigned iface)
     assert(addr != NULL);
     DEBUG("nib: Getting on-link node entry (addr = %s, iface = %u)\n",
           ipv6_addr_to_str(addr_str, addr, sizeof(addr_str)), iface);
+#if GNRC_IPV6_NIB_CONF_NC_HASH
+    for (unsigned i = _nc_buckets[_nc_hash(addr)]; i != _NC_NIL;
+         i = _nc_chain[i]) {
+#else   /* GNRC_IPV6_NIB_CONF_NC_HASH */
     for (unsigned i = 0; i < GNRC_IPV6_NIB_NUMOF; i++) {
+#endif  /* GNRC_IPV6_NIB_CONF_NC_HASH */
         _nib_onl_entry_t *node = &_nodes[i];
 
         if ((node->mode != _EMPTY) &&
@@ -213,6 +331,12 @@ _nib_onl_entry_t *_nib_onl_get(const ipv6_addr_t *addr, unsigned iface)
              (_nib_onl_get_if(node) == iface)) &&
             ipv6_addr_equal(&node->ipv6, addr)) {
             DEBUG("  Found %p\n", (void *)node);
+#if GNRC_IPV6_NIB_CONF_NC_HASH
+            if (_nc_lru_next[i] != i) {
+                /* mark as most recently used */
+                _nc_lru_push(i);
+            }
+#endif  /* GNRC_IPV6_NIB_CONF_NC_HASH */
             return node;
         }
     }
@@ -350,6 +474,8 @@ void _nib_drl_remove(_nib_dr_entry_t *nib_dr)
     if (nib_dr->next_hop != NULL) {
         nib_dr->next_hop->mode &= ~(_DRL);
         _nib_onl_clear(nib_dr->next_hop);
+        /* the entry is cleared, so its event must not stay pending */
+        evtimer_del((evtimer_t *)&_nib_evtimer, &nib_dr->rtr_timeout.event);
         memset(nib_dr, 0, sizeof(_nib_dr_entry_t));
     }
     if (nib_dr == _prime_def_router) {
@@ -464,6 +590,9 @@ _nib_offl_entry_t *_nib_offl_alloc(const ipv6_addr_t *next_hop, unsigned iface,
             DEBUG("  %p is an exact match\n", (void *)tmp);
             if (next_hop != NULL) {
                 memcpy(&tmp_node->ipv6, next_hop, sizeof(tmp_node->ipv6));
+#if GNRC_IPV6_NIB_CONF_NC_HASH
+                _nib_onl_reindex(tmp_node, false);
+#endif  /* GNRC_IPV6_NIB_CONF_NC_HASH */
             }
             tmp->next_hop->mode |= _DST;
             return tmp;
@@ -484,6 +613,9 @@ _nib_offl_entry_t *_nib_offl_alloc(const ipv6_addr_t *next_hop, unsigned iface,
         dst->next_hop->mode |= _DST;
         ipv6_addr_init_prefix(&dst->pfx, pfx, pfx_len);
         dst->pfx_len = pfx_len;
+#if GNRC_IPV6_NIB_CONF_OFFL_LPM
+        _lpm_insert(dst);
+#endif  /* GNRC_IPV6_NIB_CONF_OFFL_LPM */
     }
     return dst;
 }
@@ -504,6 +636,9 @@ void _nib_offl_clear(_nib_offl_entry_t *dst)
 {
     if (dst->next_hop != NULL) {
         _nib_offl_entry_t *ptr;
+#if GNRC_IPV6_NIB_CONF_OFFL_LPM
+        _lpm_remove(dst);
+#endif  /* GNRC_IPV6_NIB_CONF_OFFL_LPM */
         for (ptr = _dsts; _in_dsts(ptr); ptr++) {
             /* there is another dst pointing to next-hop => only remove dst */
             if ((dst != ptr) && (dst->next_hop == ptr->next_hop)) {
@@ -515,6 +650,11 @@ void _nib_offl_clear(_nib_offl_entry_t *dst)
             dst->next_hop->mode &= ~(_DST);
             _nib_onl_clear(dst->next_hop);
         }
+        /* the entry is cleared, so its events must not stay pending */
+        evtimer_del((evtimer_t *)&_nib_evtimer, &dst->pfx_timeout.event);
+#ifdef GNRC_IPV6_NIB_CONF_ROUTER
+        evtimer_del((evtimer_t *)&_nib_evtimer, &dst->route_timeout.event);
+#endif
         memset(dst, 0, sizeof(_nib_offl_entry_t));
     }
 }
@@ -538,6 +678,185 @@ bool _nib_offl_is_entry(const _nib_offl_entry_t *entry)
     return (entry >= _dsts) && _in_dsts(entry);
 }
 
+#if GNRC_IPV6_NIB_CONF_OFFL_LPM
+static inline unsigned _lpm_bit(const ipv6_addr_t *key, unsigned pos)
+{
+    return (key->u8[pos >> 3] >> (7 - (pos & 0x7))) & 0x1;
+}
+
+/* returns the first bit in [from, to) in which a and b differ, to if there
+ * is none */
+static unsigned _lpm_common_len(const ipv6_addr_t *a, const ipv6_addr_t *b,
+                                unsigned from, unsigned to)
+{
+    unsigned pos = from;
+
+    while ((pos < to) && (pos & 0x7)) {
+        if (_lpm_bit(a, pos) != _lpm_bit(b, pos)) {
+            return pos;
+        }
+        pos++;
+    }
+    while (((pos + 8) <= to) && (a->u8[pos >> 3] == b->u8[pos >> 3])) {
+        pos += 8;
+    }
+    while ((pos < to) && (_lpm_bit(a, pos) == _lpm_bit(b, pos))) {
+        pos++;
+    }
+    return pos;
+}
+
+static void _lpm_init(void)
+{
+    _lpm_root = NULL;
+    _lpm_free = NULL;
+    for (unsigned i = 0; i < (sizeof(_lpm_nodes) / sizeof(_lpm_nodes[0])); i++) {
+        _lpm_nodes[i].child[0] = _lpm_free;
+        _lpm_free = &_lpm_nodes[i];
+    }
+}
+
+static _lpm_node_t *_lpm_node_alloc(const ipv6_addr_t *key, unsigned len,
+                                    _nib_offl_entry_t *entry)
+{
+    _lpm_node_t *node = _lpm_free;
+
+    /* the pool is dimensioned for the maximum number of prefixes */
+    assert(node != NULL);
+    _lpm_free = node->child[0];
+    node->child[0] = NULL;
+    node->child[1] = NULL;
+    node->entry = entry;
+    node->len = len;
+    ipv6_addr_init_prefix(&node->key, key, len);
+    return node;
+}
+
+static void _lpm_node_free(_lpm_node_t *node)
+{
+    node->entry = NULL;
+    node->child[0] = _lpm_free;
+    _lpm_free = node;
+}
+
+static void _lpm_insert(_nib_offl_entry_t *entry)
+{
+    _lpm_node_t **node = &_lpm_root;
+    unsigned pos = 0;
+
+    while (*node != NULL) {
+        _lpm_node_t *cur = *node;
+        unsigned max = (cur->len < entry->pfx_len) ? cur->len : entry->pfx_len;
+        unsigned common = _lpm_common_len(&cur->key, &entry->pfx, pos, max);
+
+        if (common < cur->len) {
+            /* the prefix diverges from or ends within this node => split it */
+            _lpm_node_t *leaf = _lpm_node_alloc(&entry->pfx, entry->pfx_len,
+                                                entry);
+
+            if (common == entry->pfx_len) {
+                leaf->child[_lpm_bit(&cur->key, common)] = cur;
+                *node = leaf;
+            }
+            else {
+                _lpm_node_t *branch = _lpm_node_alloc(&entry->pfx, common, NULL);
+
+                branch->child[_lpm_bit(&entry->pfx, common)] = leaf;
+                branch->child[_lpm_bit(&cur->key, common)] = cur;
+                *node = branch;
+            }
+            return;
+        }
+        if (cur->len == entry->pfx_len) {
+            /* of several entries with the same prefix the linear search
+             * found the first one in _dsts, so keep it that way */
+            if ((cur->entry == NULL) || (entry < cur->entry)) {
+                cur->entry = entry;
+            }
+            return;
+        }
+        pos = cur->len;
+        node = &cur->child[_lpm_bit(&entry->pfx, pos)];
+    }
+    *node = _lpm_node_alloc(&entry->pfx, entry->pfx_len, entry);
+}
+
+static void _lpm_remove(_nib_offl_entry_t *entry)
+{
+    _lpm_node_t **parent = NULL;
+    _lpm_node_t **node = &_lpm_root;
+    unsigned pos = 0;
+
+    while (*node != NULL) {
+        _lpm_node_t *cur = *node;
+
+        if ((cur->len > entry->pfx_len) ||
+            (_lpm_common_len(&cur->key, &entry->pfx, pos, cur->len) < cur->len)) {
+            return;
+        }
+        if (cur->len == entry->pfx_len) {
+            if (cur->entry != entry) {
+                /* entry shares its prefix with the indexed one */
+                return;
+            }
+            /* look for another entry with the same prefix to take over */
+            cur->entry = NULL;
+            for (_nib_offl_entry_t *ptr = _dsts; _in_dsts(ptr); ptr++) {
+                if ((ptr != entry) && (ptr->next_hop != NULL) &&
+                    (ptr->pfx_len == entry->pfx_len) &&
+                    ipv6_addr_equal(&ptr->pfx, &entry->pfx)) {
+                    cur->entry = ptr;
+                    return;
+                }
+            }
+            if ((cur->child[0] != NULL) && (cur->child[1] != NULL)) {
+                /* still required as branching node */
+                return;
+            }
+            *node = (cur->child[0] != NULL) ? cur->child[0] : cur->child[1];
+            _lpm_node_free(cur);
+            /* a branching parent left with a single child became redundant */
+            if ((*node == NULL) && (parent != NULL) &&
+                ((*parent)->entry == NULL)) {
+                _lpm_node_t *branch = *parent;
+
+                *parent = (branch->child[0] != NULL) ? branch->child[0]
+                                                     : branch->child[1];
+                _lpm_node_free(branch);
+            }
+            return;
+        }
+        pos = cur->len;
+        parent = node;
+        node = &cur->child[_lpm_bit(&entry->pfx, pos)];
+    }
+}
+
+static _nib_offl_entry_t *_nib_offl_get_match(const ipv6_addr_t *dst)
+{
+    _nib_offl_entry_t *res = NULL;
+    _lpm_node_t *node = _lpm_root;
+    unsigned pos = 0;
+
+    DEBUG("nib: get match for destination %s from NIB\n",
+          ipv6_addr_to_str(addr_str, dst, sizeof(addr_str)));
+    while ((node != NULL) &&
+           (_lpm_common_len(&node->key, dst, pos, node->len) == node->len)) {
+        if ((node->entry != NULL) && (node->entry->mode != _EMPTY)) {
+            DEBUG("nib: best match so far %s/%u\n",
+                  ipv6_addr_to_str(addr_str, &node->key, sizeof(addr_str)),
+                  node->len);
+            res = node->entry;
+        }
+        if (node->len == IPV6_ADDR_BIT_LEN) {
+            break;
+        }
+        pos = node->len;
+        node = node->child[_lpm_bit(dst, pos)];
+    }
+    return res;
+}
+#else   /* GNRC_IPV6_NIB_CONF_OFFL_LPM */
 static _nib_offl_entry_t *_nib_offl_get_match(const ipv6_addr_t *dst)
 {
     _nib_offl_entry_t *res = NULL;
@@ -566,6 +885,7 @@ static _nib_offl_entry_t *_nib_offl_get_match(const ipv6_addr_t *dst)
     }
     return res;
 }
+#endif  /* GNRC_IPV6_NIB_CONF_OFFL_LPM */
 
 void _nib_ft_get(const _nib_offl_entry_t *dst, gnrc_ipv6_nib_ft_t *fte)
 {
@@ -694,6 +1014,7 @@ void _nib_abr_remove(const ipv6_addr_t *addr)
                 }
             }
 #endif  /* MODULE_GNRC_SIXLOWPAN_CTX */
+            evtimer_del((evtimer_t *)&_nib_evtimer, &abr->timeout.event);
             memset(abr, 0, sizeof(_nib_abr_entry_t));
         }
     }
@@ -787,12 +1108,106 @@ _nib_offl_entry_t *_nib_pl_add(unsigned iface,
     return dst;
 }
 
+#if GNRC_IPV6_NIB_CONF_NC_HASH
+static void _nc_init(void)
+{
+    for (unsigned i = 0; i < GNRC_IPV6_NIB_NC_HASH_BUCKETS; i++) {
+        _nc_buckets[i] = _NC_NIL;
+    }
+    /* prepend in reverse to keep the chains sorted */
+    for (unsigned i = GNRC_IPV6_NIB_NUMOF; i > 0; i--) {
+        unsigned idx = i - 1;
+        unsigned bucket = _nc_hash(&_nodes[idx].ipv6);
+
+        _nc_bucket_of[idx] = bucket;
+        _nc_chain[idx] = _nc_buckets[bucket];
+        _nc_buckets[bucket] = idx;
+    }
+    for (unsigned i = 0; i <= _NC_NIL; i++) {
+        _nc_lru_prev[i] = i;
+        _nc_lru_next[i] = i;
+    }
+}
+
+static void _nc_lru_remove(unsigned idx)
+{
+    _nc_lru_next[_nc_lru_prev[idx]] = _nc_lru_next[idx];
+    _nc_lru_prev[_nc_lru_next[idx]] = _nc_lru_prev[idx];
+    _nc_lru_prev[idx] = idx;
+    _nc_lru_next[idx] = idx;
+}
+
+static void _nc_lru_push(unsigned idx)
+{
+    _nc_lru_remove(idx);
+    _nc_lru_prev[idx] = _nc_lru_prev[_NC_NIL];
+    _nc_lru_next[idx] = _NC_NIL;
+    _nc_lru_next[_nc_lru_prev[_NC_NIL]] = idx;
+    _nc_lru_prev[_NC_NIL] = idx;
+}
+
+void _nib_onl_reindex(_nib_onl_entry_t *node, bool cleared)
+{
+    unsigned idx = node - _nodes;
+    unsigned bucket = _nc_hash(&node->ipv6);
+
+    assert(idx < GNRC_IPV6_NIB_NUMOF);
+    if (bucket != _nc_bucket_of[idx]) {
+        uint16_t *ptr = &_nc_buckets[_nc_bucket_of[idx]];
+
+        while (*ptr != idx) {
+            ptr = &_nc_chain[*ptr];
+        }
+        *ptr = _nc_chain[idx];
+        ptr = &_nc_buckets[bucket];
+        while (*ptr < idx) {
+            ptr = &_nc_chain[*ptr];
+        }
+        _nc_chain[idx] = *ptr;
+        *ptr = idx;
+        _nc_bucket_of[idx] = bucket;
+    }
+    if (cleared) {
+        _nc_lru_remove(idx);
+    }
+}
+
+static _nib_onl_entry_t *_nc_alloc_match(const ipv6_addr_t *addr,
+                                         unsigned iface)
+{
+    unsigned res = _NC_NIL;
+
+    for (unsigned i = _nc_buckets[_nc_hash(addr)]; i != _NC_NIL;
+         i = _nc_chain[i]) {
+        if ((_nib_onl_get_if(&_nodes[i]) == iface) &&
+            ipv6_addr_equal(addr, &_nodes[i].ipv6)) {
+            res = i;
+            break;
+        }
+    }
+    /* entries with unspecified address match as well (see _addr_equals()),
+     * the first one in _nodes wins */
+    for (unsigned i = _nc_buckets[_nc_hash(&ipv6_addr_unspecified)];
+         i < res; i = _nc_chain[i]) {
+        if ((_nib_onl_get_if(&_nodes[i]) == iface) &&
+            ipv6_addr_is_unspecified(&_nodes[i].ipv6)) {
+            res = i;
+            break;
+        }
+    }
+    return (res != _NC_NIL) ? &_nodes[res] : NULL;
+}
+#endif  /* GNRC_IPV6_NIB_CONF_NC_HASH */
+
 static void _override_node(const ipv6_addr_t *addr, unsigned iface,
                            _nib_onl_entry_t *node)
 {
     _nib_onl_clear(node);
     if (addr != NULL) {
         memcpy(&node->ipv6, addr, sizeof(node->ipv6));
+#if GNRC_IPV6_NIB_CONF_NC_HASH
+        _nib_onl_reindex(node, false);
+#endif  /* GNRC_IPV6_NIB_CONF_NC_HASH */
     }
     _nib_onl_set_if(node, iface);
 }
@@ -811,17 +1226,17 @@ static inline bool _node_unreachable(_nib_onl_entry_t *node)
 
 uint32_t _evtimer_lookup(const void *ctx, uint16_t type)
 {
-    evtimer_msg_event_t *event = (evtimer_msg_event_t *)_nib_evtimer.events;
+    evtimer_event_t *event = NULL;
     uint32_t offset = 0;
 
     DEBUG("nib: lookup ctx = %p, type = %04x\n", (void *)ctx, type);
-    while (event != NULL) {
-        offset += event->event.offset;
-        if ((event->msg.type == type) &&
-            ((ctx == NULL) || (event->msg.content.ptr == ctx))) {
+    while ((event = evtimer_next(&_nib_evtimer, event, &offset))) {
+        evtimer_msg_event_t *mevent = (evtimer_msg_event_t *)event;
+
+        if ((mevent->msg.type == type) &&
+            ((ctx == NULL) || (mevent->msg.content.ptr == ctx))) {
             return offset;
         }
-        event = (evtimer_msg_event_t *)event->event.next;
     }
     return UINT32_MAX;
 }
@@ -304,6 +304,18 @@ static inline void _nib_onl_set_if(_nib_onl_entry_t *node, unsigned iface)
  */
 _nib_onl_entry_t *_nib_onl_alloc(const ipv6_addr_t *addr, unsigned iface);
 
+#if GNRC_IPV6_NIB_CONF_NC_HASH || defined(DOXYGEN)
+/**
+ * @brief   Updates the hashed index after _nib_onl_entry_t::ipv6 of @p node
+ *          changed
+ *
+ * @param[in] node      An entry.
+ * @param[in] cleared   The entry was cleared and is also removed from the
+ *                      replacement order of the neighbor cache.
+ */
+void _nib_onl_reindex(_nib_onl_entry_t *node, bool cleared);
+#endif
+
 /**
  * @brief   Clears out a NIB entry (on-link version)
  *
@@ -316,6 +328,9 @@ static inline bool _nib_onl_clear(_nib_onl_entry_t *node)
 {
     if (node->mode == _EMPTY) {
         memset(node, 0, sizeof(_nib_onl_entry_t));
+#if GNRC_IPV6_NIB_CONF_NC_HASH
+        _nib_onl_reindex(node, true);
+#endif  /* GNRC_IPV6_NIB_CONF_NC_HASH */
         return true;
     }
     return false;
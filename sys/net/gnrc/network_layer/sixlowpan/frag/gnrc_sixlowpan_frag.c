@@ -17,6 +17,7 @@
  */
 
 #include "kernel_types.h"
+#include "thread.h"
 #include "net/gnrc/pktbuf.h"
 #include "net/gnrc/netapi.h"
 #include "net/gnrc/netif/hdr.h"
@@ -31,9 +32,7 @@
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
-static gnrc_sixlowpan_msg_frag_t _fragment_msg = {
-        NULL, 0, 0, KERNEL_PID_UNDEF
-    };
+static gnrc_sixlowpan_msg_frag_t _fragment_msg[GNRC_SIXLOWPAN_MSG_FRAG_SIZE];
 
 #if ENABLE_DEBUG
 /* For PRIu16 etc. */
@@ -87,7 +86,8 @@ static gnrc_pktsnip_t *_build_frag_pkt(gnrc_pktsnip_t *pkt, size_t payload_len,
 }
 
 static uint16_t _send_1st_fragment(gnrc_netif_t *iface, gnrc_pktsnip_t *pkt,
-                                   size_t payload_len, size_t datagram_size)
+                                   size_t payload_len, size_t datagram_size,
+                                   uint16_t tag)
 {
     gnrc_pktsnip_t *frag;
     uint16_t local_offset = 0;
@@ -115,7 +115,7 @@ static uint16_t _send_1st_fragment(gnrc_netif_t *iface, gnrc_pktsnip_t *pkt,
 
     hdr->disp_size = byteorder_htons((uint16_t)datagram_size);
     hdr->disp_size.u8[0] |= SIXLOWPAN_FRAG_1_DISP;
-    hdr->tag = byteorder_htons(_tag);
+    hdr->tag = byteorder_htons(tag);
 
     /* Tell the link layer that we will send more fragments */
     gnrc_netif_hdr_t *netif_hdr = frag->data;
@@ -138,14 +138,14 @@ static uint16_t _send_1st_fragment(gnrc_netif_t *iface, gnrc_pktsnip_t *pkt,
 
     DEBUG("6lo frag: send first fragment (datagram size: %u, "
           "datagram tag: %" PRIu16 ", fragment size: %" PRIu16 ")\n",
-          (unsigned int)datagram_size, _tag, local_offset);
+          (unsigned int)datagram_size, tag, local_offset);
     gnrc_sixlowpan_dispatch_send(frag, NULL, 0);
     return local_offset;
 }
 
 static uint16_t _send_nth_fragment(gnrc_netif_t *iface, gnrc_pktsnip_t *pkt,
                                    size_t payload_len, size_t datagram_size,
-                                   uint16_t offset)
+                                   uint16_t offset, uint16_t tag)
 {
     gnrc_pktsnip_t *frag;
     /* since dispatches aren't supposed to go into subsequent fragments, we need not account
@@ -171,7 +171,7 @@ static uint16_t _send_nth_fragment(gnrc_netif_t *iface, gnrc_pktsnip_t *pkt,
     /* XXX: truncation of datagram_size > 4095 may happen here */
     hdr->disp_size = byteorder_htons((uint16_t)datagram_size);
     hdr->disp_size.u8[0] |= SIXLOWPAN_FRAG_N_DISP;
-    hdr->tag = byteorder_htons(_tag);
+    hdr->tag = byteorder_htons(tag);
     /* don't mention payload diff in offset */
     hdr->offset = (uint8_t)((offset + (datagram_size - payload_len)) >> 3);
     pkt = pkt->next;    /* don't copy netif header */
@@ -223,15 +223,63 @@ static uint16_t _send_nth_fragment(gnrc_netif_t *iface, gnrc_pktsnip_t *pkt,
     DEBUG("6lo frag: send subsequent fragment (datagram size: %u, "
           "datagram tag: %" PRIu16 ", offset: %" PRIu8 " (%u bytes), "
           "fragment size: %" PRIu16 ")\n",
-          (unsigned int)datagram_size, _tag, hdr->offset, hdr->offset << 3,
+          (unsigned int)datagram_size, tag, hdr->offset, hdr->offset << 3,
           local_offset);
     gnrc_sixlowpan_dispatch_send(frag, NULL, 0);
     return local_offset;
 }
 
+uint16_t gnrc_sixlowpan_frag_next_tag(void)
+{
+    return ++_tag;
+}
+
 gnrc_sixlowpan_msg_frag_t *gnrc_sixlowpan_msg_frag_get(void)
 {
-    return (_fragment_msg.pkt == NULL) ? &_fragment_msg : NULL;
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_MSG_FRAG_SIZE; i++) {
+        if (_fragment_msg[i].pkt == NULL) {
+            return &_fragment_msg[i];
+        }
+    }
+    return NULL;
+}
+
+#if GNRC_SIXLOWPAN_FRAG_PACING
+static void _pacing_cb(void *arg)
+{
+    gnrc_sixlowpan_msg_frag_t *fragment_msg = arg;
+    msg_t msg;
+
+    msg.type = GNRC_SIXLOWPAN_MSG_FRAG_SND;
+    msg.content.ptr = fragment_msg;
+    if (msg_try_send(&msg, fragment_msg->sixlowpan_pid) == 0) {
+        /* the datagram would be stuck in the pool if the message got lost, so
+         * try again after another interval */
+        xtimer_set(&fragment_msg->timer, GNRC_SIXLOWPAN_FRAG_PACING);
+    }
+}
+#endif
+
+/* Queues the next fragment of a datagram behind everything the 6LoWPAN thread
+ * received so far, so fragments of concurrent datagrams are sent in turns */
+static void _schedule_next_fragment(gnrc_sixlowpan_msg_frag_t *fragment_msg)
+{
+#if GNRC_SIXLOWPAN_FRAG_PACING
+    fragment_msg->sixlowpan_pid = thread_getpid();
+    fragment_msg->timer.callback = _pacing_cb;
+    fragment_msg->timer.arg = fragment_msg;
+    xtimer_set(&fragment_msg->timer, GNRC_SIXLOWPAN_FRAG_PACING);
+#else
+    msg_t msg;
+
+    msg.type = GNRC_SIXLOWPAN_MSG_FRAG_SND;
+    msg.content.ptr = fragment_msg;
+    if (msg_send_to_self(&msg) <= 0) {
+        DEBUG("6lo frag: message queue full, dropping datagram\n");
+        gnrc_pktbuf_release(fragment_msg->pkt);
+        fragment_msg->pkt = NULL;
+    }
+#endif
 }
 
 void gnrc_sixlowpan_frag_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
@@ -243,7 +291,6 @@ void gnrc_sixlowpan_frag_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
     /* payload_len: actual size of the packet vs
      * datagram_size: size of the uncompressed IPv6 packet */
     size_t payload_len = gnrc_pkt_len(fragment_msg->pkt->next);
-    msg_t msg;
 
     assert((fragment_msg->pkt == pkt) || (pkt == NULL));
     (void)page;
@@ -262,8 +309,10 @@ void gnrc_sixlowpan_frag_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
     /* Check whether to send the first or an Nth fragment */
     if (fragment_msg->offset == 0) {
         /* increment tag for successive, fragmented datagrams */
-        _tag++;
-        if ((res = _send_1st_fragment(iface, fragment_msg->pkt, payload_len, fragment_msg->datagram_size)) == 0) {
+        fragment_msg->tag = gnrc_sixlowpan_frag_next_tag();
+        if ((res = _send_1st_fragment(iface, fragment_msg->pkt, payload_len,
+                                      fragment_msg->datagram_size,
+                                      fragment_msg->tag)) == 0) {
             /* error sending first fragment */
             DEBUG("6lo frag: error sending 1st fragment\n");
             gnrc_pktbuf_release(fragment_msg->pkt);
@@ -271,18 +320,15 @@ void gnrc_sixlowpan_frag_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
             return;
         }
         fragment_msg->offset += res;
-
-        /* send message to self*/
-        msg.type = GNRC_SIXLOWPAN_MSG_FRAG_SND;
-        msg.content.ptr = (void *)fragment_msg;
-        msg_send_to_self(&msg);
-        thread_yield();
+        _schedule_next_fragment(fragment_msg);
     }
     else {
         /* (offset + (datagram_size - payload_len) < datagram_size) simplified */
         if (fragment_msg->offset < payload_len) {
-            if ((res = _send_nth_fragment(iface, fragment_msg->pkt, payload_len, fragment_msg->datagram_size,
-                                          fragment_msg->offset)) == 0) {
+            if ((res = _send_nth_fragment(iface, fragment_msg->pkt, payload_len,
+                                          fragment_msg->datagram_size,
+                                          fragment_msg->offset,
+                                          fragment_msg->tag)) == 0) {
                 /* error sending subsequent fragment */
                 DEBUG("6lo frag: error sending subsequent fragment (offset = %" PRIu16
                       ")\n", fragment_msg->offset);
@@ -291,12 +337,7 @@ void gnrc_sixlowpan_frag_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
                 return;
                 }
             fragment_msg->offset += res;
-
-            /* send message to self*/
-            msg.type = GNRC_SIXLOWPAN_MSG_FRAG_SND;
-            msg.content.ptr = (void *)fragment_msg;
-            msg_send_to_self(&msg);
-            thread_yield();
+            _schedule_next_fragment(fragment_msg);
         }
         else {
             gnrc_pktbuf_release(fragment_msg->pkt);
@@ -0,0 +1,245 @@
+/*
+ * Copyright (C) 2018 OverDriveGain
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ *
+ * @author  OverDriveGain
+ */
+
+#include <string.h>
+
+#include "minfwd.h"
+#include "net/gnrc/ipv6/nib.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/netif/internal.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/sixlowpan/frag.h"
+#include "net/gnrc/sixlowpan/internal.h"
+#include "net/ipv6/hdr.h"
+#include "net/sixlowpan.h"
+#include "utlist.h"
+#include "xtimer.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+/* smallest fragment size that still carries 8 bytes of payload */
+#define MINFWD_MIN_FRAG_SIZE    (sizeof(sixlowpan_frag_t) + 1 + 8)
+
+static minfwd_t _minfwd[GNRC_SIXLOWPAN_FRAG_MINFWD_SIZE];
+
+static inline bool _in_use(const minfwd_t *entry, uint32_t now_usec)
+{
+    return (entry->out_pid != KERNEL_PID_UNDEF) &&
+           ((now_usec - entry->arrival) <= RBUF_TIMEOUT);
+}
+
+static minfwd_t *_get(const uint8_t *src, size_t src_len, uint16_t size,
+                      uint16_t tag, uint32_t now_usec)
+{
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_FRAG_MINFWD_SIZE; i++) {
+        minfwd_t *entry = &_minfwd[i];
+
+        if (_in_use(entry, now_usec) && (entry->tag == tag) &&
+            (entry->datagram_size == size) && (entry->src_len == src_len) &&
+            (memcmp(entry->src, src, src_len) == 0)) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+static minfwd_t *_get_free(uint32_t now_usec)
+{
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_FRAG_MINFWD_SIZE; i++) {
+        if (!_in_use(&_minfwd[i], now_usec)) {
+            return &_minfwd[i];
+        }
+    }
+    return NULL;
+}
+
+/* checks if any of the 8-byte units covered by len bytes at offset was
+ * forwarded already */
+static bool _relayed(minfwd_t *entry, uint16_t offset, size_t len)
+{
+    for (unsigned i = offset / 8; i < ((offset + len + 7) / 8); i++) {
+        if (bf_isset(entry->relayed, i)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* sends data of the datagram at offset to the next hop, in as many fragments
+ * as the interface requires */
+static bool _send(minfwd_t *entry, gnrc_netif_t *netif, const uint8_t *data,
+                  uint16_t offset, size_t len)
+{
+    while (len > 0) {
+        size_t hdr_len = (offset == 0) ? (sizeof(sixlowpan_frag_t) + 1)
+                                       : sizeof(sixlowpan_frag_n_t);
+        /* all but the last fragment end at a multiple of 8 */
+        size_t frag_len = (netif->sixlo.max_frag_size - hdr_len) & ~0x7U;
+        gnrc_pktsnip_t *netif_snip, *frag;
+        sixlowpan_frag_t *hdr;
+        uint8_t *payload;
+
+        if (frag_len > len) {
+            frag_len = len;
+        }
+        netif_snip = gnrc_netif_hdr_build(NULL, 0, entry->dst, entry->dst_len);
+        if (netif_snip == NULL) {
+            DEBUG("6lo minfwd: error allocating link-layer header\n");
+            return false;
+        }
+        ((gnrc_netif_hdr_t *)netif_snip->data)->if_pid = entry->out_pid;
+        frag = gnrc_pktbuf_add(NULL, NULL, hdr_len + frag_len,
+                               GNRC_NETTYPE_SIXLOWPAN);
+        if (frag == NULL) {
+            DEBUG("6lo minfwd: error allocating fragment\n");
+            gnrc_pktbuf_release(netif_snip);
+            return false;
+        }
+        hdr = frag->data;
+        hdr->disp_size = byteorder_htons(entry->datagram_size);
+        hdr->tag = byteorder_htons(entry->out_tag);
+        if (offset == 0) {
+            hdr->disp_size.u8[0] |= SIXLOWPAN_FRAG_1_DISP;
+            payload = (uint8_t *)(hdr + 1);
+            *(payload++) = SIXLOWPAN_UNCOMP;
+        }
+        else {
+            sixlowpan_frag_n_t *hdr_n = frag->data;
+
+            hdr_n->disp_size.u8[0] |= SIXLOWPAN_FRAG_N_DISP;
+            hdr_n->offset = (uint8_t)(offset >> 3);
+            payload = (uint8_t *)(hdr_n + 1);
+        }
+        memcpy(payload, data, frag_len);
+        LL_PREPEND(frag, netif_snip);
+        DEBUG("6lo minfwd: relay %u bytes at offset %u (tag %u => %u)\n",
+              (unsigned)frag_len, offset, entry->tag, entry->out_tag);
+        gnrc_sixlowpan_dispatch_send(frag, NULL, 0);
+
+        for (unsigned i = offset / 8; i < ((offset + frag_len + 7) / 8); i++) {
+            bf_set(entry->relayed, i);
+        }
+        entry->fwd_size += frag_len;
+        offset += frag_len;
+        data += frag_len;
+        len -= frag_len;
+    }
+    return true;
+}
+
+bool minfwd_start(rbuf_t *rbuf)
+{
+    gnrc_pktsnip_t *pkt = rbuf->super.pkt;
+    ipv6_hdr_t *ipv6_hdr = pkt->data;
+    uint32_t now_usec = xtimer_now_usec();
+    gnrc_ipv6_nib_nc_t nce;
+    gnrc_netif_t *netif;
+    minfwd_t *entry;
+
+    /* let the IPv6 layer handle everything that is not plainly forwarded */
+    if ((pkt->type != GNRC_NETTYPE_IPV6) || (pkt->size < sizeof(ipv6_hdr_t)) ||
+        ipv6_addr_is_multicast(&ipv6_hdr->dst) ||
+        ipv6_addr_is_link_local(&ipv6_hdr->dst) ||
+        ipv6_addr_is_link_local(&ipv6_hdr->src) || (ipv6_hdr->hl <= 1) ||
+        (gnrc_netif_get_by_ipv6_addr(&ipv6_hdr->dst) != NULL)) {
+        return false;
+    }
+    if ((entry = _get_free(now_usec)) == NULL) {
+        DEBUG("6lo minfwd: no space left, reassemble datagram\n");
+        return false;
+    }
+    if (gnrc_ipv6_nib_get_next_hop_l2addr(&ipv6_hdr->dst, NULL, NULL,
+                                          &nce) < 0) {
+        return false;
+    }
+    netif = gnrc_netif_get_by_pid(gnrc_ipv6_nib_nc_get_iface(&nce));
+    if ((netif == NULL) || (netif->sixlo.max_frag_size < MINFWD_MIN_FRAG_SIZE) ||
+        (nce.l2addr_len > sizeof(entry->dst))) {
+        /* next hop is not behind a 6LoWPAN interface */
+        return false;
+    }
+
+    memcpy(entry->src, rbuf->super.src, rbuf->super.src_len);
+    entry->src_len = rbuf->super.src_len;
+    memcpy(entry->dst, nce.l2addr, nce.l2addr_len);
+    entry->dst_len = nce.l2addr_len;
+    entry->out_pid = netif->pid;
+    entry->tag = rbuf->super.tag;
+    entry->out_tag = gnrc_sixlowpan_frag_next_tag();
+    entry->datagram_size = rbuf->datagram_size;
+    entry->fwd_size = 0;
+    memset(entry->relayed, 0, sizeof(entry->relayed));
+    entry->arrival = now_usec;
+    DEBUG("6lo minfwd: forward datagram (tag %u) via interface %u\n",
+          entry->tag, netif->pid);
+
+    ipv6_hdr->hl--;
+    for (rbuf_int_t *ptr = rbuf->ints; ptr != NULL; ptr = ptr->next) {
+        if (!_send(entry, netif, ((uint8_t *)pkt->data) + ptr->start,
+                   ptr->start, ptr->end - ptr->start + 1)) {
+            /* the datagram can't be completed at the next hop anymore */
+            entry->out_pid = KERNEL_PID_UNDEF;
+            break;
+        }
+    }
+    if (entry->fwd_size >= entry->datagram_size) {
+        entry->out_pid = KERNEL_PID_UNDEF;
+    }
+    gnrc_pktbuf_release(pkt);
+    rbuf_rm(rbuf);
+    return true;
+}
+
+bool minfwd_relay(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *frag,
+                  size_t offset)
+{
+    sixlowpan_frag_n_t *hdr = frag->data;
+    uint32_t now_usec = xtimer_now_usec();
+    minfwd_t *entry;
+    gnrc_netif_t *netif;
+
+    entry = _get(gnrc_netif_hdr_get_src_addr(netif_hdr),
+                 netif_hdr->src_l2addr_len,
+                 byteorder_ntohs(hdr->disp_size) & SIXLOWPAN_FRAG_SIZE_MASK,
+                 byteorder_ntohs(hdr->tag), now_usec);
+    if (entry == NULL) {
+        return false;
+    }
+    netif = gnrc_netif_get_by_pid(entry->out_pid);
+    if ((offset == 0) || (netif == NULL) ||
+        (frag->size < sizeof(sixlowpan_frag_n_t)) ||
+        ((offset + frag->size - sizeof(sixlowpan_frag_n_t)) >
+         entry->datagram_size) ||
+        _relayed(entry, offset, frag->size - sizeof(sixlowpan_frag_n_t))) {
+        /* the first fragment was forwarded with the datagram, so this is a
+         * duplicate of it or of a fragment relayed before, or the fragment is
+         * invalid */
+        DEBUG("6lo minfwd: discarding fragment\n");
+        gnrc_pktbuf_release(frag);
+        return true;
+    }
+    entry->arrival = now_usec;
+    if (!_send(entry, netif, (uint8_t *)(hdr + 1), offset,
+               frag->size - sizeof(sixlowpan_frag_n_t)) ||
+        (entry->fwd_size >= entry->datagram_size)) {
+        entry->out_pid = KERNEL_PID_UNDEF;
+    }
+    gnrc_pktbuf_release(frag);
+    return true;
+}
+
+/** @} */
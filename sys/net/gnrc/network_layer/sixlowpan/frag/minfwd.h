@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2018 OverDriveGain
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_sixlowpan_frag
+ * @{
+ *
+ * @file
+ * @internal
+ * @brief   6LoWPAN fragment forwarding
+ *
+ * @author  OverDriveGain
+ */
+#ifndef MINFWD_H
+#define MINFWD_H
+
+#include <stdbool.h>
+
+#include "bitfield.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/pkt.h"
+#include "net/sixlowpan.h"
+
+#include "rbuf.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of 8-byte units in the largest datagram
+ */
+#define MINFWD_UNITS    ((SIXLOWPAN_FRAG_MAX_LEN + 7) / 8)
+
+/**
+ * @brief   A datagram that is forwarded fragment by fragment
+ *
+ * @internal
+ */
+typedef struct {
+    uint8_t src[IEEE802154_LONG_ADDRESS_LEN];   /**< source address */
+    uint8_t dst[IEEE802154_LONG_ADDRESS_LEN];   /**< address of the next hop */
+    uint8_t src_len;                            /**< length of minfwd_t::src */
+    uint8_t dst_len;                            /**< length of minfwd_t::dst */
+    kernel_pid_t out_pid;                       /**< interface to the next hop,
+                                                 *   KERNEL_PID_UNDEF if unused */
+    uint16_t tag;                               /**< datagram tag of the source */
+    uint16_t out_tag;                           /**< datagram tag to the next hop */
+    uint16_t datagram_size;                     /**< size of the datagram */
+    uint16_t fwd_size;                          /**< bytes forwarded so far */
+    BITFIELD(relayed, MINFWD_UNITS);            /**< 8-byte units of the
+                                                 *   datagram forwarded so far */
+    uint32_t arrival;                           /**< time in microseconds of
+                                                 *   arrival of last received
+                                                 *   fragment */
+} minfwd_t;
+
+/**
+ * @brief   Starts forwarding a datagram fragment by fragment if it is not
+ *          for this node
+ *
+ * On success the fragments received so far are sent to the next hop and
+ * @p rbuf is removed from the reassembly buffer.
+ *
+ * @pre The first fragment of the datagram was added to @p rbuf
+ *
+ * @param[in] rbuf  An incomplete datagram in the reassembly buffer
+ *
+ * @return  true, if the datagram is forwarded
+ * @return  false, if the datagram needs to be reassembled
+ */
+bool minfwd_start(rbuf_t *rbuf);
+
+/**
+ * @brief   Relays a fragment if its datagram is forwarded
+ *
+ * The first fragment and fragments overlapping data that was forwarded
+ * already are dropped, so retransmissions don't count towards the size of
+ * the datagram.
+ *
+ * @param[in] netif_hdr The interface header of the fragment
+ * @param[in] frag      The fragment. Released if it was relayed.
+ * @param[in] offset    The fragment's offset
+ *
+ * @return  true, if the fragment was relayed (or dropped)
+ * @return  false, if the fragment is to be added to the reassembly buffer
+ */
+bool minfwd_relay(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *frag,
+                  size_t offset);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MINFWD_H */
+/** @} */
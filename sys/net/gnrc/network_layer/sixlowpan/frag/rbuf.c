@@ -16,6 +16,9 @@
 #include <stdbool.h>
 
 #include "rbuf.h"
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_MINFWD
+#include "minfwd.h"
+#endif
 #include "net/ipv6.h"
 #include "net/ipv6/hdr.h"
 #include "net/gnrc.h"
@@ -46,18 +49,33 @@ static rbuf_int_t rbuf_int[RBUF_INT_SIZE];
 
 static rbuf_t rbuf[RBUF_SIZE];
 
+/* entries in use, hashed by their identifying tuple */
+static rbuf_t *_buckets[RBUF_SIZE];
+/* entries in use, in order of their last received fragment */
+static rbuf_t *_lru;
+static rbuf_t *_free;
+static rbuf_int_t *_free_ints;
+/* bytes of the packet buffer occupied by entries in use */
+static size_t _mem;
+static bool _initialized;
+
 static char l2addr_str[3 * IEEE802154_LONG_ADDRESS_LEN];
 
 static xtimer_t _gc_timer;
 static msg_t _gc_timer_msg = { .type = GNRC_SIXLOWPAN_MSG_FRAG_GC_RBUF };
+static uint32_t _gc_deadline;
 
 /* ------------------------------------
  * internal function definitions
  * ------------------------------------*/
+/* puts all entries and intervals into the free lists */
+static void _rbuf_init(void);
 /* checks whether start and end overlaps, but not identical to, given interval i */
 static inline bool _rbuf_int_overlap_partially(rbuf_int_t *i, uint16_t start, uint16_t end);
 /* gets a free entry from interval buffer */
 static rbuf_int_t *_rbuf_int_get_free(void);
+/* arms the garbage collection timer for the least recently used entry */
+static void _rbuf_arm_gc_timer(void);
 /* update interval buffer of entry */
 static bool _rbuf_update_ints(rbuf_t *entry, uint16_t offset, size_t frag_size);
 /* gets an entry identified by its tupel */
@@ -74,6 +92,14 @@ void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
     uint8_t *data = ((uint8_t *)pkt->data) + sizeof(sixlowpan_frag_t);
     size_t frag_size;
 
+    if (!_initialized) {
+        _rbuf_init();
+    }
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_MINFWD
+    if (minfwd_relay(netif_hdr, pkt, offset)) {
+        return;
+    }
+#endif
     rbuf_gc();
     entry = _rbuf_get(gnrc_netif_hdr_get_src_addr(netif_hdr), netif_hdr->src_l2addr_len,
                       gnrc_netif_hdr_get_dst_addr(netif_hdr), netif_hdr->dst_l2addr_len,
@@ -82,6 +108,7 @@ void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
 
     if (entry == NULL) {
         DEBUG("6lo rbuf: reassembly buffer full.\n");
+        gnrc_pktbuf_release(pkt);
         return;
     }
 
@@ -103,6 +130,7 @@ void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
         DEBUG("6lo rfrag: fragment too big for resulting datagram, discarding datagram\n");
         gnrc_pktbuf_release(entry->super.pkt);
         rbuf_rm(entry);
+        gnrc_pktbuf_release(pkt);
         return;
     }
 
@@ -122,36 +150,70 @@ void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
 
             return;
         }
+        if ((ptr->start == offset) && (ptr->end == (offset + frag_size - 1))) {
+            DEBUG("6lo rfrag: duplicate fragment, ignoring it\n");
+            gnrc_pktbuf_release(pkt);
+            return;
+        }
 
         ptr = ptr->next;
     }
 
-    if (_rbuf_update_ints(entry, offset, frag_size)) {
-        DEBUG("6lo rbuf: add fragment data\n");
-        entry->super.current_size += (uint16_t)frag_size;
-        if (offset == 0) {
+    if (!_rbuf_update_ints(entry, offset, frag_size)) {
+        /* the datagram can't be completed without this fragment, so free its
+         * space right away instead of waiting for the timeout */
+        DEBUG("6lo rfrag: can not track fragment, discarding datagram\n");
+        gnrc_pktbuf_release(entry->super.pkt);
+        rbuf_rm(entry);
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+
+    DEBUG("6lo rbuf: add fragment data\n");
+    entry->super.current_size += (uint16_t)frag_size;
+    if (offset == 0) {
 #ifdef MODULE_GNRC_SIXLOWPAN_IPHC
-            if (sixlowpan_iphc_is(data)) {
-                gnrc_pktsnip_t *frag_hdr = gnrc_pktbuf_mark(pkt,
-                        sizeof(sixlowpan_frag_t), GNRC_NETTYPE_SIXLOWPAN);
-                if (frag_hdr == NULL) {
-                    gnrc_pktbuf_release(entry->super.pkt);
-                    rbuf_rm(entry);
-                    return;
-                }
-                gnrc_sixlowpan_iphc_recv(pkt, &entry->super, 0);
+        if (sixlowpan_iphc_is(data)) {
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_MINFWD
+            uint16_t prev_size = entry->super.current_size - frag_size;
+#endif
+            gnrc_pktsnip_t *frag_hdr = gnrc_pktbuf_mark(pkt,
+                    sizeof(sixlowpan_frag_t), GNRC_NETTYPE_SIXLOWPAN);
+            if (frag_hdr == NULL) {
+                gnrc_pktbuf_release(entry->super.pkt);
+                rbuf_rm(entry);
+                gnrc_pktbuf_release(pkt);
                 return;
             }
-            else
-#endif
-            if (data[0] == SIXLOWPAN_UNCOMP) {
-                data++;
+            gnrc_sixlowpan_iphc_recv(pkt, &entry->super, 0);
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_MINFWD
+            /* datagram is neither complete nor dropped */
+            if (entry->super.pkt != NULL) {
+                /* the first fragment covers the decompressed headers in the
+                 * datagram, not its own length */
+                uint16_t end = entry->ints->end;
+
+                entry->ints->end = entry->super.current_size - prev_size - 1;
+                if (!minfwd_start(entry)) {
+                    entry->ints->end = end;
+                }
             }
+#endif
+            return;
+        }
+        else
+#endif
+        if (data[0] == SIXLOWPAN_UNCOMP) {
+            data++;
         }
-        memcpy(((uint8_t *)entry->super.pkt->data) + offset, data,
-               frag_size);
     }
+    memcpy(((uint8_t *)entry->super.pkt->data) + offset, data, frag_size);
     gnrc_sixlowpan_frag_rbuf_dispatch_when_complete(&entry->super, netif_hdr);
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_MINFWD
+    if ((offset == 0) && (entry->super.pkt != NULL)) {
+        minfwd_start(entry);
+    }
+#endif
     gnrc_pktbuf_release(pkt);
 }
 
@@ -162,15 +224,25 @@ static inline bool _rbuf_int_overlap_partially(rbuf_int_t *i, uint16_t start, ui
         ((start != i->start) || (end != i->end)); /* not identical */
 }
 
-static rbuf_int_t *_rbuf_int_get_free(void)
+static void _rbuf_init(void)
 {
-    for (unsigned int i = 0; i < RBUF_INT_SIZE; i++) {
-        if (rbuf_int[i].end == 0) { /* start must be smaller than end anyways*/
-            return rbuf_int + i;
-        }
+    for (unsigned i = 0; i < RBUF_SIZE; i++) {
+        LL_PREPEND(_free, &rbuf[i]);
+    }
+    for (unsigned i = 0; i < RBUF_INT_SIZE; i++) {
+        LL_PREPEND(_free_ints, &rbuf_int[i]);
     }
+    _initialized = true;
+}
+
+static rbuf_int_t *_rbuf_int_get_free(void)
+{
+    rbuf_int_t *res = _free_ints;
 
-    return NULL;
+    if (res != NULL) {
+        _free_ints = res->next;
+    }
+    return res;
 }
 
 void rbuf_rm(rbuf_t *entry)
@@ -178,13 +250,15 @@ void rbuf_rm(rbuf_t *entry)
     while (entry->ints != NULL) {
         rbuf_int_t *next = entry->ints->next;
 
-        entry->ints->start = 0;
-        entry->ints->end = 0;
-        entry->ints->next = NULL;
+        LL_PREPEND(_free_ints, entry->ints);
         entry->ints = next;
     }
 
+    LL_DELETE(_buckets[entry->hash % RBUF_SIZE], entry);
+    DL_DELETE2(_lru, entry, lru_prev, lru_next);
+    _mem -= entry->datagram_size;
     entry->super.pkt = NULL;
+    LL_PREPEND(_free, entry);
 }
 
 static bool _rbuf_update_ints(rbuf_t *entry, uint16_t offset, size_t frag_size)
@@ -209,7 +283,7 @@ static bool _rbuf_update_ints(rbuf_t *entry, uint16_t offset, size_t frag_size)
     DEBUG("%s, %u, %u)\n", gnrc_netif_addr_to_str(entry->super.dst,
                                                   entry->super.dst_len,
                                                   l2addr_str),
-          (unsigned)entry->super.pkt->size, entry->super.tag);
+          (unsigned)entry->datagram_size, entry->super.tag);
 
     LL_PREPEND(entry->ints, new);
 
@@ -219,85 +293,137 @@ static bool _rbuf_update_ints(rbuf_t *entry, uint16_t offset, size_t frag_size)
 void rbuf_gc(void)
 {
     uint32_t now_usec = xtimer_now_usec();
-    unsigned int i;
-
-    for (i = 0; i < RBUF_SIZE; i++) {
-        /* since pkt occupies pktbuf, aggressivly collect garbage */
-        if ((rbuf[i].super.pkt != NULL) &&
-              ((now_usec - rbuf[i].arrival) > RBUF_TIMEOUT)) {
-            DEBUG("6lo rfrag: entry (%s, ",
-                  gnrc_netif_addr_to_str(rbuf[i].super.src,
-                                         rbuf[i].super.src_len,
-                                         l2addr_str));
-            DEBUG("%s, %u, %u) timed out\n",
-                  gnrc_netif_addr_to_str(rbuf[i].super.dst,
-                                         rbuf[i].super.dst_len,
-                                         l2addr_str),
-                  (unsigned)rbuf[i].super.pkt->size, rbuf[i].super.tag);
 
-            gnrc_pktbuf_release(rbuf[i].super.pkt);
-            rbuf_rm(&(rbuf[i]));
+    /* since pkt occupies pktbuf, aggressivly collect garbage */
+    while ((_lru != NULL) && ((now_usec - _lru->arrival) > RBUF_TIMEOUT)) {
+        DEBUG("6lo rfrag: entry (%s, ",
+              gnrc_netif_addr_to_str(_lru->super.src, _lru->super.src_len,
+                                     l2addr_str));
+        DEBUG("%s, %u, %u) timed out\n",
+              gnrc_netif_addr_to_str(_lru->super.dst, _lru->super.dst_len,
+                                     l2addr_str),
+              (unsigned)_lru->datagram_size, _lru->super.tag);
+
+        gnrc_pktbuf_release(_lru->super.pkt);
+        rbuf_rm(_lru);
+    }
+    _rbuf_arm_gc_timer();
+}
+
+static void _rbuf_arm_gc_timer(void)
+{
+    if (_lru != NULL) {
+        /* one tick past the timeout, so rbuf_gc() removes the entry when the
+         * timer fires */
+        uint32_t deadline = _lru->arrival + RBUF_TIMEOUT + 1;
+
+        /* entries other than the least recently used one don't move the
+         * deadline, so usually there is nothing to do */
+        if (deadline != _gc_deadline) {
+            uint32_t offset = deadline - xtimer_now_usec();
+
+            _gc_deadline = deadline;
+            if (offset > (RBUF_TIMEOUT + 1)) {
+                /* deadline already passed */
+                offset = 0;
+            }
+            xtimer_set_msg(&_gc_timer, offset, &_gc_timer_msg,
+                           sched_active_pid);
         }
     }
 }
 
-static inline void _set_rbuf_timeout(void)
+static uint32_t _fnv1a(uint32_t hash, const uint8_t *data, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        hash = (hash ^ data[i]) * 16777619U;
+    }
+    return hash;
+}
+
+static uint16_t _rbuf_hash(const void *src, size_t src_len,
+                           const void *dst, size_t dst_len,
+                           size_t size, uint16_t tag)
 {
-    xtimer_set_msg(&_gc_timer, RBUF_TIMEOUT, &_gc_timer_msg, sched_active_pid);
+    uint8_t key[4] = { size >> 8, size & 0xff, tag >> 8, tag & 0xff };
+    uint32_t hash = 2166136261U;
+
+    hash = _fnv1a(hash, key, sizeof(key));
+    hash = _fnv1a(hash, src, src_len);
+    hash = _fnv1a(hash, dst, dst_len);
+    return (uint16_t)(hash ^ (hash >> 16));
+}
+
+/* chooses the entry to drop for a new datagram from src */
+static rbuf_t *_rbuf_victim(const void *src, size_t src_len)
+{
+    rbuf_t *own = NULL;
+    unsigned own_count = 0;
+
+    for (rbuf_t *entry = _lru; entry != NULL; entry = entry->lru_next) {
+        if ((entry->super.src_len == src_len) &&
+            (memcmp(entry->super.src, src, src_len) == 0)) {
+            if (own == NULL) {
+                own = entry;
+            }
+            if (++own_count >= GNRC_SIXLOWPAN_FRAG_RBUF_PER_SRC) {
+                /* the source used up its share, replace its oldest datagram */
+                return own;
+            }
+        }
+    }
+    return _lru;
 }
 
 static rbuf_t *_rbuf_get(const void *src, size_t src_len,
                          const void *dst, size_t dst_len,
                          size_t size, uint16_t tag, unsigned page)
 {
-    rbuf_t *res = NULL, *oldest = NULL;
+    rbuf_t *res;
     uint32_t now_usec = xtimer_now_usec();
-
-    for (unsigned int i = 0; i < RBUF_SIZE; i++) {
-        /* check first if entry already available */
-        if ((rbuf[i].super.pkt != NULL) && (rbuf[i].super.pkt->size == size) &&
-            (rbuf[i].super.tag == tag) && (rbuf[i].super.src_len == src_len) &&
-            (rbuf[i].super.dst_len == dst_len) &&
-            (memcmp(rbuf[i].super.src, src, src_len) == 0) &&
-            (memcmp(rbuf[i].super.dst, dst, dst_len) == 0)) {
-            DEBUG("6lo rfrag: entry %p (%s, ", (void *)(&rbuf[i]),
-                  gnrc_netif_addr_to_str(rbuf[i].super.src,
-                                         rbuf[i].super.src_len,
+    uint16_t hash = _rbuf_hash(src, src_len, dst, dst_len, size, tag);
+
+    /* check first if entry already available */
+    for (res = _buckets[hash % RBUF_SIZE]; res != NULL; res = res->next) {
+        if ((res->hash == hash) && (res->datagram_size == size) &&
+            (res->super.tag == tag) && (res->super.src_len == src_len) &&
+            (res->super.dst_len == dst_len) &&
+            (memcmp(res->super.src, src, src_len) == 0) &&
+            (memcmp(res->super.dst, dst, dst_len) == 0)) {
+            DEBUG("6lo rfrag: entry %p (%s, ", (void *)res,
+                  gnrc_netif_addr_to_str(res->super.src, res->super.src_len,
                                          l2addr_str));
             DEBUG("%s, %u, %u) found\n",
-                  gnrc_netif_addr_to_str(rbuf[i].super.dst,
-                                         rbuf[i].super.dst_len,
+                  gnrc_netif_addr_to_str(res->super.dst, res->super.dst_len,
                                          l2addr_str),
-                  (unsigned)rbuf[i].super.pkt->size, rbuf[i].super.tag);
-            rbuf[i].arrival = now_usec;
-            _set_rbuf_timeout();
-            return &(rbuf[i]);
-        }
-
-        /* if there is a free spot: remember it */
-        if ((res == NULL) && (rbuf[i].super.pkt == NULL)) {
-            res = &(rbuf[i]);
+                  (unsigned)res->datagram_size, res->super.tag);
+            res->arrival = now_usec;
+            /* move to the end of the LRU list */
+            DL_DELETE2(_lru, res, lru_prev, lru_next);
+            DL_APPEND2(_lru, res, lru_prev, lru_next);
+            return res;
         }
+    }
 
-        /* remember oldest slot */
-        /* note that xtimer_now will overflow in ~1.2 hours */
-        if ((oldest == NULL) || (oldest->arrival - rbuf[i].arrival < UINT32_MAX / 2)) {
-            oldest = &(rbuf[i]);
-        }
+    if (size > GNRC_SIXLOWPAN_FRAG_RBUF_MEM) {
+        DEBUG("6lo rfrag: datagram exceeds reassembly memory, discarding\n");
+        return NULL;
     }
 
-    /* entry not in buffer and no empty spot found */
-    if (res == NULL) {
-        assert(oldest != NULL);
-        /* if oldest->pkt == NULL, res must not be NULL */
-        assert(oldest->super.pkt != NULL);
-        DEBUG("6lo rfrag: reassembly buffer full, remove oldest entry\n");
-        gnrc_pktbuf_release(oldest->super.pkt);
-        rbuf_rm(oldest);
-        res = oldest;
+    /* entry not in buffer: make room */
+    while ((_free == NULL) || ((_mem + size) > GNRC_SIXLOWPAN_FRAG_RBUF_MEM)) {
+        rbuf_t *victim = _rbuf_victim(src, src_len);
+
+        assert(victim != NULL);
+        DEBUG("6lo rfrag: reassembly buffer full, remove entry %p\n",
+              (void *)victim);
+        gnrc_pktbuf_release(victim->super.pkt);
+        rbuf_rm(victim);
     }
 
     /* now we have an empty spot */
+    res = _free;
+    _free = res->next;
 
     gnrc_nettype_t reass_type;
     switch (page) {
@@ -311,8 +437,23 @@ static rbuf_t *_rbuf_get(const void *src, size_t src_len,
             reass_type = GNRC_NETTYPE_UNDEF;
     }
     res->super.pkt = gnrc_pktbuf_add(NULL, NULL, size, reass_type);
+    /* incomplete datagrams are worth less than the packet buffer space other
+     * layers need, but a new datagram may still take the space of old ones:
+     * as much as its own size, so it can't flush the whole buffer in vain */
+    if ((res->super.pkt == NULL) && (_mem >= size)) {
+        size_t freed = 0;
+
+        while ((res->super.pkt == NULL) && (freed < size)) {
+            DEBUG("6lo rfrag: packet buffer full, remove oldest entry\n");
+            freed += _lru->datagram_size;
+            gnrc_pktbuf_release(_lru->super.pkt);
+            rbuf_rm(_lru);
+            res->super.pkt = gnrc_pktbuf_add(NULL, NULL, size, reass_type);
+        }
+    }
     if (res->super.pkt == NULL) {
         DEBUG("6lo rfrag: can not allocate reassembly buffer space.\n");
+        LL_PREPEND(_free, res);
         return NULL;
     }
 
@@ -325,16 +466,22 @@ static rbuf_t *_rbuf_get(const void *src, size_t src_len,
     res->super.dst_len = dst_len;
     res->super.tag = tag;
     res->super.current_size = 0;
+    res->datagram_size = size;
+    res->hash = hash;
+    res->ints = NULL;
+    LL_PREPEND(_buckets[hash % RBUF_SIZE], res);
+    DL_APPEND2(_lru, res, lru_prev, lru_next);
+    _mem += size;
 
     DEBUG("6lo rfrag: entry %p (%s, ", (void *)res,
           gnrc_netif_addr_to_str(res->super.src, res->super.src_len,
                                  l2addr_str));
     DEBUG("%s, %u, %u) created\n",
           gnrc_netif_addr_to_str(res->super.dst, res->super.dst_len,
-                                 l2addr_str), (unsigned)res->super.pkt->size,
+                                 l2addr_str), (unsigned)res->datagram_size,
           res->super.tag);
 
-    _set_rbuf_timeout();
+    _rbuf_arm_gc_timer();
 
     return res;
 }
@@ -30,7 +30,7 @@
 extern "C" {
 #endif
 
-#define RBUF_SIZE           (4U)               /**< size of the reassembly buffer */
+#define RBUF_SIZE           (GNRC_SIXLOWPAN_FRAG_RBUF_SIZE) /**< size of the reassembly buffer */
 #define RBUF_TIMEOUT        (3U * US_PER_SEC) /**< timeout for reassembly in microseconds */
 
 /**
@@ -60,11 +60,17 @@ typedef struct rbuf_int {
  *
  * @extends gnrc_sixlowpan_rbuf_t
  */
-typedef struct {
+typedef struct rbuf {
     gnrc_sixlowpan_rbuf_t super;        /**< exposed part of the reassembly buffer */
     rbuf_int_t *ints;                   /**< intervals of the fragment */
+    struct rbuf *next;                  /**< next entry in the same hash bucket,
+                                         *   or next free entry */
+    struct rbuf *lru_prev;              /**< previous entry in order of arrival */
+    struct rbuf *lru_next;              /**< next entry in order of arrival */
     uint32_t arrival;                   /**< time in microseconds of arrival of
                                          *   last received fragment */
+    uint16_t datagram_size;             /**< size of the reassembled datagram */
+    uint16_t hash;                      /**< hash of the identifying tuple */
 } rbuf_t;
 
 /**
@@ -89,6 +95,14 @@ void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *frag,
  */
 void rbuf_gc(void);
 
+/**
+ * @brief   Removes an entry from the reassembly buffer
+ *
+ * @note    Does not release rbuf_t::super::pkt. The packet may already be
+ *          released or handed to another layer when this is called.
+ *
+ * @param[in] rbuf  An entry in use
+ */
 void rbuf_rm(rbuf_t *rbuf);
 
 #ifdef __cplusplus
@@ -23,6 +23,8 @@
 #include <stdio.h>
 #include <sys/types.h>
 
+#include "bitarithm.h"
+#include "bitfield.h"
 #include "mutex.h"
 #include "od.h"
 #include "utlist.h"
@@ -33,6 +35,43 @@
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
+#ifdef MODULE_GNRC_PKTBUF_STATIC_SIZECLASS
+#if GNRC_PKTBUF_SIZE > UINT16_MAX
+#error "gnrc_pktbuf_static_sizeclass: GNRC_PKTBUF_SIZE must fit into 16 bit"
+#endif
+
+#define _ALIGNMENT_MASK    (sizeof(uint64_t) - 1)
+#define _GRANULE(off)      ((off) / (_ALIGNMENT_MASK + 1))
+/* usable part of the packet buffer, holes are always multiples of the
+ * alignment */
+#define _PKTBUF_END        (GNRC_PKTBUF_SIZE & ~(_ALIGNMENT_MASK))
+#define _NIL               (UINT16_MAX)
+#define _CLASS_NUMOF       (sizeof(_class_min) / sizeof(_class_min[0]))
+
+/* Header of a hole, the size of a hole is additionally stored in its last
+ * two bytes, so the start of a hole can be found from its end. Both fit into
+ * the smallest possible hole. Holes are referenced by their offset into
+ * _pktbuf. */
+typedef struct {
+    uint16_t next;      /**< next hole of the same size class */
+    uint16_t prev;      /**< previous hole of the same size class */
+    uint16_t size;      /**< size of the hole */
+} _unused_t;
+
+/* minimum hole size of each size class: headers, 6LoWPAN/IEEE 802.15.4 frames
+ * and full IPv6 MTUs get classes of their own */
+static const uint16_t _class_min[] = { 0, 32, 64, 128, 256, 512, 1280 };
+
+static mutex_t _mutex = MUTEX_INIT;
+static uint8_t _pktbuf[GNRC_PKTBUF_SIZE];
+/* first hole of every size class */
+static uint16_t _classes[_CLASS_NUMOF];
+/* bit i is set if size class i has holes */
+static unsigned _class_mask;
+/* marks the first and last granule of every hole to find neighboring holes
+ * on free */
+static BITFIELD(_bounds, _GRANULE(_PKTBUF_END));
+#else
 #define _ALIGNMENT_MASK    (sizeof(_unused_t) - 1)
 
 typedef struct _unused {
@@ -43,6 +82,7 @@ typedef struct _unused {
 static mutex_t _mutex = MUTEX_INIT;
 static uint8_t _pktbuf[GNRC_PKTBUF_SIZE];
 static _unused_t *_first_unused;
+#endif
 
 #ifdef DEVELHELP
 /* maximum number of bytes allocated */
@@ -79,12 +119,84 @@ static inline void _set_pktsnip(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *next,
 #endif
 }
 
+#ifdef MODULE_GNRC_PKTBUF_STATIC_SIZECLASS
+static inline _unused_t *_hole(uint16_t off)
+{
+    return (_unused_t *)&_pktbuf[off];
+}
+
+static inline uint16_t _hole_footer(uint16_t end)
+{
+    uint16_t size;
+
+    /* footer might not be aligned for uint16_t in a hole of arbitrary size */
+    memcpy(&size, &_pktbuf[end - sizeof(size)], sizeof(size));
+    return size;
+}
+
+static inline unsigned _class(size_t size)
+{
+    unsigned cls = _CLASS_NUMOF - 1;
+
+    while (size < _class_min[cls]) {
+        cls--;
+    }
+    return cls;
+}
+
+static void _hole_add(uint16_t off, uint16_t size)
+{
+    _unused_t *hole = _hole(off);
+    unsigned cls = _class(size);
+
+    hole->size = size;
+    hole->prev = _NIL;
+    hole->next = _classes[cls];
+    memcpy(&_pktbuf[off + size - sizeof(size)], &size, sizeof(size));
+    if (hole->next != _NIL) {
+        _hole(hole->next)->prev = off;
+    }
+    _classes[cls] = off;
+    _class_mask |= (1U << cls);
+    bf_set(_bounds, _GRANULE(off));
+    bf_set(_bounds, _GRANULE(off + size - 1));
+}
+
+static void _hole_remove(uint16_t off)
+{
+    _unused_t *hole = _hole(off);
+    unsigned cls = _class(hole->size);
+
+    if (hole->prev == _NIL) {
+        _classes[cls] = hole->next;
+        if (hole->next == _NIL) {
+            _class_mask &= ~(1U << cls);
+        }
+    }
+    else {
+        _hole(hole->prev)->next = hole->next;
+    }
+    if (hole->next != _NIL) {
+        _hole(hole->next)->prev = hole->prev;
+    }
+    bf_unset(_bounds, _GRANULE(off));
+    bf_unset(_bounds, _GRANULE(off + hole->size - 1));
+}
+#endif
+
 void gnrc_pktbuf_init(void)
 {
     mutex_lock(&_mutex);
+#ifdef MODULE_GNRC_PKTBUF_STATIC_SIZECLASS
+    memset(_classes, 0xff, sizeof(_classes));
+    memset(_bounds, 0, sizeof(_bounds));
+    _class_mask = 0;
+    _hole_add(0, _PKTBUF_END);
+#else
     _first_unused = (_unused_t *)_pktbuf;
     _first_unused->next = NULL;
     _first_unused->size = sizeof(_pktbuf);
+#endif
     mutex_unlock(&_mutex);
 }
 
@@ -267,7 +379,7 @@ gnrc_pktsnip_t *gnrc_pktbuf_start_write(gnrc_pktsnip_t *pkt)
 }
 
 #ifdef DEVELHELP
-#ifdef MODULE_OD
+#if defined(MODULE_OD) && !defined(MODULE_GNRC_PKTBUF_STATIC_SIZECLASS)
 static inline void _print_chunk(void *chunk, size_t size, int num)
 {
     printf("=========== chunk %3d (%-10p size: %4u) ===========\n", num, chunk,
@@ -284,14 +396,47 @@ static inline void _print_unused(_unused_t *ptr)
 
 void gnrc_pktbuf_stats(void)
 {
-#ifdef MODULE_OD
-    _unused_t *ptr = _first_unused;
-    uint8_t *chunk = &_pktbuf[0];
-    int count = 0;
+    size_t free_bytes = 0, largest = 0;
+    unsigned holes = 0;
 
     printf("packet buffer: first byte: %p, last byte: %p (size: %u)\n",
            (void *)&_pktbuf[0], (void *)&_pktbuf[GNRC_PKTBUF_SIZE], GNRC_PKTBUF_SIZE);
     printf("  position of last byte used: %" PRIu16 "\n", max_byte_count);
+#ifdef MODULE_GNRC_PKTBUF_STATIC_SIZECLASS
+    for (unsigned cls = 0; cls < _CLASS_NUMOF; cls++) {
+        size_t class_bytes = 0;
+        unsigned class_holes = 0;
+
+        for (uint16_t off = _classes[cls]; off != _NIL; off = _hole(off)->next) {
+            class_bytes += _hole(off)->size;
+            class_holes++;
+            if (_hole(off)->size > largest) {
+                largest = _hole(off)->size;
+            }
+        }
+        printf("  size class >= %4u B: %3u holes, %5u B\n", _class_min[cls],
+               class_holes, (unsigned)class_bytes);
+        free_bytes += class_bytes;
+        holes += class_holes;
+    }
+#else
+    for (_unused_t *ptr = _first_unused; ptr != NULL; ptr = ptr->next) {
+        free_bytes += ptr->size;
+        holes++;
+        if (ptr->size > largest) {
+            largest = ptr->size;
+        }
+    }
+#endif
+    /* share of free memory not usable for an allocation of all free bytes */
+    printf("  free: %u B in %u holes, largest hole: %u B, fragmentation: %u%%\n",
+           (unsigned)free_bytes, holes, (unsigned)largest,
+           (free_bytes) ? (unsigned)(100 - ((largest * 100) / free_bytes)) : 0);
+#if defined(MODULE_OD) && !defined(MODULE_GNRC_PKTBUF_STATIC_SIZECLASS)
+    _unused_t *ptr = _first_unused;
+    uint8_t *chunk = &_pktbuf[0];
+    int count = 0;
+
     if (ptr == NULL) {  /* packet buffer is completely full */
         _print_chunk(chunk, GNRC_PKTBUF_SIZE, count++);
     }
@@ -318,13 +463,59 @@ void gnrc_pktbuf_stats(void)
     if (chunk <= &_pktbuf[GNRC_PKTBUF_SIZE - 1]) {
         _print_chunk(chunk, &_pktbuf[GNRC_PKTBUF_SIZE] - chunk, count);
     }
-#else
-    DEBUG("pktbuf: needs od module\n");
 #endif
 }
 #endif
 
 #ifdef TEST_SUITES
+#ifdef MODULE_GNRC_PKTBUF_STATIC_SIZECLASS
+bool gnrc_pktbuf_is_empty(void)
+{
+    return (_classes[_class(_PKTBUF_END)] == 0) &&
+           (_hole(0)->size == _PKTBUF_END);
+}
+
+bool gnrc_pktbuf_is_sane(void)
+{
+    /* Invariants of this implementation:
+     *  - forall holes: the hole lies within _pktbuf and is aligned
+     *  - forall holes: the hole is in the list of the size class of its size
+     *    and the size class is marked non-empty
+     *  - forall holes: the size is also stored at the end of the hole
+     *  - forall holes: the first and last granule are marked in _bounds and
+     *    the granule following the hole is not the start of another hole
+     *    (adjacent holes are always merged)
+     */
+    for (unsigned cls = 0; cls < _CLASS_NUMOF; cls++) {
+        uint16_t prev = _NIL;
+
+        if ((_classes[cls] == _NIL) == ((_class_mask & (1U << cls)) != 0)) {
+            return false;
+        }
+        for (uint16_t off = _classes[cls]; off != _NIL; off = _hole(off)->next) {
+            _unused_t *hole = _hole(off);
+            unsigned end = off + hole->size;
+
+            if ((off & _ALIGNMENT_MASK) || (hole->size & _ALIGNMENT_MASK) ||
+                (hole->size == 0) || (end > _PKTBUF_END)) {
+                return false;
+            }
+            if ((_class(hole->size) != cls) || (hole->prev != prev) ||
+                (_hole_footer(end) != hole->size)) {
+                return false;
+            }
+            if (!bf_isset(_bounds, _GRANULE(off)) ||
+                !bf_isset(_bounds, _GRANULE(end - 1)) ||
+                ((end < _PKTBUF_END) && bf_isset(_bounds, _GRANULE(end)))) {
+                return false;
+            }
+            prev = off;
+        }
+    }
+
+    return true;
+}
+#else
 bool gnrc_pktbuf_is_empty(void)
 {
     return (_first_unused == (_unused_t *)_pktbuf) &&
@@ -362,6 +553,7 @@ bool gnrc_pktbuf_is_sane(void)
     return true;
 }
 #endif
+#endif
 
 static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, const void *data, size_t size,
                                     gnrc_nettype_t type)
@@ -388,6 +580,76 @@ static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, const void *data, size
     return pkt;
 }
 
+#ifdef MODULE_GNRC_PKTBUF_STATIC_SIZECLASS
+static void *_pktbuf_alloc(size_t size)
+{
+    uint16_t off, hole_size;
+    unsigned cls, larger;
+
+    size = _align(size);
+    cls = _class(size);
+    off = _classes[cls];
+    /* all holes of larger size classes fit, so only the own size class needs
+     * to be searched if there are none */
+    larger = _class_mask & ~((2U << cls) - 1);
+    if ((off == _NIL) || (_hole(off)->size < size)) {
+        if (larger) {
+            off = _classes[bitarithm_lsb(larger)];
+        }
+        else {
+            while ((off != _NIL) && (_hole(off)->size < size)) {
+                off = _hole(off)->next;
+            }
+        }
+    }
+    if (off == _NIL) {
+        DEBUG("pktbuf: no space left in packet buffer\n");
+        return NULL;
+    }
+    hole_size = _hole(off)->size;
+    _hole_remove(off);
+    if (hole_size > size) {
+        _hole_add(off + size, hole_size - size);
+    }
+#ifdef DEVELHELP
+    uint16_t last_byte = (uint16_t)(off + size);
+    if (last_byte > max_byte_count) {
+        max_byte_count = last_byte;
+    }
+#endif
+    return &_pktbuf[off];
+}
+
+static void _pktbuf_free(void *data, size_t size)
+{
+    uint16_t off, end;
+
+    if (!_pktbuf_contains(data)) {
+        return;
+    }
+    off = (uint16_t)((uint8_t *)data - _pktbuf);
+    end = off + _align(size);
+    assert((off & _ALIGNMENT_MASK) == 0);
+    if (end == off) {
+        return;
+    }
+    /* the granule in front of data is in use or the last one of a hole */
+    if ((off > 0) && bf_isset(_bounds, _GRANULE(off - 1))) {
+        uint16_t prev = off - _hole_footer(off);
+
+        _hole_remove(prev);
+        off = prev;
+    }
+    /* the granule behind data is in use or the first one of a hole */
+    if ((end < _PKTBUF_END) && bf_isset(_bounds, _GRANULE(end))) {
+        uint16_t next_size = _hole(end)->size;
+
+        _hole_remove(end);
+        end += next_size;
+    }
+    _hole_add(off, end - off);
+}
+#else
 static void *_pktbuf_alloc(size_t size)
 {
     _unused_t *prev = NULL, *ptr = _first_unused;
@@ -485,6 +747,7 @@ static void _pktbuf_free(void *data, size_t size)
     }
 }
 
+#endif
 
 gnrc_pktsnip_t *gnrc_pktbuf_duplicate_upto(gnrc_pktsnip_t *pkt, gnrc_nettype_t type)
 {
@@ -30,6 +30,7 @@
 #include "internal/option.h"
 #include "internal/eventloop.h"
 #include "internal/rcvbuf.h"
+#include "internal/demux.h"
 
 #ifdef MODULE_GNRC_IPV6
 #include "net/gnrc/ipv6.h"
@@ -119,7 +120,7 @@ static int _gnrc_tcp_open(gnrc_tcp_tcb_t *tcb, char *target_addr, uint16_t targe
                           const char *local_addr, uint16_t local_port, uint8_t passive)
 {
     msg_t msg;
-    xtimer_t connection_timeout;
+    xtimer_t connection_timeout = { 0 };
     cb_arg_t connection_timeout_arg = {MSG_TYPE_CONNECTION_TIMEOUT, &(tcb->mbox)};
     int8_t ret = 0;
 
@@ -241,6 +242,7 @@ int gnrc_tcp_init(void)
 
     /* Initialize TCB list */
     _list_tcb_head = NULL;
+    _demux_init();
     _rcvbuf_init();
 
     /* Start TCP processing thread */
@@ -321,14 +323,16 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
     assert(data != NULL);
 
     msg_t msg;
-    xtimer_t connection_timeout;
+    xtimer_t connection_timeout = { 0 };
     cb_arg_t connection_timeout_arg = {MSG_TYPE_CONNECTION_TIMEOUT, &(tcb->mbox)};
-    xtimer_t user_timeout;
+    xtimer_t user_timeout = { 0 };
     cb_arg_t user_timeout_arg = {MSG_TYPE_USER_SPEC_TIMEOUT, &(tcb->mbox)};
-    xtimer_t probe_timeout;
+    xtimer_t probe_timeout = { 0 };
     cb_arg_t probe_timeout_arg = {MSG_TYPE_PROBE_TIMEOUT, &(tcb->mbox)};
     uint32_t probe_timeout_duration_us = 0;
     ssize_t ret = 0;
+    size_t sent = 0;
+    uint32_t snd_una;
     bool probing_mode = false;
 
     /* Lock the TCB for this function call */
@@ -340,6 +344,9 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
         return -ENOTCONN;
     }
 
+    /* Nothing is in flight here, bytes beyond snd_una were sent by this call */
+    snd_una = tcb->snd_una;
+
     /* Mark TCB as waiting for incomming messages */
     tcb->status |= STATUS_WAIT_FOR_MSG;
 
@@ -356,8 +363,8 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
         _setup_timeout(&user_timeout, timeout_duration_us, _cb_mbox_put_msg, &user_timeout_arg);
     }
 
-    /* Loop until something was sent and acked */
-    while (ret == 0 || tcb->pkt_retransmit != NULL) {
+    /* Loop until all data was sent and acked */
+    while (ret == 0 && (sent < len || tcb->pkt_retransmit_cnt > 0)) {
         /* Check if the connections state is closed. If so, a reset was received */
         if (tcb->state == FSM_STATE_CLOSED) {
             ret = -ECONNRESET;
@@ -376,9 +383,9 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
                            &probe_timeout_arg);
         }
 
-        /* Try to send data in case there nothing has been sent and we are not probing */
-        if (ret == 0 && !probing_mode) {
-            ret = _fsm(tcb, FSM_EVENT_CALL_SEND, NULL, (void *) data, len);
+        /* Try to send remaining data as long as the window allows it and we are not probing */
+        if (sent < len && !probing_mode) {
+            sent += _fsm(tcb, FSM_EVENT_CALL_SEND, NULL, (uint8_t *) data + sent, len - sent);
         }
 
         /* Wait for responses */
@@ -392,8 +399,11 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
 
             case MSG_TYPE_USER_SPEC_TIMEOUT:
                 DEBUG("gnrc_tcp.c : gnrc_tcp_send() : USER_SPEC_TIMEOUT\n");
+                /* Unacknowledged data is dropped and snd_nxt rewound: Report
+                 * only acknowledged bytes, the caller sends the rest again */
                 _fsm(tcb, FSM_EVENT_CLEAR_RETRANSMIT, NULL, NULL, 0);
-                ret = -ETIMEDOUT;
+                sent = tcb->snd_una - snd_una;
+                ret = (sent > 0) ? (ssize_t) sent : -ETIMEDOUT;
                 break;
 
             case MSG_TYPE_PROBE_TIMEOUT:
@@ -436,19 +446,27 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
     xtimer_remove(&user_timeout);
     tcb->status &= ~STATUS_WAIT_FOR_MSG;
     mutex_unlock(&(tcb->function_lock));
-    return ret;
+    return (ret < 0) ? ret : (ssize_t) sent;
 }
 
-ssize_t gnrc_tcp_recv(gnrc_tcp_tcb_t *tcb, void *data, const size_t max_len,
-                      const uint32_t timeout_duration_us)
+/**
+ * @brief Receives data from the peer, shared by gnrc_tcp_recv() and gnrc_tcp_recv_pkt().
+ *
+ * @param[in,out] tcb                   TCB holding the connection information.
+ * @param[in]     event                 FSM event reading the received data.
+ * @param[out]    data                  Buffer or packet pointer passed to the FSM.
+ * @param[in]     max_len               Maximum number of bytes to read into @p data.
+ * @param[in]     timeout_duration_us   Timeout for receive in microseconds.
+ *
+ * @returns   See gnrc_tcp_recv().
+ */
+static ssize_t _gnrc_tcp_recv(gnrc_tcp_tcb_t *tcb, fsm_event_t event, void *data,
+                              const size_t max_len, const uint32_t timeout_duration_us)
 {
-    assert(tcb != NULL);
-    assert(data != NULL);
-
     msg_t msg;
-    xtimer_t connection_timeout;
+    xtimer_t connection_timeout = { 0 };
     cb_arg_t connection_timeout_arg = {MSG_TYPE_CONNECTION_TIMEOUT, &(tcb->mbox)};
-    xtimer_t user_timeout;
+    xtimer_t user_timeout = { 0 };
     cb_arg_t user_timeout_arg = {MSG_TYPE_USER_SPEC_TIMEOUT, &(tcb->mbox)};
     ssize_t ret = 0;
 
@@ -464,7 +482,7 @@ ssize_t gnrc_tcp_recv(gnrc_tcp_tcb_t *tcb, void *data, const size_t max_len,
 
     /* If this call is non-blocking (timeout_duration_us == 0): Try to read data and return */
     if (timeout_duration_us == 0) {
-        ret = _fsm(tcb, FSM_EVENT_CALL_RECV, NULL, data, max_len);
+        ret = _fsm(tcb, event, NULL, data, max_len);
         if (ret == 0) {
             ret = -EAGAIN;
         }
@@ -495,10 +513,10 @@ ssize_t gnrc_tcp_recv(gnrc_tcp_tcb_t *tcb, void *data, const size_t max_len,
         }
 
         /* Try to read available data */
-        ret = _fsm(tcb, FSM_EVENT_CALL_RECV, NULL, data, max_len);
+        ret = _fsm(tcb, event, NULL, data, max_len);
 
         /* If there was no data: Wait for next packet or until the timeout fires */
-        if (ret <= 0) {
+        if (ret == 0) {
             mbox_get(&(tcb->mbox), &msg);
             switch (msg.type) {
                 case MSG_TYPE_CONNECTION_TIMEOUT:
@@ -531,12 +549,31 @@ ssize_t gnrc_tcp_recv(gnrc_tcp_tcb_t *tcb, void *data, const size_t max_len,
     return ret;
 }
 
+ssize_t gnrc_tcp_recv(gnrc_tcp_tcb_t *tcb, void *data, const size_t max_len,
+                      const uint32_t timeout_duration_us)
+{
+    assert(tcb != NULL);
+    assert(data != NULL);
+
+    return _gnrc_tcp_recv(tcb, FSM_EVENT_CALL_RECV, data, max_len, timeout_duration_us);
+}
+
+ssize_t gnrc_tcp_recv_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **pkt,
+                          const uint32_t timeout_duration_us)
+{
+    assert(tcb != NULL);
+    assert(pkt != NULL);
+
+    *pkt = NULL;
+    return _gnrc_tcp_recv(tcb, FSM_EVENT_CALL_RECV_PKT, pkt, 0, timeout_duration_us);
+}
+
 void gnrc_tcp_close(gnrc_tcp_tcb_t *tcb)
 {
     assert(tcb != NULL);
 
     msg_t msg;
-    xtimer_t connection_timeout;
+    xtimer_t connection_timeout = { 0 };
     cb_arg_t connection_timeout_arg = {MSG_TYPE_CONNECTION_TIMEOUT, &(tcb->mbox)};
 
     /* Lock the TCB for this function call */
@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2018 OverDriveGain
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc
+ * @{
+ *
+ * @file
+ * @brief       Implementation of internal/demux.h
+ *
+ * @author      OverDriveGain
+ * @}
+ */
+
+#include <string.h>
+#include <utlist.h>
+#include "net/af.h"
+#include "internal/common.h"
+#include "internal/fsm.h"
+#include "internal/demux.h"
+
+#ifdef MODULE_GNRC_IPV6
+#include "net/gnrc/ipv6.h"
+#endif
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#if (GNRC_TCP_TCB_HASH_BUCKETS & (GNRC_TCP_TCB_HASH_BUCKETS - 1)) != 0
+#error "GNRC_TCP_TCB_HASH_BUCKETS must be a power of 2"
+#endif
+
+#if (GNRC_TCP_LISTEN_HASH_BUCKETS & (GNRC_TCP_LISTEN_HASH_BUCKETS - 1)) != 0
+#error "GNRC_TCP_LISTEN_HASH_BUCKETS must be a power of 2"
+#endif
+
+/**
+ * @brief Connections, hashed by ports and peer address.
+ */
+static gnrc_tcp_tcb_t *_conns[GNRC_TCP_TCB_HASH_BUCKETS];
+
+/**
+ * @brief Listening connections, hashed by local port.
+ */
+static gnrc_tcp_tcb_t *_listeners[GNRC_TCP_LISTEN_HASH_BUCKETS];
+
+/**
+ * @brief Calculates the hash bucket of a connection (FNV-1a).
+ *
+ * @param[in] local_port   Local port of the connection.
+ * @param[in] peer_port    Peer port of the connection.
+ * @param[in] peer_addr    Peer address of the connection.
+ *
+ * @returns   Index into _conns.
+ */
+static unsigned _conn_hash(const uint16_t local_port, const uint16_t peer_port,
+                           const uint8_t *peer_addr)
+{
+    uint32_t hash = 2166136261U;
+    uint32_t ports = ((uint32_t) local_port << 16) | peer_port;
+
+    for (unsigned i = 0; i < sizeof(ports); i++) {
+        hash = (hash ^ ((ports >> (8 * i)) & 0xff)) * 16777619U;
+    }
+#ifdef MODULE_GNRC_IPV6
+    for (unsigned i = 0; i < sizeof(ipv6_addr_t); i++) {
+        hash = (hash ^ peer_addr[i]) * 16777619U;
+    }
+#else
+    (void) peer_addr;
+#endif
+    return (hash ^ (hash >> 16)) & (GNRC_TCP_TCB_HASH_BUCKETS - 1);
+}
+
+/**
+ * @brief Calculates the hash bucket of a listening connection.
+ *
+ * @param[in] local_port   Local port of the connection.
+ *
+ * @returns   Index into _listeners.
+ */
+static inline unsigned _listener_hash(const uint16_t local_port)
+{
+    return (local_port ^ (local_port >> 8)) & (GNRC_TCP_LISTEN_HASH_BUCKETS - 1);
+}
+
+void _demux_init(void)
+{
+    memset(_conns, 0, sizeof(_conns));
+    memset(_listeners, 0, sizeof(_listeners));
+}
+
+void _demux_remove(gnrc_tcp_tcb_t *tcb)
+{
+    if (tcb->bucket != NULL) {
+        LL_DELETE2(*(tcb->bucket), tcb, bucket_next);
+        tcb->bucket = NULL;
+        tcb->bucket_next = NULL;
+    }
+}
+
+void _demux_update(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
+{
+    _demux_remove(tcb);
+    if (state == FSM_STATE_LISTEN) {
+        tcb->bucket = &_listeners[_listener_hash(tcb->local_port)];
+    }
+    else if (tcb->peer_port != PORT_UNSPEC) {
+#ifdef MODULE_GNRC_IPV6
+        tcb->bucket = &_conns[_conn_hash(tcb->local_port, tcb->peer_port, tcb->peer_addr)];
+#else
+        tcb->bucket = &_conns[_conn_hash(tcb->local_port, tcb->peer_port, NULL)];
+#endif
+    }
+    else {
+        DEBUG("gnrc_tcp_demux.c : _demux_update() : TCB has no peer\n");
+        return;
+    }
+    LL_PREPEND2(*(tcb->bucket), tcb, bucket_next);
+}
+
+gnrc_tcp_tcb_t *_demux_lookup(const uint16_t local_port, const uint16_t peer_port,
+                              const uint8_t *peer_addr)
+{
+    gnrc_tcp_tcb_t *tcb = _conns[_conn_hash(local_port, peer_port, peer_addr)];
+
+    while (tcb) {
+        if (tcb->local_port == local_port && tcb->peer_port == peer_port) {
+#ifdef MODULE_GNRC_IPV6
+            if (tcb->address_family == AF_INET6 &&
+                ipv6_addr_equal((ipv6_addr_t *) tcb->peer_addr, (ipv6_addr_t *) peer_addr)) {
+                break;
+            }
+#else
+            break;
+#endif
+        }
+        tcb = tcb->bucket_next;
+    }
+    return tcb;
+}
+
+gnrc_tcp_tcb_t *_demux_lookup_listener(const uint16_t local_port, const uint8_t *local_addr)
+{
+    gnrc_tcp_tcb_t *tcb = _listeners[_listener_hash(local_port)];
+
+    while (tcb) {
+        if (tcb->local_port == local_port && tcb->state == FSM_STATE_LISTEN) {
+#ifdef MODULE_GNRC_IPV6
+            /* Local address is unspecified or pre configured */
+            if (tcb->address_family == AF_INET6 &&
+                (ipv6_addr_equal((ipv6_addr_t *) tcb->local_addr, (ipv6_addr_t *) local_addr) ||
+                 ipv6_addr_is_unspecified((ipv6_addr_t *) tcb->local_addr))) {
+                break;
+            }
+#else
+            (void) local_addr;
+            break;
+#endif
+        }
+        tcb = tcb->bucket_next;
+    }
+    return tcb;
+}
@@ -26,6 +26,7 @@
 #include "internal/pkt.h"
 #include "internal/fsm.h"
 #include "internal/eventloop.h"
+#include "internal/demux.h"
 
 #ifdef MODULE_GNRC_IPV6
 #include "net/gnrc/ipv6.h"
@@ -165,7 +166,8 @@ static int _receive(gnrc_pktsnip_t *pkt)
     }
 
     /* Validate checksum */
-    if (byteorder_ntohs(hdr->checksum) != _pkt_calc_csum(tcp, ip, pkt)) {
+    if (!gnrc_netif_hdr_csum_valid(pkt) &&
+        (byteorder_ntohs(hdr->checksum) != _pkt_calc_csum(tcp, ip, pkt))) {
         DEBUG("gnrc_tcp_eventloop.c : _receive() : Invalid checksum\n");
         gnrc_pktbuf_release(pkt);
         return -EINVAL;
@@ -173,39 +175,23 @@ static int _receive(gnrc_pktsnip_t *pkt)
 
     /* Find TCB to for this packet */
     mutex_lock(&_list_tcb_lock);
-    tcb = _list_tcb_head;
-    while (tcb) {
 #ifdef MODULE_GNRC_IPV6
-        /* Check if current TCB is fitting for the incomming packet */
-        if (ip->type == GNRC_NETTYPE_IPV6 && tcb->address_family == AF_INET6) {
-            /* If SYN is set, a connection is listening on that port ... */
-            ipv6_addr_t *tmp_addr = NULL;
-            if (syn && tcb->local_port == dst && tcb->state == FSM_STATE_LISTEN) {
-                /* ... and local addr is unspec or pre configured */
-                tmp_addr = &((ipv6_hdr_t *)ip->data)->dst;
-                if (ipv6_addr_equal((ipv6_addr_t *) tcb->local_addr, (ipv6_addr_t *) tmp_addr) ||
-                    ipv6_addr_is_unspecified((ipv6_addr_t *) tcb->local_addr)) {
-                    break;
-                }
-            }
-
-            /* If SYN is not set and the ports match ... */
-            if (!syn && tcb->local_port == dst && tcb->peer_port == src) {
-                /* .. and the IPv6 addresses match */
-                tmp_addr = &((ipv6_hdr_t * )ip->data)->src;
-                if (ipv6_addr_equal((ipv6_addr_t *) tcb->peer_addr, (ipv6_addr_t *) tmp_addr)) {
-                    break;
-                }
-            }
+    if (ip->type == GNRC_NETTYPE_IPV6) {
+        /* If SYN is set, a connection is listening on that port ... */
+        if (syn) {
+            tcb = _demux_lookup_listener(dst, ((ipv6_hdr_t *)ip->data)->dst.u8);
         }
+        /* ... if not, the ports and the peer address must match */
+        else {
+            tcb = _demux_lookup(dst, src, ((ipv6_hdr_t *)ip->data)->src.u8);
+        }
+    }
 #else
-        /* Supress compiler warnings if TCP is build without network layer */
-        (void) syn;
-        (void) src;
-        (void) dst;
+    /* Supress compiler warnings if TCP is build without network layer */
+    (void) syn;
+    (void) src;
+    (void) dst;
 #endif
-        tcb = tcb->next;
-    }
     mutex_unlock(&_list_tcb_lock);
 
     /* Call FSM with event RCVD_PKT if a fitting TCB was found */
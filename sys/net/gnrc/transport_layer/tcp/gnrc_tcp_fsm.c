@@ -26,6 +26,7 @@
 #include "internal/pkt.h"
 #include "internal/option.h"
 #include "internal/rcvbuf.h"
+#include "internal/demux.h"
 #include "internal/fsm.h"
 
 #ifdef MODULE_GNRC_IPV6
@@ -83,14 +84,135 @@ static uint16_t _get_random_local_port(void)
  */
 static int _clear_retransmit(gnrc_tcp_tcb_t *tcb)
 {
-    if (tcb->pkt_retransmit != NULL) {
-        gnrc_pktbuf_release(tcb->pkt_retransmit);
+    if (tcb->pkt_retransmit_cnt > 0) {
+        for (uint8_t i = 0; i < tcb->pkt_retransmit_cnt; i++) {
+            gnrc_pktbuf_release(tcb->pkt_retransmit[i]);
+        }
         xtimer_remove(&(tcb->tim_tout));
-        tcb->pkt_retransmit = NULL;
+        tcb->pkt_retransmit_cnt = 0;
     }
+    tcb->status &= ~(STATUS_RTT_MEASURE | STATUS_LOSS_RECOVERY);
+    tcb->dup_acks = 0;
     return 0;
 }
 
+/**
+ * @brief Calculates the sender maximum segment size.
+ *
+ * @param[in] tcb   TCB holding the connection information.
+ *
+ * @returns   The smaller one of the local and the peers MSS.
+ */
+static inline uint32_t _smss(const gnrc_tcp_tcb_t *tcb)
+{
+    return (tcb->mss < GNRC_TCP_MSS) ? tcb->mss : GNRC_TCP_MSS;
+}
+
+/**
+ * @brief Initializes congestion control (see RFC 5681 and RFC 3390).
+ *
+ * @param[in,out] tcb   TCB holding the congestion control state.
+ */
+static void _cc_init(gnrc_tcp_tcb_t *tcb)
+{
+    uint32_t smss = _smss(tcb);
+    uint32_t iw = (2 * smss > 4380) ? 2 * smss : 4380;
+
+    tcb->snd_cwnd = (4 * smss < iw) ? 4 * smss : iw;
+    tcb->snd_ssthresh = UINT16_MAX;
+    tcb->dup_acks = 0;
+}
+
+/**
+ * @brief Enters loss recovery: halves the slow start threshold.
+ *
+ * @param[in,out] tcb   TCB holding the congestion control state.
+ */
+static void _cc_enter_recovery(gnrc_tcp_tcb_t *tcb)
+{
+    uint32_t smss = _smss(tcb);
+    uint32_t flight = tcb->snd_nxt - tcb->snd_una;
+
+    tcb->snd_ssthresh = (flight / 2 > 2 * smss) ? flight / 2 : 2 * smss;
+    tcb->snd_recover = tcb->snd_nxt;
+    tcb->status |= STATUS_LOSS_RECOVERY;
+}
+
+/**
+ * @brief Retransmits the oldest unacknowledged segment without timer backoff.
+ *
+ * @param[in,out] tcb   TCB holding the retransmit queue.
+ */
+static void _fast_retransmit(gnrc_tcp_tcb_t *tcb)
+{
+    if (tcb->pkt_retransmit_cnt > 0) {
+        gnrc_pktbuf_hold(tcb->pkt_retransmit[0], 1);
+        _pkt_send(tcb, tcb->pkt_retransmit[0], 0, true);
+    }
+}
+
+/**
+ * @brief Processes an ACK acknowledging new data: advances snd_una, cleans up the
+ *        retransmit queue and opens the congestion window.
+ *
+ * @param[in,out] tcb       TCB holding the connection information.
+ * @param[in]     seg_ack   Acknowledgment number of the incomming packet.
+ */
+static void _ack_new_data(gnrc_tcp_tcb_t *tcb, const uint32_t seg_ack)
+{
+    uint32_t acked = seg_ack - tcb->snd_una;
+    uint32_t smss = _smss(tcb);
+
+    tcb->snd_una = seg_ack;
+    tcb->dup_acks = 0;
+    _pkt_acknowledge(tcb, seg_ack);
+
+    if (tcb->status & STATUS_LOSS_RECOVERY) {
+        /* Partial ACK: the next segment was lost as well, retransmit it (see RFC 6582) */
+        if (LSS_32_BIT(seg_ack, tcb->snd_recover)) {
+            tcb->snd_cwnd = ((tcb->snd_cwnd > acked) ? tcb->snd_cwnd - acked : 0) + smss;
+            _fast_retransmit(tcb);
+            return;
+        }
+        /* Full ACK: leave loss recovery, deflate congestion window */
+        tcb->status &= ~STATUS_LOSS_RECOVERY;
+        if (tcb->snd_cwnd > tcb->snd_ssthresh) {
+            tcb->snd_cwnd = tcb->snd_ssthresh;
+        }
+    }
+    /* Slow start */
+    else if (tcb->snd_cwnd < tcb->snd_ssthresh) {
+        tcb->snd_cwnd += (acked < smss) ? acked : smss;
+    }
+    /* Congestion avoidance */
+    else if (tcb->snd_cwnd > 0) {
+        tcb->snd_cwnd += (smss * smss >= tcb->snd_cwnd) ? (smss * smss) / tcb->snd_cwnd : 1;
+    }
+}
+
+/**
+ * @brief Processes a duplicate ACK: triggers fast retransmit and fast recovery.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+static void _ack_duplicate(gnrc_tcp_tcb_t *tcb)
+{
+    uint32_t smss = _smss(tcb);
+
+    tcb->dup_acks += (tcb->dup_acks < UINT8_MAX) ? 1 : 0;
+    if (tcb->status & STATUS_LOSS_RECOVERY) {
+        /* Another segment left the network: inflate congestion window */
+        if (tcb->dup_acks >= DUP_ACK_THRESHOLD) {
+            tcb->snd_cwnd += smss;
+        }
+    }
+    else if (tcb->dup_acks == DUP_ACK_THRESHOLD) {
+        _cc_enter_recovery(tcb);
+        tcb->snd_cwnd = tcb->snd_ssthresh + DUP_ACK_THRESHOLD * smss;
+        _fast_retransmit(tcb);
+    }
+}
+
 /**
  * @brief Restarts timewait timer.
  *
@@ -129,6 +251,7 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
             /* Remove connection from active connections */
             mutex_lock(&_list_tcb_lock);
             LL_DELETE(_list_tcb_head, tcb);
+            _demux_remove(tcb);
             mutex_unlock(&_list_tcb_lock);
 
             /* Free potencially allocated receive buffer */
@@ -159,6 +282,7 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
             if (iter == NULL) {
                 LL_PREPEND(_list_tcb_head, tcb);
             }
+            _demux_update(tcb, state);
             mutex_unlock(&_list_tcb_lock);
             break;
 
@@ -188,10 +312,22 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
                 }
                 LL_PREPEND(_list_tcb_head, tcb);
             }
+            _demux_update(tcb, state);
+            mutex_unlock(&_list_tcb_lock);
+            break;
+
+        case FSM_STATE_SYN_RCVD:
+            /* Peer is known now: Move connection from listening to connected TCBs */
+            mutex_lock(&_list_tcb_lock);
+            _demux_update(tcb, state);
             mutex_unlock(&_list_tcb_lock);
             break;
 
         case FSM_STATE_ESTABLISHED:
+            _cc_init(tcb);
+            tcb->status |= STATUS_NOTIFY_USER;
+            break;
+
         case FSM_STATE_CLOSE_WAIT:
             tcb->status |= STATUS_NOTIFY_USER;
             break;
@@ -221,7 +357,6 @@ static int _fsm_call_open(gnrc_tcp_tcb_t *tcb)
     int ret = 0;
 
     DEBUG("gnrc_tcp_fsm.c : _fsm_call_open()\n");
-    tcb->rcv_wnd = GNRC_TCP_DEFAULT_WINDOW;
 
     if (tcb->status & STATUS_PASSIVE) {
         /* Passive open, T: CLOSED -> LISTEN */
@@ -229,6 +364,7 @@ static int _fsm_call_open(gnrc_tcp_tcb_t *tcb)
             _transition_to(tcb, FSM_STATE_CLOSED);
             return -ENOMEM;
         }
+        tcb->rcv_wnd = _rcvbuf_get_window(tcb);
     }
     else {
         /* Active Open, set TCB values, send SYN, T: CLOSED -> SYN_SENT */
@@ -242,6 +378,7 @@ static int _fsm_call_open(gnrc_tcp_tcb_t *tcb)
             _transition_to(tcb, FSM_STATE_CLOSED);
             return ret;
         }
+        tcb->rcv_wnd = _rcvbuf_get_window(tcb);
 
         /* Send SYN */
         gnrc_pktsnip_t *out_pkt = NULL;
@@ -266,24 +403,60 @@ static int _fsm_call_send(gnrc_tcp_tcb_t *tcb, void *buf, size_t len)
 {
     DEBUG("gnrc_tcp_fsm.c : _fsm_call_send()\n");
 
-    size_t payload = (tcb->snd_una + tcb->snd_wnd) - tcb->snd_nxt;
+    size_t sent = 0;
+    uint32_t smss = _smss(tcb);
+
+    /* Send segments as long as the send and the congestion window are open */
+    while (sent < len && tcb->pkt_retransmit_cnt < GNRC_TCP_RETRANSMIT_QUEUE_SIZE) {
+        uint32_t wnd = (tcb->snd_wnd < tcb->snd_cwnd) ? tcb->snd_wnd : tcb->snd_cwnd;
+        uint32_t flight = tcb->snd_nxt - tcb->snd_una;
+
+        if (wnd <= flight) {
+            break;
+        }
 
-    /* Check if window is open and all packets were transmitted */
-    if (payload > 0 && tcb->snd_wnd > 0 && tcb->pkt_retransmit == NULL) {
         /* Calculate segment size */
-        payload = (payload < GNRC_TCP_MSS) ? payload : GNRC_TCP_MSS;
-        payload = (payload < tcb->mss) ? payload : tcb->mss;
-        payload = (payload < len) ? payload : len;
+        size_t payload = wnd - flight;
+        payload = (payload < smss) ? payload : smss;
+        payload = (payload < len - sent) ? payload : len - sent;
+
+        /* Avoid sending small segments while data is in flight (Silly Window Syndrome) */
+        if (payload == 0 || (payload < smss && payload < len - sent && flight > 0)) {
+            break;
+        }
 
         /* Calculate payload size for this segment */
         gnrc_pktsnip_t *out_pkt = NULL;
         uint16_t seq_con = 0;
-        _pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK | MSK_PSH, tcb->snd_nxt, tcb->rcv_nxt, buf, payload);
+        if (_pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK | MSK_PSH, tcb->snd_nxt, tcb->rcv_nxt,
+                       (uint8_t *) buf + sent, payload) < 0) {
+            break;
+        }
         _pkt_setup_retransmit(tcb, out_pkt, false);
         _pkt_send(tcb, out_pkt, seq_con, false);
-        return payload;
+        sent += payload;
+    }
+    return sent;
+}
+
+/**
+ * @brief Announces a window update after the user consumed received data.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+static void _update_rcv_wnd(gnrc_tcp_tcb_t *tcb)
+{
+    /* If receive buffer can store more than GNRC_TCP_MSS: open window to available buffer size */
+    uint16_t wnd = _rcvbuf_get_window(tcb);
+    if (wnd >= GNRC_TCP_MSS) {
+        tcb->rcv_wnd = wnd;
+
+        /* Send ACK to anounce window update */
+        gnrc_pktsnip_t *out_pkt = NULL;
+        uint16_t seq_con = 0;
+        _pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK, tcb->snd_nxt, tcb->rcv_nxt, NULL, 0);
+        _pkt_send(tcb, out_pkt, seq_con, false);
     }
-    return 0;
 }
 
 /**
@@ -299,23 +472,36 @@ static int _fsm_call_recv(gnrc_tcp_tcb_t *tcb, void *buf, size_t len)
 {
     DEBUG("gnrc_tcp_fsm.c : _fsm_call_recv()\n");
 
-    if (ringbuffer_empty(&tcb->rcv_buf)) {
+    /* Read data into 'buf' up to 'len' bytes from receive buffer */
+    size_t rcvd = _rcvbuf_read(tcb, buf, len);
+    if (rcvd == 0) {
         return 0;
     }
+    _update_rcv_wnd(tcb);
+    return rcvd;
+}
 
-    /* Read data into 'buf' up to 'len' bytes from receive buffer */
-    size_t rcvd = ringbuffer_get(&(tcb->rcv_buf), buf, len);
+/**
+ * @brief FSM handling function for receiving data as packet.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ * @param[out]    pkt   Packet holding the received data.
+ *
+ * @returns   Number of successfully received bytes.
+ *            -ENOMEM if the received data could not be put into a packet.
+ */
+static int _fsm_call_recv_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **pkt)
+{
+    DEBUG("gnrc_tcp_fsm.c : _fsm_call_recv_pkt()\n");
 
-    /* If receive buffer can store more than GNRC_TCP_MSS: open window to available buffer size */
-    if (ringbuffer_get_free(&tcb->rcv_buf) >= GNRC_TCP_MSS) {
-        tcb->rcv_wnd = ringbuffer_get_free(&(tcb->rcv_buf));
+    /* From now on, keep received segments instead of copying their payload */
+    tcb->status |= STATUS_RCV_PKT;
 
-        /* Send ACK to anounce window update */
-        gnrc_pktsnip_t *out_pkt = NULL;
-        uint16_t seq_con = 0;
-        _pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK, tcb->snd_nxt, tcb->rcv_nxt, NULL, 0);
-        _pkt_send(tcb, out_pkt, seq_con, false);
+    ssize_t rcvd = _rcvbuf_dequeue(tcb, pkt);
+    if (rcvd <= 0) {
+        return rcvd;
     }
+    _update_rcv_wnd(tcb);
     return rcvd;
 }
 
@@ -448,24 +634,19 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
             uint16_t dst = byteorder_ntohs(tcp_hdr->dst_port);
 
             /* Check if SYN request is handled by another connection */
-            lst = _list_tcb_head;
-            while (lst) {
-                /* Compare port numbers and network layer adresses */
-                if (lst->local_port == dst && lst->peer_port == src) {
 #ifdef MODULE_GNRC_IPV6
-                    if (snp->type == GNRC_NETTYPE_IPV6 && lst->address_family == AF_INET6) {
-                        ipv6_addr_t *dst_addr = &((ipv6_hdr_t *)ip)->dst;
-                        ipv6_addr_t *src_addr = &((ipv6_hdr_t *)ip)->src;
-
-                        if (ipv6_addr_equal((ipv6_addr_t *)lst->local_addr, dst_addr) &&
-                            ipv6_addr_equal((ipv6_addr_t *)lst->peer_addr, src_addr)) {
-                            break;
-                        }
-                    }
-#endif
+            if (snp->type == GNRC_NETTYPE_IPV6) {
+                mutex_lock(&_list_tcb_lock);
+                lst = _demux_lookup(dst, src, ((ipv6_hdr_t *)ip)->src.u8);
+                mutex_unlock(&_list_tcb_lock);
+
+                /* Compare network layer adresses */
+                if (lst != NULL && !ipv6_addr_equal((ipv6_addr_t *)lst->local_addr,
+                                                    &((ipv6_hdr_t *)ip)->dst)) {
+                    lst = NULL;
                 }
-                lst = lst->next;
             }
+#endif
             /* Return if connection is already handled (port and addresses match) */
             if (lst != NULL) {
                 DEBUG("gnrc_tcp_fsm.c : _fsm_rcvd_pkt() : Connection already handled\n");
@@ -505,6 +686,7 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
             tcb->snd_una = tcb->iss;
             tcb->snd_nxt = tcb->iss;
             tcb->snd_wnd = seg_wnd;
+            tcb->rcv_wnd = _rcvbuf_get_window(tcb);
 
             /* Send SYN+ACK: seq_no = iss, ack_no = rcv_nxt, T: LISTEN -> SYN_RCVD */
             _pkt_build(tcb, &out_pkt, &seq_con, MSK_SYN_ACK, tcb->iss, tcb->rcv_nxt, NULL, 0);
@@ -631,8 +813,18 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 tcb->state == FSM_STATE_CLOSING || tcb->state == FSM_STATE_LAST_ACK) {
                 /* Acknowledge previously sent data */
                 if (LSS_32_BIT(tcb->snd_una, seg_ack) && LEQ_32_BIT(seg_ack, tcb->snd_nxt)) {
-                    tcb->snd_una = seg_ack;
-                    _pkt_acknowledge(tcb, seg_ack);
+                    _ack_new_data(tcb, seg_ack);
+
+                    /* Signal user that data was acknowledged */
+                    tcb->status |= STATUS_NOTIFY_USER;
+                }
+                /* Duplicate ACK: Segment was received out of order by the peer */
+                else if (seg_ack == tcb->snd_una && pay_len == 0 && !(ctl & MSK_FIN) &&
+                         seg_wnd == tcb->snd_wnd && tcb->pkt_retransmit_cnt > 0) {
+                    _ack_duplicate(tcb);
+
+                    /* Signal user that the congestion window might have changed */
+                    tcb->status |= STATUS_NOTIFY_USER;
                 }
                 /* ACK received for something not yet sent: Reply with pure ACK */
                 else if (LSS_32_BIT(tcb->snd_nxt, seg_ack)) {
@@ -656,25 +848,25 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 /* Additional processing */
                 /* Check additionaly if previously sent FIN was acknowledged */
                 if (tcb->state == FSM_STATE_FIN_WAIT_1) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->pkt_retransmit_cnt == 0) {
                         _transition_to(tcb, FSM_STATE_FIN_WAIT_2);
                     }
                 }
                 /* If retransmission queue is empty, acknowledge close operation */
                 if (tcb->state == FSM_STATE_FIN_WAIT_2) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->pkt_retransmit_cnt == 0) {
                         /* Optional: Unblock user close operation */
                     }
                 }
                 /* If our FIN has been acknowledged: Transition to TIME_WAIT */
                 if (tcb->state == FSM_STATE_CLOSING) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->pkt_retransmit_cnt == 0) {
                         _transition_to(tcb, FSM_STATE_TIME_WAIT);
                     }
                 }
                 /* If our FIN was acknowledged and status is LAST_ACK: close connection */
                 if (tcb->state == FSM_STATE_LAST_ACK) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->pkt_retransmit_cnt == 0) {
                         _transition_to(tcb, FSM_STATE_CLOSED);
                         return 0;
                     }
@@ -694,13 +886,21 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
 
                 /* Accept only data that is expected, to be received */
                 if (tcb->rcv_nxt == seg_seq) {
-                    /* Copy contents into receive buffer */
-                    while (snp && snp->type == GNRC_NETTYPE_UNDEF) {
-                        tcb->rcv_nxt += ringbuffer_add(&(tcb->rcv_buf), snp->data, snp->size);
-                        snp = snp->next;
+                    if (tcb->status & STATUS_RCV_PKT) {
+                        /* Keep segment for gnrc_tcp_recv_pkt(), drop it if the queue is full */
+                        if (_rcvbuf_enqueue(tcb, snp, pay_len) == 0) {
+                            tcb->rcv_nxt += pay_len;
+                        }
+                    }
+                    else {
+                        /* Copy contents into receive buffer */
+                        while (snp && snp->type == GNRC_NETTYPE_UNDEF) {
+                            tcb->rcv_nxt += _rcvbuf_write(tcb, snp->data, snp->size);
+                            snp = snp->next;
+                        }
                     }
                     /* Shrink receive window */
-                    tcb->rcv_wnd = ringbuffer_get_free(&(tcb->rcv_buf));
+                    tcb->rcv_wnd = _rcvbuf_get_window(tcb);
                     /* Notify owner because new data is available */
                     tcb->status |= STATUS_NOTIFY_USER;
                 }
@@ -728,7 +928,7 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 _transition_to(tcb, FSM_STATE_CLOSE_WAIT);
             }
             else if (tcb->state == FSM_STATE_FIN_WAIT_1) {
-                if (tcb->pkt_retransmit == NULL) {
+                if (tcb->pkt_retransmit_cnt == 0) {
                     _transition_to(tcb, FSM_STATE_TIME_WAIT);
                 }
                 else {
@@ -770,9 +970,18 @@ static int _fsm_timeout_timewait(gnrc_tcp_tcb_t *tcb)
 static int _fsm_timeout_retransmit(gnrc_tcp_tcb_t *tcb)
 {
     DEBUG("gnrc_tcp_fsm.c : _fsm_timeout_retransmit()\n");
-    if (tcb->pkt_retransmit != NULL) {
-        _pkt_setup_retransmit(tcb, tcb->pkt_retransmit, true);
-        _pkt_send(tcb, tcb->pkt_retransmit, 0, true);
+    if (tcb->pkt_retransmit_cnt > 0) {
+        /* Reduce slow start threshold once per loss, restart with one segment */
+        if (tcb->retries == 0) {
+            _cc_enter_recovery(tcb);
+        }
+        else {
+            tcb->snd_recover = tcb->snd_nxt;
+        }
+        tcb->snd_cwnd = _smss(tcb);
+        tcb->dup_acks = 0;
+        _pkt_setup_retransmit(tcb, tcb->pkt_retransmit[0], true);
+        _pkt_send(tcb, tcb->pkt_retransmit[0], 0, true);
     }
     else {
         DEBUG("gnrc_tcp_fsm.c : _fsm_timeout_retransmit() : Retransmit queue is empty\n");
@@ -817,6 +1026,10 @@ static int _fsm_send_probe(gnrc_tcp_tcb_t *tcb)
 /**
  * @brief FSM Handling Function for clearing the retransmit queue.
  *
+ * @note Unacknowledged data is given back to the user: snd_nxt is rewound to
+ *       snd_una, so the next call of gnrc_tcp_send() continues the stream right
+ *       after the last acknowledged byte instead of leaving a hole in it.
+ *
  * @param[in,out] tcb   TCB holding the connection information.
  *
  * @returns   Zero on success.
@@ -825,6 +1038,7 @@ static int _fsm_clear_retransmit(gnrc_tcp_tcb_t *tcb)
 {
     DEBUG("gnrc_tcp_fsm.c : _fsm_clear_retransmit()\n");
     _clear_retransmit(tcb);
+    tcb->snd_nxt = tcb->snd_una;
     return 0;
 }
 
@@ -858,6 +1072,9 @@ static int _fsm_unprotected(gnrc_tcp_tcb_t *tcb, fsm_event_t event, gnrc_pktsnip
         case FSM_EVENT_CALL_RECV :
             ret = _fsm_call_recv(tcb, buf, len);
             break;
+        case FSM_EVENT_CALL_RECV_PKT :
+            ret = _fsm_call_recv_pkt(tcb, (gnrc_pktsnip_t **) buf);
+            break;
         case FSM_EVENT_CALL_CLOSE :
             ret = _fsm_call_close(tcb);
             break;
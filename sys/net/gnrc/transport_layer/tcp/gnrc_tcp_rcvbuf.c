@@ -16,86 +16,381 @@
  * @author      Simon Brummer <simon.brummer@posteo.de>
  */
 #include <errno.h>
+#include <string.h>
+#include "net/gnrc/pktbuf.h"
+#include "internal/common.h"
 #include "internal/rcvbuf.h"
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
 /**
- * @brief Internal struct holding receive buffers.
+ * @brief Internal struct holding the receive buffer pool.
  */
 rcvbuf_t _static_buf;
 
 /**
- * @brief Initializes all receive buffers.
+ * @brief Initializes the receive buffer pool.
  */
 void _rcvbuf_init(void)
 {
     DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_init() : entry\n");
     mutex_init(&(_static_buf.lock));
-    for (size_t i = 0; i < GNRC_TCP_RCV_BUFFERS; ++i) {
-        _static_buf.entries[i].used = 0;
+    _static_buf.free = NULL;
+    for (size_t i = 0; i < GNRC_TCP_RCV_BUF_CHUNKS; ++i) {
+        _static_buf.chunks[i].next = _static_buf.free;
+        _static_buf.free = &(_static_buf.chunks[i]);
     }
+    _static_buf.free_numof = GNRC_TCP_RCV_BUF_CHUNKS;
+    _static_buf.reserved_numof = 0;
 }
 
 /**
- * @brief Allocate receive buffer.
+ * @brief Allocate receive buffer chunk.
  *
- * @returns   Not NULL if a receive buffer was allocated.
+ * @param[in,out] tcb   TCB the chunk is allocated for. Its reserved chunks
+ *                      are used first, unreserved ones otherwise.
+ *
+ * @returns   Not NULL if a chunk was allocated.
  *            NULL if allocation failed.
  */
-static void* _rcvbuf_alloc(void)
+static rcvbuf_chunk_t *_rcvbuf_alloc(gnrc_tcp_tcb_t *tcb)
 {
-    void *result = NULL;
+    rcvbuf_chunk_t *result = NULL;
     DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_alloc() : Entry\n");
     mutex_lock(&(_static_buf.lock));
-    for (size_t i = 0; i < GNRC_TCP_RCV_BUFFERS; ++i) {
-        if (_static_buf.entries[i].used == 0) {
-            _static_buf.entries[i].used = 1;
-            result = (void *)(_static_buf.entries[i].buffer);
-            break;
-        }
+    if (tcb->rcv_reserved > 0) {
+        tcb->rcv_reserved--;
+        _static_buf.reserved_numof--;
     }
+    else if (_static_buf.free_numof <= _static_buf.reserved_numof) {
+        /* all unused chunks are promised to other connections */
+        mutex_unlock(&(_static_buf.lock));
+        return NULL;
+    }
+    result = _static_buf.free;
+    _static_buf.free = result->next;
+    _static_buf.free_numof--;
+    result->next = NULL;
     mutex_unlock(&(_static_buf.lock));
     return result;
 }
 
 /**
- * @brief Release allocated receive buffer.
+ * @brief Returns the chunks reserved by a connection to the pool.
  *
- * @param[in] buf   Pointer to buffer that should be released.
+ * @param[in,out] tcb   TCB holding the reservation.
  */
-static void _rcvbuf_free(void * const buf)
+static void _rcvbuf_unreserve(gnrc_tcp_tcb_t *tcb)
+{
+    mutex_lock(&(_static_buf.lock));
+    _static_buf.reserved_numof -= tcb->rcv_reserved;
+    tcb->rcv_reserved = 0;
+    mutex_unlock(&(_static_buf.lock));
+}
+
+/**
+ * @brief Release receive buffer chunks.
+ *
+ * @param[in] first   First chunk of the list that should be released.
+ * @param[in] last    Last chunk of the list that should be released.
+ * @param[in] numof   Number of chunks from @p first to @p last.
+ */
+static void _rcvbuf_free(rcvbuf_chunk_t *first, rcvbuf_chunk_t *last, size_t numof)
 {
     DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_free() : Entry\n");
     mutex_lock(&(_static_buf.lock));
-    for (size_t i = 0; i < GNRC_TCP_RCV_BUFFERS; ++i) {
-        if ((_static_buf.entries[i].used == 1) && (buf == _static_buf.entries[i].buffer)) {
-            _static_buf.entries[i].used = 0;
-        }
-    }
+    last->next = _static_buf.free;
+    _static_buf.free = first;
+    _static_buf.free_numof += numof;
     mutex_unlock(&(_static_buf.lock));
 }
 
 int _rcvbuf_get_buffer(gnrc_tcp_tcb_t *tcb)
 {
-    if (tcb->rcv_buf_raw == NULL) {
-        tcb->rcv_buf_raw = _rcvbuf_alloc();
-        if (tcb->rcv_buf_raw == NULL) {
-            DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_get_buffer() : Can't allocate rcv_buf_raw\n");
+    if (tcb->rcv_head == NULL) {
+        tcb->rcv_head = _rcvbuf_alloc(tcb);
+        if (tcb->rcv_head == NULL) {
+            DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_get_buffer() : Can't allocate rcv_head\n");
             return -ENOMEM;
         }
-        else {
-            ringbuffer_init(&tcb->rcv_buf, (char *) tcb->rcv_buf_raw, GNRC_TCP_RCV_BUF_SIZE);
-        }
+        tcb->rcv_tail = tcb->rcv_head;
+        tcb->rcv_read = 0;
+        tcb->rcv_write = 0;
+        tcb->rcv_len = 0;
     }
     return 0;
 }
 
 void _rcvbuf_release_buffer(gnrc_tcp_tcb_t *tcb)
 {
-    if (tcb->rcv_buf_raw != NULL) {
-        _rcvbuf_free(tcb->rcv_buf_raw);
-        tcb->rcv_buf_raw = NULL;
+    if (tcb->rcv_head != NULL) {
+        size_t numof = 1;
+
+        for (rcvbuf_chunk_t *chunk = tcb->rcv_head; chunk != tcb->rcv_tail; chunk = chunk->next) {
+            numof++;
+        }
+        _rcvbuf_free(tcb->rcv_head, tcb->rcv_tail, numof);
+        tcb->rcv_head = NULL;
+        tcb->rcv_tail = NULL;
+        tcb->rcv_len = 0;
+    }
+    _rcvbuf_unreserve(tcb);
+    for (uint8_t i = 0; i < tcb->rcv_pkt_cnt; ++i) {
+        gnrc_pktbuf_release(tcb->rcv_pkt[i]);
+        tcb->rcv_pkt[i] = NULL;
+    }
+    tcb->rcv_pkt_cnt = 0;
+    tcb->rcv_pkt_offset = 0;
+    tcb->rcv_pkt_len = 0;
+}
+
+size_t _rcvbuf_write(gnrc_tcp_tcb_t *tcb, const void *data, size_t len)
+{
+    size_t written = 0;
+
+    if (tcb->rcv_head == NULL) {
+        return 0;
+    }
+    while (written < len && tcb->rcv_len < GNRC_TCP_RCV_BUF_SIZE) {
+        /* Grow buffer if the last chunk is full */
+        if (tcb->rcv_write == GNRC_TCP_RCV_BUF_CHUNK_SIZE) {
+            rcvbuf_chunk_t *chunk = _rcvbuf_alloc(tcb);
+            if (chunk == NULL) {
+                DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_write() : Receive buffer pool exhausted\n");
+                break;
+            }
+            tcb->rcv_tail->next = chunk;
+            tcb->rcv_tail = chunk;
+            tcb->rcv_write = 0;
+        }
+
+        size_t n = GNRC_TCP_RCV_BUF_CHUNK_SIZE - tcb->rcv_write;
+        n = (n < len - written) ? n : len - written;
+        n = (n < GNRC_TCP_RCV_BUF_SIZE - tcb->rcv_len) ? n : GNRC_TCP_RCV_BUF_SIZE - tcb->rcv_len;
+        memcpy(tcb->rcv_tail->data + tcb->rcv_write, (const uint8_t *) data + written, n);
+        tcb->rcv_write += n;
+        tcb->rcv_len += n;
+        written += n;
+    }
+    return written;
+}
+
+/**
+ * @brief Consumes data from the chunk buffer.
+ *
+ * @param[in,out] tcb    TCB holding the receive buffer.
+ * @param[out]    buf    Buffer to copy the data into.
+ * @param[in]     len    Maximum number of bytes to copy.
+ *
+ * @returns   Number of bytes copied into @p buf.
+ */
+static size_t _chunks_read(gnrc_tcp_tcb_t *tcb, void *buf, size_t len)
+{
+    size_t rcvd = 0;
+
+    while (rcvd < len && tcb->rcv_len > 0) {
+        size_t n = GNRC_TCP_RCV_BUF_CHUNK_SIZE - tcb->rcv_read;
+        n = (n < tcb->rcv_len) ? n : tcb->rcv_len;
+        n = (n < len - rcvd) ? n : len - rcvd;
+        memcpy((uint8_t *) buf + rcvd, tcb->rcv_head->data + tcb->rcv_read, n);
+        tcb->rcv_read += n;
+        tcb->rcv_len -= n;
+        rcvd += n;
+
+        /* Shrink buffer: return drained chunk to the pool, keep the last one */
+        if (tcb->rcv_read == GNRC_TCP_RCV_BUF_CHUNK_SIZE && tcb->rcv_head != tcb->rcv_tail) {
+            rcvbuf_chunk_t *chunk = tcb->rcv_head;
+            tcb->rcv_head = chunk->next;
+            tcb->rcv_read = 0;
+            _rcvbuf_free(chunk, chunk, 1);
+        }
+    }
+    /* Reuse the remaining chunk from its start if it was drained */
+    if (tcb->rcv_len == 0) {
+        tcb->rcv_read = 0;
+        tcb->rcv_write = 0;
+    }
+    return rcvd;
+}
+
+/**
+ * @brief Calculates the payload size of a received segment.
+ *
+ * @param[in] pkt   Received segment, starting with its payload.
+ *
+ * @returns   Size of all payload snips of @p pkt.
+ */
+static size_t _payload_len(const gnrc_pktsnip_t *pkt)
+{
+    size_t len = 0;
+
+    while (pkt && pkt->type == GNRC_NETTYPE_UNDEF) {
+        len += pkt->size;
+        pkt = pkt->next;
+    }
+    return len;
+}
+
+/**
+ * @brief Removes the first segment from the segment queue.
+ *
+ * @param[in,out] tcb   TCB holding the segment queue.
+ *
+ * @returns   The removed segment.
+ */
+static gnrc_pktsnip_t *_queue_pop(gnrc_tcp_tcb_t *tcb)
+{
+    gnrc_pktsnip_t *pkt = tcb->rcv_pkt[0];
+
+    tcb->rcv_pkt_cnt--;
+    memmove(tcb->rcv_pkt, tcb->rcv_pkt + 1, tcb->rcv_pkt_cnt * sizeof(tcb->rcv_pkt[0]));
+    tcb->rcv_pkt[tcb->rcv_pkt_cnt] = NULL;
+    tcb->rcv_pkt_offset = 0;
+    return pkt;
+}
+
+/**
+ * @brief Consumes data from the segment queue.
+ *
+ * @param[in,out] tcb    TCB holding the segment queue.
+ * @param[out]    buf    Buffer to copy the data into.
+ * @param[in]     len    Maximum number of bytes to copy.
+ *
+ * @returns   Number of bytes copied into @p buf.
+ */
+static size_t _queue_read(gnrc_tcp_tcb_t *tcb, void *buf, size_t len)
+{
+    size_t rcvd = 0;
+
+    while (rcvd < len && tcb->rcv_pkt_cnt > 0) {
+        size_t skip = tcb->rcv_pkt_offset;
+        gnrc_pktsnip_t *snp = tcb->rcv_pkt[0];
+
+        /* Copy payload snips, skipping what was read before */
+        while (snp && snp->type == GNRC_NETTYPE_UNDEF && rcvd < len) {
+            if (skip >= snp->size) {
+                skip -= snp->size;
+            }
+            else {
+                size_t n = snp->size - skip;
+                n = (n < len - rcvd) ? n : len - rcvd;
+                memcpy((uint8_t *) buf + rcvd, (uint8_t *) snp->data + skip, n);
+                tcb->rcv_pkt_offset += n;
+                tcb->rcv_pkt_len -= n;
+                rcvd += n;
+                skip = 0;
+            }
+            snp = snp->next;
+        }
+
+        /* Release segment if its payload was consumed completely */
+        if (tcb->rcv_pkt_offset >= _payload_len(tcb->rcv_pkt[0])) {
+            gnrc_pktbuf_release(_queue_pop(tcb));
+        }
+    }
+    return rcvd;
+}
+
+size_t _rcvbuf_read(gnrc_tcp_tcb_t *tcb, void *buf, size_t len)
+{
+    size_t rcvd = _chunks_read(tcb, buf, len);
+    return rcvd + _queue_read(tcb, (uint8_t *) buf + rcvd, len - rcvd);
+}
+
+int _rcvbuf_enqueue(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, size_t len)
+{
+    if (tcb->rcv_pkt_cnt >= GNRC_TCP_RCV_PKT_QUEUE_SIZE) {
+        DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_enqueue() : Segment queue is full\n");
+        return -ENOMEM;
+    }
+    gnrc_pktbuf_hold(pkt, 1);
+    tcb->rcv_pkt[tcb->rcv_pkt_cnt++] = pkt;
+    tcb->rcv_pkt_len += len;
+    return 0;
+}
+
+ssize_t _rcvbuf_dequeue(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **pkt)
+{
+    size_t len;
+
+    /* Hand out a queued segment as it is, if nothing was read from it so far */
+    if (tcb->rcv_len == 0) {
+        if (tcb->rcv_pkt_cnt == 0) {
+            return 0;
+        }
+        if (tcb->rcv_pkt_offset == 0) {
+            len = _payload_len(tcb->rcv_pkt[0]);
+            *pkt = _queue_pop(tcb);
+            tcb->rcv_pkt_len -= len;
+            return len;
+        }
+    }
+
+    /* Otherwise copy the chunk buffer or the rest of the first segment */
+    len = (tcb->rcv_len > 0) ? tcb->rcv_len
+                             : _payload_len(tcb->rcv_pkt[0]) - tcb->rcv_pkt_offset;
+    *pkt = gnrc_pktbuf_add(NULL, NULL, len, GNRC_NETTYPE_UNDEF);
+    if (*pkt == NULL) {
+        DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_dequeue() : Can't allocate payload\n");
+        return -ENOMEM;
+    }
+    len = _rcvbuf_read(tcb, (*pkt)->data, len);
+    gnrc_pktbuf_realloc_data(*pkt, len);
+    return len;
+}
+
+uint16_t _rcvbuf_get_window(gnrc_tcp_tcb_t *tcb)
+{
+    if (tcb->rcv_head == NULL) {
+        return 0;
+    }
+
+    /* Segments are queued: one segment of up to GNRC_TCP_MSS bytes per free slot */
+    if (tcb->status & STATUS_RCV_PKT) {
+        size_t used = tcb->rcv_len + tcb->rcv_pkt_len;
+        size_t wnd = (GNRC_TCP_RCV_PKT_QUEUE_SIZE - tcb->rcv_pkt_cnt) * GNRC_TCP_MSS;
+
+        if (used >= GNRC_TCP_RCV_BUF_SIZE) {
+            return 0;
+        }
+        if (wnd > GNRC_TCP_RCV_BUF_SIZE - used) {
+            wnd = GNRC_TCP_RCV_BUF_SIZE - used;
+        }
+        return (wnd < UINT16_MAX) ? wnd : UINT16_MAX;
+    }
+
+    /* Free space in the last chunk plus the chunks reserved in the pool ... */
+    size_t max = (tcb->rcv_len < GNRC_TCP_RCV_BUF_SIZE)
+                 ? GNRC_TCP_RCV_BUF_SIZE - tcb->rcv_len : 0;
+    size_t tail = GNRC_TCP_RCV_BUF_CHUNK_SIZE - tcb->rcv_write;
+    size_t wnd = tail + tcb->rcv_reserved * GNRC_TCP_RCV_BUF_CHUNK_SIZE;
+
+    /* ... aiming at one chunk more than the data waiting for the user. The
+     * window grows while data piles up and shrinks again once it was read ... */
+    size_t target = tcb->rcv_len + GNRC_TCP_RCV_BUF_CHUNK_SIZE;
+    target = (target < max) ? target : max;
+
+    /* ... but never below what the last advertised window still promises */
+    size_t keep = (wnd < tcb->rcv_wnd) ? wnd : tcb->rcv_wnd;
+    keep = (keep > target) ? keep : target;
+
+    mutex_lock(&(_static_buf.lock));
+    while (wnd < target && _static_buf.free_numof > _static_buf.reserved_numof) {
+        tcb->rcv_reserved++;
+        _static_buf.reserved_numof++;
+        wnd += GNRC_TCP_RCV_BUF_CHUNK_SIZE;
+    }
+    while (tcb->rcv_reserved > 0 && wnd - GNRC_TCP_RCV_BUF_CHUNK_SIZE >= keep) {
+        tcb->rcv_reserved--;
+        _static_buf.reserved_numof--;
+        wnd -= GNRC_TCP_RCV_BUF_CHUNK_SIZE;
+    }
+    mutex_unlock(&(_static_buf.lock));
+
+    /* ... limited by the maximum buffer size of a connection */
+    if (wnd > max) {
+        wnd = max;
     }
+    return (wnd < UINT16_MAX) ? wnd : UINT16_MAX;
 }
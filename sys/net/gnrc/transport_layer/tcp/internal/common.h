@@ -49,8 +49,16 @@ extern "C" {
 #define STATUS_ALLOW_ANY_ADDR (1 << 1)
 #define STATUS_NOTIFY_USER    (1 << 2)
 #define STATUS_WAIT_FOR_MSG   (1 << 3)
+#define STATUS_RTT_MEASURE    (1 << 4)
+#define STATUS_LOSS_RECOVERY  (1 << 5)
+#define STATUS_RCV_PKT        (1 << 6)
 /** @} */
 
+/**
+ * @brief Number of duplicate ACKs triggering a fast retransmit (see RFC 5681)
+ */
+#define DUP_ACK_THRESHOLD (3U)
+
 /**
  * @brief Defines for "eventloop" thread settings.
  * @{
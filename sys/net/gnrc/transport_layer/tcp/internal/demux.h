@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2018 OverDriveGain
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_tcp TCP
+ * @ingroup     net_gnrc
+ * @brief       RIOT's TCP implementation for the GNRC network stack.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Hash tables mapping incoming segments to their TCB.
+ *
+ * Connections are hashed by local port, peer port and peer address, listening
+ * connections by their local port only. All functions must be called from a
+ * context where the TCB list is locked.
+ *
+ * @author      OverDriveGain
+ */
+
+#ifndef DEMUX_H
+#define DEMUX_H
+
+#include <stdint.h>
+#include "net/gnrc/tcp/tcb.h"
+#include "fsm.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Initializes the hash tables.
+ */
+void _demux_init(void);
+
+/**
+ * @brief (Re-)inserts a TCB into the hash table matching @p state.
+ *
+ * @note Must be called when @p tcb changes its state, its ports or its peer
+ *       address. The FSM calls it before it assigns @p state to @p tcb.
+ *
+ * @param[in,out] tcb     TCB to insert.
+ * @param[in]     state   State @p tcb is in or about to enter.
+ */
+void _demux_update(gnrc_tcp_tcb_t *tcb, fsm_state_t state);
+
+/**
+ * @brief Removes a TCB from the hash tables.
+ *
+ * @param[in,out] tcb   TCB to remove.
+ */
+void _demux_remove(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Searches the connection a segment belongs to.
+ *
+ * @param[in] local_port   Destination port of the segment.
+ * @param[in] peer_port    Source port of the segment.
+ * @param[in] peer_addr    Source address of the segment.
+ *
+ * @returns   Pointer to the matching TCB.
+ *            NULL if no connection matches.
+ */
+gnrc_tcp_tcb_t *_demux_lookup(const uint16_t local_port, const uint16_t peer_port,
+                              const uint8_t *peer_addr);
+
+/**
+ * @brief Searches a listening connection for a connection request.
+ *
+ * @param[in] local_port   Destination port of the SYN.
+ * @param[in] local_addr   Destination address of the SYN.
+ *
+ * @returns   Pointer to a TCB in state LISTEN bound to @p local_port and either
+ *            @p local_addr or the unspecified address.
+ *            NULL if no connection listens on @p local_port.
+ */
+gnrc_tcp_tcb_t *_demux_lookup_listener(const uint16_t local_port, const uint8_t *local_addr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DEMUX_H */
+/** @} */
@@ -54,6 +54,7 @@ typedef enum {
     FSM_EVENT_CALL_OPEN,          /* User function call: open */
     FSM_EVENT_CALL_SEND,          /* User function call: send */
     FSM_EVENT_CALL_RECV,          /* User function call: recv */
+    FSM_EVENT_CALL_RECV_PKT,      /* User function call: recv_pkt */
     FSM_EVENT_CALL_CLOSE,         /* User function call: close */
     FSM_EVENT_CALL_ABORT,         /* User function call: abort */
     FSM_EVENT_RCVD_PKT,           /* Paket received from peer */
@@ -70,7 +71,9 @@ typedef enum {
  * @param[in,out] tcb     TCB holding the connection information.
  * @param[in]     event   Current event that triggers FSM transition.
  * @param[in]     in_pkt  Incomming packet. Only not NULL in case of event RCVD_PKT.
- * @param[in,out] buf     Buffer for send and receive functions.
+ * @param[in,out] buf     Buffer for send and receive functions. For event
+ *                        CALL_RECV_PKT a pointer to the gnrc_pktsnip_t pointer
+ *                        that takes the received data.
  * @param[in]     len     Number of bytes to send or receive.
  *
  * @returns   Zero on success
@@ -14,7 +14,7 @@
  * @{
  *
  * @file
- * @brief       Functions for allocating and freeing the receive buffer.
+ * @brief       Functions for allocating, filling and draining the receive buffer.
  *
  * @author      Simon Brummer <simon.brummer@posteo.de>
  */
@@ -23,7 +23,9 @@
 #define RCVBUF_H
 
 #include <stdint.h>
+#include <sys/types.h>
 #include "mutex.h"
+#include "net/gnrc/pkt.h"
 #include "net/gnrc/tcp/config.h"
 #include "net/gnrc/tcp/tcb.h"
 
@@ -32,19 +34,23 @@ extern "C" {
 #endif
 
 /**
- * @brief Receive buffer entry.
+ * @brief Receive buffer chunk.
  */
-typedef struct rcvbuf_entry {
-    uint8_t used;                          /**< Flag: Is buffer in use? */
-    uint8_t buffer[GNRC_TCP_RCV_BUF_SIZE]; /**< Receive buffer storage */
-} rcvbuf_entry_t;
+typedef struct rcvbuf_chunk {
+    struct rcvbuf_chunk *next;                 /**< Next chunk of the same buffer */
+    uint8_t data[GNRC_TCP_RCV_BUF_CHUNK_SIZE]; /**< Chunk storage */
+} rcvbuf_chunk_t;
 
 /**
- * @brief   Stuct holding receive buffers.
+ * @brief   Stuct holding the receive buffer pool.
  */
 typedef struct rcvbuf {
-    mutex_t lock;                                 /**< Lock for allocation synchronization */
-    rcvbuf_entry_t entries[GNRC_TCP_RCV_BUFFERS]; /**< Maintained receive buffers */
+    mutex_t lock;                                   /**< Lock for allocation synchronization */
+    rcvbuf_chunk_t *free;                           /**< List of unused chunks */
+    size_t free_numof;                              /**< Number of unused chunks */
+    size_t reserved_numof;                          /**< Number of unused chunks
+                                                     *   reserved by connections */
+    rcvbuf_chunk_t chunks[GNRC_TCP_RCV_BUF_CHUNKS]; /**< Maintained chunks */
 } rcvbuf_t;
 
 /**
@@ -58,17 +64,88 @@ void _rcvbuf_init(void);
  * @param[in,out] tcb   TCB that aquires receive buffer.
  *
  * @returns   Zero  on success.
- *            -ENOMEM if all receive buffers are currently used.
+ *            -ENOMEM if all receive buffer chunks are currently used.
  */
 int _rcvbuf_get_buffer(gnrc_tcp_tcb_t *tcb);
 
 /**
- * @brief Release allocated receive buffer.
+ * @brief Release allocated receive buffer and all queued segments.
  *
  * @param[in,out] tcb   TCB holding the receive buffer that should be released.
  */
 void _rcvbuf_release_buffer(gnrc_tcp_tcb_t *tcb);
 
+/**
+ * @brief Appends data to the receive buffer, growing it by chunks from the pool.
+ *
+ * @param[in,out] tcb    TCB holding the receive buffer.
+ * @param[in]     data   Data to append.
+ * @param[in]     len    Number of bytes in @p data.
+ *
+ * @returns   Number of bytes stored. Less than @p len if the buffer reached
+ *            GNRC_TCP_RCV_BUF_SIZE or the pool ran out of chunks.
+ */
+size_t _rcvbuf_write(gnrc_tcp_tcb_t *tcb, const void *data, size_t len);
+
+/**
+ * @brief Appends a received segment to the segment queue without copying it.
+ *
+ * @param[in,out] tcb   TCB holding the segment queue.
+ * @param[in]     pkt   Received segment, starting with its payload. On success
+ *                      the segment is held until it was consumed.
+ * @param[in]     len   Payload size of @p pkt.
+ *
+ * @returns   Zero on success.
+ *            -ENOMEM if the segment queue is full.
+ */
+int _rcvbuf_enqueue(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, size_t len);
+
+/**
+ * @brief Takes the oldest received data out of the receive buffer.
+ *
+ * Data from the chunk buffer or of a partially read segment is copied into a
+ * new packet, a queued segment is passed on as it is.
+ *
+ * @param[in,out] tcb   TCB holding the receive buffer.
+ * @param[out]    pkt   Packet starting with the payload. Must be released by
+ *                      the caller.
+ *
+ * @returns   Payload size of @p pkt.
+ *            Zero if no data is available.
+ *            -ENOMEM if the data could not be copied into the packet buffer.
+ */
+ssize_t _rcvbuf_dequeue(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **pkt);
+
+/**
+ * @brief Consumes data from the receive buffer, drained chunks return to the
+ *        pool and consumed segments are released.
+ *
+ * @param[in,out] tcb    TCB holding the receive buffer.
+ * @param[out]    buf    Buffer to copy the data into.
+ * @param[in]     len    Maximum number of bytes to copy.
+ *
+ * @returns   Number of bytes copied into @p buf.
+ */
+size_t _rcvbuf_read(gnrc_tcp_tcb_t *tcb, void *buf, size_t len);
+
+/**
+ * @brief Calculates the receive window: the free space of the receive buffer
+ *        plus the chunks reserved for it in the pool. If segments are queued
+ *        instead, the free space of the segment queue.
+ *
+ * The window starts at one chunk. It is reserved to hold one chunk more than
+ * the data waiting for the user, up to GNRC_TCP_RCV_BUF_SIZE and as far as
+ * the pool allows, so it grows while data piles up. Reserved chunks the
+ * target and the last advertised window (tcb->rcv_wnd) no longer need return
+ * to the pool. The windows of all connections never promise more than the
+ * pool holds, and an idle connection holds a single chunk.
+ *
+ * @param[in,out] tcb   TCB holding the receive buffer.
+ *
+ * @returns   Number of bytes the receive buffer can take at the moment.
+ */
+uint16_t _rcvbuf_get_window(gnrc_tcp_tcb_t *tcb);
+
 #ifdef __cplusplus
 }
 #endif
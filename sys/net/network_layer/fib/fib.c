@@ -65,6 +65,405 @@ static void fib_lifetime_to_absolute(uint32_t ms, uint64_t *target)
     *target = xtimer_now_usec64() + (ms * US_PER_MS);
 }
 
+/**
+ * @brief marks the table for a sweep of expired entries
+ * @param[in] arg   the FIB table
+ */
+static void fib_sweep_cb(void *arg)
+{
+    fib_table_t *table = arg;
+
+    table->sweep_pending = 1;
+}
+
+/**
+ * @brief (re-)schedules the sweep of expired entries if the given lifetime
+ *        expires before the currently scheduled one
+ *
+ * @param[in] table     the FIB table
+ * @param[in] lifetime  the absolute lifetime of an entry
+ */
+static void fib_schedule_sweep(fib_table_t *table, uint64_t lifetime)
+{
+    if ((lifetime == FIB_LIFETIME_NO_EXPIRE) ||
+        ((table->next_expiry != 0) && (table->next_expiry <= lifetime))) {
+        return;
+    }
+
+    uint64_t now = xtimer_now_usec64();
+
+    table->next_expiry = lifetime;
+    table->sweep_timer.callback = fib_sweep_cb;
+    table->sweep_timer.arg = table;
+    xtimer_set64(&table->sweep_timer, (lifetime > now) ? (lifetime - now) : 0);
+}
+
+/**
+ * @brief cancels a scheduled sweep of expired entries
+ *
+ * @param[in] table     the FIB table
+ */
+static void fib_cancel_sweep(fib_table_t *table)
+{
+    xtimer_remove(&table->sweep_timer);
+    table->next_expiry = 0;
+    table->sweep_pending = 0;
+}
+
+#ifdef MODULE_FIB_LPM
+/**
+ * @brief returns the bit at position @p pos (MSB first) of @p key
+ */
+static inline unsigned fib_lpm_bit(const uint8_t *key, unsigned pos)
+{
+    return (key[pos >> 3] >> (7 - (pos & 0x7))) & 0x1;
+}
+
+/**
+ * @brief compares the bits [@p from, @p to) of two keys
+ *
+ * @return the position of the first distinct bit, @p to if all bits are equal
+ */
+static unsigned fib_lpm_common_len(const uint8_t *a, const uint8_t *b,
+                                   unsigned from, unsigned to)
+{
+    unsigned pos = from;
+
+    /* compare bitwise up to the next byte boundary, bytewise from there on */
+    while ((pos < to) && (pos & 0x7)) {
+        if (fib_lpm_bit(a, pos) != fib_lpm_bit(b, pos)) {
+            return pos;
+        }
+        pos++;
+    }
+    while (((pos + 8) <= to) && (a[pos >> 3] == b[pos >> 3])) {
+        pos += 8;
+    }
+    while ((pos < to) && (fib_lpm_bit(a, pos) == fib_lpm_bit(b, pos))) {
+        pos++;
+    }
+
+    return pos;
+}
+
+/**
+ * @brief returns the number of significant bits of an entry's destination,
+ *        i.e. 0 for a default route, the prefix length for a network prefix
+ *        and the full address length otherwise
+ */
+static unsigned fib_lpm_key_len(fib_entry_t *entry)
+{
+    universal_address_container_t *global = entry->global;
+    unsigned len = global->address_size << 3;
+    bool is_all_zeros_addr = true;
+
+    for (size_t i = 0; i < global->address_size; ++i) {
+        if (global->address[i] != 0) {
+            is_all_zeros_addr = false;
+            break;
+        }
+    }
+
+    if (is_all_zeros_addr) {
+        return 0;
+    }
+
+    if (entry->global_flags & FIB_FLAG_NET_PREFIX_MASK) {
+        unsigned prefix_len = (entry->global_flags & FIB_FLAG_NET_PREFIX_MASK)
+                              >> FIB_FLAG_NET_PREFIX_SHIFT;
+        if (prefix_len < len) {
+            len = prefix_len;
+        }
+    }
+
+    return len;
+}
+
+/**
+ * @brief takes a node from the index node pool of the table
+ *
+ * @return the initialized node, NULL if the pool is exhausted
+ */
+static fib_lpm_node_t *fib_lpm_node_alloc(fib_table_t *table,
+                                          const uint8_t *key, unsigned len,
+                                          fib_entry_t *entry)
+{
+    if ((table->lpm_free == NULL) && (table->lpm_root == NULL)) {
+        /* the index is empty, so (re-)build the list of unused nodes */
+        for (size_t i = 0; i < table->lpm_nodes_numof; ++i) {
+            table->lpm_nodes[i].child[0] = table->lpm_free;
+            table->lpm_free = &table->lpm_nodes[i];
+        }
+    }
+
+    fib_lpm_node_t *node = table->lpm_free;
+
+    if (node == NULL) {
+        return NULL;
+    }
+
+    table->lpm_free = node->child[0];
+    node->child[0] = NULL;
+    node->child[1] = NULL;
+    node->entry = entry;
+    node->len = len;
+    memset(node->key, 0, sizeof(node->key));
+    memcpy(node->key, key, (len + 7) >> 3);
+
+    return node;
+}
+
+/**
+ * @brief returns a node to the index node pool of the table
+ */
+static void fib_lpm_node_free(fib_table_t *table, fib_lpm_node_t *node)
+{
+    node->entry = NULL;
+    node->child[1] = NULL;
+    node->child[0] = table->lpm_free;
+    table->lpm_free = node;
+}
+
+/**
+ * @brief adds an entry to the index of the table
+ *
+ * @return 0 on success
+ *         -EEXIST if another entry has the same significant bits
+ *         -ENOMEM if the index node pool is exhausted
+ */
+static int fib_lpm_insert(fib_table_t *table, fib_entry_t *entry)
+{
+    const uint8_t *key = entry->global->address;
+    unsigned key_len = fib_lpm_key_len(entry);
+    fib_lpm_node_t **node = &table->lpm_root;
+    unsigned pos = 0;
+
+    while (*node != NULL) {
+        fib_lpm_node_t *cur = *node;
+        unsigned max = (cur->len < key_len) ? cur->len : key_len;
+        unsigned common = fib_lpm_common_len(cur->key, key, pos, max);
+
+        if (common < cur->len) {
+            /* the key diverges from or ends within this node, so split it */
+            fib_lpm_node_t *leaf = fib_lpm_node_alloc(table, key, key_len, entry);
+
+            if (leaf == NULL) {
+                return -ENOMEM;
+            }
+            if (common == key_len) {
+                leaf->child[fib_lpm_bit(cur->key, common)] = cur;
+                *node = leaf;
+                return 0;
+            }
+
+            fib_lpm_node_t *branch = fib_lpm_node_alloc(table, key, common, NULL);
+
+            if (branch == NULL) {
+                fib_lpm_node_free(table, leaf);
+                return -ENOMEM;
+            }
+            branch->child[fib_lpm_bit(key, common)] = leaf;
+            branch->child[fib_lpm_bit(cur->key, common)] = cur;
+            *node = branch;
+            return 0;
+        }
+
+        if (cur->len == key_len) {
+            if (cur->entry != NULL) {
+                return -EEXIST;
+            }
+            cur->entry = entry;
+            return 0;
+        }
+
+        pos = cur->len;
+        node = &cur->child[fib_lpm_bit(key, pos)];
+    }
+
+    *node = fib_lpm_node_alloc(table, key, key_len, entry);
+
+    return (*node == NULL) ? -ENOMEM : 0;
+}
+
+/**
+ * @brief removes an entry from the index of the table
+ */
+static void fib_lpm_remove(fib_table_t *table, fib_entry_t *entry)
+{
+    const uint8_t *key = entry->global->address;
+    unsigned key_len = fib_lpm_key_len(entry);
+    fib_lpm_node_t **parent = NULL;
+    fib_lpm_node_t **node = &table->lpm_root;
+    unsigned pos = 0;
+
+    while (*node != NULL) {
+        fib_lpm_node_t *cur = *node;
+
+        if ((cur->len > key_len) ||
+            (fib_lpm_common_len(cur->key, key, pos, cur->len) < cur->len)) {
+            break;
+        }
+
+        if (cur->len == key_len) {
+            if (cur->entry != entry) {
+                break;
+            }
+
+            cur->entry = NULL;
+            if ((cur->child[0] != NULL) && (cur->child[1] != NULL)) {
+                /* still required as branching node */
+                return;
+            }
+
+            *node = (cur->child[0] != NULL) ? cur->child[0] : cur->child[1];
+            fib_lpm_node_free(table, cur);
+
+            /* a branching parent left with a single child becomes redundant */
+            if ((*node == NULL) && (parent != NULL) && ((*parent)->entry == NULL)) {
+                fib_lpm_node_t *branch = *parent;
+
+                *parent = (branch->child[0] != NULL) ? branch->child[0]
+                                                     : branch->child[1];
+                fib_lpm_node_free(table, branch);
+            }
+            return;
+        }
+
+        pos = cur->len;
+        parent = node;
+        node = &cur->child[fib_lpm_bit(key, pos)];
+    }
+
+    /* the entry was never part of the index */
+    if (table->lpm_unindexed > 0) {
+        table->lpm_unindexed--;
+    }
+}
+
+/**
+ * @brief returns the entry with the longest matching prefix for the given
+ *        destination address using the index of the table
+ *
+ * @see fib_find_entry()
+ */
+static int fib_lpm_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
+                              fib_entry_t **entry_arr, size_t *entry_arr_size)
+{
+    fib_lpm_node_t *node = table->lpm_root;
+    fib_entry_t *match = NULL;
+    unsigned dst_len = dst_size << 3;
+    unsigned pos = 0;
+
+    while ((node != NULL) && (node->len <= dst_len) &&
+           (fib_lpm_common_len(node->key, dst, pos, node->len) == node->len)) {
+        fib_entry_t *entry = node->entry;
+
+        if ((entry != NULL) && (entry->global->address_size == dst_size)) {
+            if (memcmp(entry->global->address, dst, dst_size) == 0) {
+                /* we will not find a better one so we return */
+                entry_arr[0] = entry;
+                *entry_arr_size = 1;
+                return 1;
+            }
+            match = entry;
+        }
+
+        if (node->len == dst_len) {
+            break;
+        }
+        pos = node->len;
+        node = node->child[fib_lpm_bit(dst, pos)];
+    }
+
+    if (match == NULL) {
+        *entry_arr_size = 0;
+        return -EHOSTUNREACH;
+    }
+
+    entry_arr[0] = match;
+    *entry_arr_size = 1;
+    return 0;
+}
+
+/**
+ * @brief resets the index of the table
+ */
+static void fib_lpm_reset(fib_table_t *table)
+{
+    table->lpm_root = NULL;
+    table->lpm_free = NULL;
+    table->lpm_unindexed = 0;
+}
+#endif /* MODULE_FIB_LPM */
+
+/**
+ * @brief removes the given entry
+ *
+ * @param[in] table the FIB table the entry belongs to
+ * @param[in] entry the entry to be removed
+ *
+ * @return 0 on success
+ */
+static int fib_remove(fib_table_t *table, fib_entry_t *entry)
+{
+    if (entry->global != NULL) {
+#ifdef MODULE_FIB_LPM
+        if (table->lpm_nodes != NULL) {
+            fib_lpm_remove(table, entry);
+        }
+#else
+        (void)table;
+#endif
+        universal_address_rem(entry->global);
+    }
+
+    if (entry->next_hop) {
+        universal_address_rem(entry->next_hop);
+    }
+
+    entry->global = NULL;
+    entry->global_flags = 0;
+    entry->next_hop = NULL;
+    entry->next_hop_flags = 0;
+
+    entry->iface_id = KERNEL_PID_UNDEF;
+    entry->lifetime = 0;
+
+    return 0;
+}
+
+/**
+ * @brief removes all entries with an expired lifetime and schedules the
+ *        next sweep for the earliest remaining lifetime
+ *
+ * @param[in] table the FIB table to sweep
+ */
+static void fib_sweep(fib_table_t *table)
+{
+    uint64_t now = xtimer_now_usec64();
+    uint64_t next_expiry = FIB_LIFETIME_NO_EXPIRE;
+
+    fib_cancel_sweep(table);
+
+    for (size_t i = 0; i < table->size; ++i) {
+        uint64_t lifetime = table->data.entries[i].lifetime;
+
+        if ((lifetime == 0) || (lifetime == FIB_LIFETIME_NO_EXPIRE)) {
+            continue;
+        }
+
+        if (lifetime <= now) {
+            /* remove this entry if its lifetime expired */
+            fib_remove(table, &table->data.entries[i]);
+        }
+        else if (lifetime < next_expiry) {
+            next_expiry = lifetime;
+        }
+    }
+
+    fib_schedule_sweep(table, next_expiry);
+}
+
 /**
  * @brief returns pointer to the entry for the given destination address
  *
@@ -78,11 +477,12 @@ static void fib_lifetime_to_absolute(uint32_t ms, uint64_t *target)
  * @return 0 if we found a next-hop prefix
  *         1 if we found the exact address next-hop
  *         -EHOSTUNREACH if no fitting next-hop is available
+ *
+ * Entries with an expired lifetime are removed first if the sweep timer of
+ * the table has fired.
  */
 static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
                           fib_entry_t **entry_arr, size_t *entry_arr_size) {
-    uint64_t now = xtimer_now_usec64();
-
     size_t count = 0;
     size_t prefix_size = 0;
     size_t match_size = dst_size << 3;
@@ -97,6 +497,16 @@ static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
     DEBUG("\n");
 #endif
 
+    if (table->sweep_pending) {
+        fib_sweep(table);
+    }
+
+#ifdef MODULE_FIB_LPM
+    if ((table->lpm_nodes != NULL) && (table->lpm_unindexed == 0)) {
+        return fib_lpm_find_entry(table, dst, dst_size, entry_arr, entry_arr_size);
+    }
+#endif
+
     for (size_t i = 0; i < dst_size; ++i) {
         if (dst[i] != 0) {
             is_all_zeros_addr = false;
@@ -106,29 +516,6 @@ static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
 
     for (size_t i = 0; i < table->size; ++i) {
 
-        /* autoinvalidate if the entry lifetime is not set to not expire */
-        if (table->data.entries[i].lifetime != FIB_LIFETIME_NO_EXPIRE) {
-
-            /* check if the lifetime expired */
-            if (table->data.entries[i].lifetime < now) {
-                /* remove this entry if its lifetime expired */
-                table->data.entries[i].lifetime = 0;
-                table->data.entries[i].global_flags = 0;
-                table->data.entries[i].next_hop_flags = 0;
-                table->data.entries[i].iface_id = KERNEL_PID_UNDEF;
-
-                if (table->data.entries[i].global != NULL) {
-                    universal_address_rem(table->data.entries[i].global);
-                    table->data.entries[i].global = NULL;
-                }
-
-                if (table->data.entries[i].next_hop != NULL) {
-                    universal_address_rem(table->data.entries[i].next_hop);
-                    table->data.entries[i].next_hop = NULL;
-                }
-            }
-        }
-
         if ((prefix_size < (dst_size<<3)) && (table->data.entries[i].global != NULL)) {
 
             int ret_comp = universal_address_compare(table->data.entries[i].global, dst, &match_size);
@@ -192,6 +579,7 @@ static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
 /**
  * @brief updates the next hop the lifetime and the interface id for a given entry
  *
+ * @param[in] table          the FIB table the entry belongs to
  * @param[in] entry          the entry to be updated
  * @param[in] next_hop       the next hop address to be updated
  * @param[in] next_hop_size  the next hop address size
@@ -201,7 +589,7 @@ static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
  * @return 0 if the entry has been updated
  *         -ENOMEM if the entry cannot be updated due to insufficient RAM
  */
-static int fib_upd_entry(fib_entry_t *entry, uint8_t *next_hop,
+static int fib_upd_entry(fib_table_t *table, fib_entry_t *entry, uint8_t *next_hop,
                          size_t next_hop_size, uint32_t next_hop_flags,
                          uint32_t lifetime)
 {
@@ -217,6 +605,7 @@ static int fib_upd_entry(fib_entry_t *entry, uint8_t *next_hop,
 
     if (lifetime != (uint32_t)FIB_LIFETIME_NO_EXPIRE) {
         fib_lifetime_to_absolute(lifetime, &entry->lifetime);
+        fib_schedule_sweep(table, entry->lifetime);
     }
     else {
         entry->lifetime = FIB_LIFETIME_NO_EXPIRE;
@@ -263,47 +652,35 @@ static int fib_create_entry(fib_table_t *table, kernel_pid_t iface_id,
 
                 if (lifetime != (uint32_t) FIB_LIFETIME_NO_EXPIRE) {
                     fib_lifetime_to_absolute(lifetime, &table->data.entries[i].lifetime);
+                    fib_schedule_sweep(table, table->data.entries[i].lifetime);
                 }
                 else {
                     table->data.entries[i].lifetime = FIB_LIFETIME_NO_EXPIRE;
                 }
 
+#ifdef MODULE_FIB_LPM
+                if ((table->lpm_nodes != NULL) &&
+                    (fib_lpm_insert(table, &table->data.entries[i]) != 0)) {
+                    DEBUG("[fib_create_entry] entry not indexed, "
+                          "falling back to linear lookups\n");
+                    table->lpm_unindexed++;
+                }
+#endif
                 return 0;
             }
+
+            if (table->data.entries[i].global != NULL) {
+                /* do not leak the destination if the next hop was rejected */
+                universal_address_rem(table->data.entries[i].global);
+                table->data.entries[i].global = NULL;
+                table->data.entries[i].global_flags = 0;
+            }
         }
     }
 
     return -ENOMEM;
 }
 
-/**
- * @brief removes the given entry
- *
- * @param[in] entry the entry to be removed
- *
- * @return 0 on success
- */
-static int fib_remove(fib_entry_t *entry)
-{
-    if (entry->global != NULL) {
-        universal_address_rem(entry->global);
-    }
-
-    if (entry->next_hop) {
-        universal_address_rem(entry->next_hop);
-    }
-
-    entry->global = NULL;
-    entry->global_flags = 0;
-    entry->next_hop = NULL;
-    entry->next_hop_flags = 0;
-
-    entry->iface_id = KERNEL_PID_UNDEF;
-    entry->lifetime = 0;
-
-    return 0;
-}
-
 /**
  * @brief signals (sends a message to) all registered routing protocols
  *        registered with a matching prefix (usually this should be only one).
@@ -403,7 +780,7 @@ int fib_add_entry(fib_table_t *table,
 
     if (ret == 1) {
         /* we must take the according entry and update the values */
-        ret = fib_upd_entry(entry[0], next_hop, next_hop_size, next_hop_flags, lifetime);
+        ret = fib_upd_entry(table, entry[0], next_hop, next_hop_size, next_hop_flags, lifetime);
     }
     else {
         ret = fib_create_entry(table, iface_id, dst, dst_size, dst_flags,
@@ -433,7 +810,7 @@ int fib_update_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
     if (fib_find_entry(table, dst, dst_size, &(entry[0]), &count) == 1) {
         DEBUG("[fib_update_entry] found entry: %p\n", (void *)(entry[0]));
         /* we must take the according entry and update the values */
-        ret = fib_upd_entry(entry[0], next_hop, next_hop_size, next_hop_flags, lifetime);
+        ret = fib_upd_entry(table, entry[0], next_hop, next_hop_size, next_hop_flags, lifetime);
     }
     else {
         /* we have ambiguous entries, i.e. count > 1
@@ -457,7 +834,7 @@ void fib_remove_entry(fib_table_t *table, uint8_t *dst, size_t dst_size)
 
     if (ret == 1) {
         /* we must take the according entry and update the values */
-        fib_remove(entry[0]);
+        fib_remove(table, entry[0]);
     }
     else {
         /* we have ambiguous entries, i.e. count > 1
@@ -477,7 +854,7 @@ void fib_flush(fib_table_t *table, kernel_pid_t interface)
     for (size_t i = 0; i < table->size; ++i) {
         if ((interface == KERNEL_PID_UNDEF) ||
             (interface == table->data.entries[i].iface_id)) {
-            fib_remove(&table->data.entries[i]);
+            fib_remove(table, &table->data.entries[i]);
         }
     }
 
@@ -596,7 +973,11 @@ void fib_init(fib_table_t *table)
     }
     else {
         memset(table->data.entries, 0, (table->size * sizeof(fib_entry_t)));
+#ifdef MODULE_FIB_LPM
+        fib_lpm_reset(table);
+#endif
     }
+    fib_cancel_sweep(table);
     universal_address_init();
     mutex_unlock(&(table->mtx_access));
 }
@@ -621,7 +1002,11 @@ void fib_deinit(fib_table_t *table)
     }
     else {
         memset(table->data.entries, 0, (table->size * sizeof(fib_entry_t)));
+#ifdef MODULE_FIB_LPM
+        fib_lpm_reset(table);
+#endif
     }
+    fib_cancel_sweep(table);
     universal_address_reset();
     mutex_unlock(&(table->mtx_access));
 }
@@ -195,7 +195,7 @@ static int pthread_rwlock_timedlock(pthread_rwlock_t *rwlock,
         return ETIMEDOUT;
     }
     else {
-        xtimer_t timer;
+        xtimer_t timer = { 0 };
         xtimer_set_wakeup64(&timer, (then - now), sched_active_pid);
         int result = pthread_rwlock_lock(rwlock, is_blocked, is_writer, incr_when_held, true);
         if (result != ETIMEDOUT) {
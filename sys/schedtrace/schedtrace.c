@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2018 OverDriveGain
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_schedtrace
+ * @{
+ *
+ * @file
+ * @brief       Scheduler trace implementation
+ *
+ * @author      OverDriveGain
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "schedtrace.h"
+#include "xtimer.h"
+
+#ifdef CPU_NATIVE
+#include <errno.h>
+#include <fcntl.h>
+#include "native_internal.h"
+#endif
+
+#if (SCHEDTRACE_SIZE & (SCHEDTRACE_SIZE - 1)) != 0
+#error "SCHEDTRACE_SIZE must be a power of 2"
+#endif
+
+static schedtrace_event_t _events[SCHEDTRACE_SIZE];
+/* position after the latest event, only written by the scheduler */
+static volatile uint32_t _count;
+
+/* reason for the context switch, by status of the leaving thread */
+static const uint8_t _reasons[] = {
+    [STATUS_STOPPED] = SCHEDTRACE_EXIT,
+    [STATUS_SLEEPING] = SCHEDTRACE_SLEEP,
+    [STATUS_MUTEX_BLOCKED] = SCHEDTRACE_MUTEX,
+    [STATUS_RECEIVE_BLOCKED] = SCHEDTRACE_MSG,
+    [STATUS_SEND_BLOCKED] = SCHEDTRACE_MSG,
+    [STATUS_REPLY_BLOCKED] = SCHEDTRACE_MSG,
+    [STATUS_FLAG_BLOCKED_ANY] = SCHEDTRACE_FLAGS,
+    [STATUS_FLAG_BLOCKED_ALL] = SCHEDTRACE_FLAGS,
+    [STATUS_MBOX_BLOCKED] = SCHEDTRACE_MBOX,
+    [STATUS_RUNNING] = SCHEDTRACE_YIELD,
+    [STATUS_PENDING] = SCHEDTRACE_YIELD,
+};
+
+static const char *_reason_names[] = {
+    [SCHEDTRACE_EXIT] = "exit",
+    [SCHEDTRACE_SLEEP] = "sleep",
+    [SCHEDTRACE_MUTEX] = "mutex",
+    [SCHEDTRACE_MSG] = "msg",
+    [SCHEDTRACE_FLAGS] = "flags",
+    [SCHEDTRACE_MBOX] = "mbox",
+    [SCHEDTRACE_YIELD] = "yield",
+    [SCHEDTRACE_PREEMPT] = "preempt",
+};
+
+void schedtrace_switch(const thread_t *from, const thread_t *to)
+{
+    schedtrace_event_t *event = &_events[_count & (SCHEDTRACE_SIZE - 1)];
+
+    /* the low level timer is read directly, xtimer_now() may have to extend it */
+    event->time = _xtimer_lltimer_now();
+    event->to = to->pid;
+    if (from) {
+        event->from = from->pid;
+        event->reason = _reasons[from->status];
+        if ((from->status >= STATUS_ON_RUNQUEUE) && (to->priority < from->priority)) {
+            event->reason = SCHEDTRACE_PREEMPT;
+        }
+    }
+    else {
+        event->from = KERNEL_PID_UNDEF;
+        event->reason = SCHEDTRACE_EXIT;
+    }
+    _count++;
+}
+
+unsigned schedtrace_read(uint32_t *pos, schedtrace_event_t *buf, unsigned len)
+{
+    uint32_t start = *pos;
+    uint32_t end = _count;
+    unsigned n;
+
+    /* skip what was overwritten before */
+    if (end - start > SCHEDTRACE_SIZE) {
+        start = end - SCHEDTRACE_SIZE;
+    }
+    n = end - start;
+    n = (n < len) ? n : len;
+    for (unsigned i = 0; i < n; i++) {
+        buf[i] = _events[(start + i) & (SCHEDTRACE_SIZE - 1)];
+    }
+
+    /* drop events the scheduler overwrote while they were copied */
+    end = _count;
+    if (end - start > SCHEDTRACE_SIZE) {
+        unsigned skip = end - start - SCHEDTRACE_SIZE;
+
+        skip = (skip < n) ? skip : n;
+        memmove(buf, buf + skip, (n - skip) * sizeof(*buf));
+        start += skip;
+        n -= skip;
+    }
+    *pos = start + n;
+    return n;
+}
+
+uint32_t schedtrace_count(void)
+{
+    return _count;
+}
+
+const char *schedtrace_reason_str(uint8_t reason)
+{
+    return (reason < SCHEDTRACE_REASON_NUMOF) ? _reason_names[reason] : "unknown";
+}
+
+void schedtrace_print(void)
+{
+    schedtrace_event_t event;
+    uint32_t pos = 0;
+    /* printing may switch context, stop at the events recorded until now */
+    uint32_t end = _count;
+
+    printf("%10s %4s %4s %s\n", "time", "from", "to", "reason");
+    while (((int32_t)(end - pos) > 0) && schedtrace_read(&pos, &event, 1)) {
+        printf("%10lu %4d %4d %s\n", (unsigned long)event.time, (int)event.from,
+               (int)event.to, schedtrace_reason_str(event.reason));
+    }
+}
+
+#ifdef CPU_NATIVE
+int schedtrace_dump(const char *path)
+{
+    schedtrace_event_t event;
+    uint32_t pos = 0;
+    int written = 0;
+    uint32_t end = _count;
+    int fd = real_open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+    if (fd < 0) {
+        return -errno;
+    }
+    while (((int32_t)(end - pos) > 0) && schedtrace_read(&pos, &event, 1)) {
+        char line[48];
+        int len = snprintf(line, sizeof(line), "%lu,%d,%d,%s\n", (unsigned long)event.time,
+                           (int)event.from, (int)event.to,
+                           schedtrace_reason_str(event.reason));
+
+        if (real_write(fd, line, len) != len) {
+            written = -errno;
+            break;
+        }
+        written++;
+    }
+    real_close(fd);
+    return written;
+}
+#endif
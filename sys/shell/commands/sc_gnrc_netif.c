@@ -135,6 +135,18 @@ static int _netif_stats(kernel_pid_t iface, unsigned module, bool reset)
                (unsigned) stats->tx_bytes,
                (unsigned) stats->tx_success,
                (unsigned) stats->tx_failed);
+#ifdef MODULE_GNRC_NETIF_TXQ
+        gnrc_netif_t *netif = gnrc_netif_get_by_pid(iface);
+
+        if ((module == NETSTATS_LAYER2) && (netif != NULL)) {
+            /* the queue length is kept by the interface, a reset of the
+             * statistics must not touch it */
+            printf("            TX queue %u (max: %u)  dropped %u\n",
+                   (unsigned) netif->txq_len,
+                   (unsigned) stats->tx_queue_max,
+                   (unsigned) stats->tx_queue_drops);
+        }
+#endif
         res = 0;
     }
     return res;
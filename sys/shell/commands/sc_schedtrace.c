@@ -0,0 +1,48 @@
+/*
+ * Copyright (C) 2018 OverDriveGain
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_shell_commands
+ * @{
+ *
+ * @file
+ * @brief       Shell command for the scheduler trace
+ *
+ * @author      OverDriveGain
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "schedtrace.h"
+
+int _schedtrace_handler(int argc, char **argv)
+{
+    if (argc == 1) {
+        schedtrace_print();
+        return 0;
+    }
+#ifdef CPU_NATIVE
+    if ((argc == 3) && (strcmp(argv[1], "dump") == 0)) {
+        int res = schedtrace_dump(argv[2]);
+
+        if (res < 0) {
+            printf("error: can't write %s (%d)\n", argv[2], res);
+            return 1;
+        }
+        printf("%d events written to %s\n", res, argv[2]);
+        return 0;
+    }
+    printf("usage: %s [dump <file>]\n", argv[0]);
+#else
+    printf("usage: %s\n", argv[0]);
+#endif
+    return 1;
+}
@@ -71,7 +71,7 @@ void _xtimer_tsleep(uint32_t offset, uint32_t long_offset)
 }
 
 void _xtimer_periodic_wakeup(uint32_t *last_wakeup, uint32_t period) {
-    xtimer_t timer;
+    xtimer_t timer = { 0 };
     mutex_t mutex = MUTEX_INIT;
 
     timer.callback = _callback_unlock_mutex;
@@ -249,7 +249,7 @@ static void _mutex_timeout(void *arg)
 
 int xtimer_mutex_lock_timeout(mutex_t *mutex, uint64_t timeout)
 {
-    xtimer_t t;
+    xtimer_t t = { 0 };
     mutex_thread_t mt = { mutex, (thread_t *)sched_active_thread, 0 };
 
     if (timeout != 0) {
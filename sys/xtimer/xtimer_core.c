@@ -46,6 +46,7 @@ static xtimer_t *long_list_head = NULL;
 
 static void _add_timer_to_list(xtimer_t **list_head, xtimer_t *timer);
 static void _add_timer_to_long_list(xtimer_t **list_head, xtimer_t *timer);
+static xtimer_t *_pop_timer_from_list(xtimer_t **list_head);
 static void _shoot(xtimer_t *timer);
 static void _remove(xtimer_t *timer);
 static inline void _lltimer_set(uint32_t target);
@@ -180,7 +181,6 @@ int _xtimer_set_absolute(xtimer_t *timer, uint32_t target)
 
     DEBUG("timer_set_absolute(): now=%" PRIu32 " target=%" PRIu32 "\n", now, target);
 
-    timer->next = NULL;
     if ((target >= now) && ((target - XTIMER_BACKOFF) < now)) {
         /* backoff */
         xtimer_spin_until(target + XTIMER_BACKOFF);
@@ -224,6 +224,131 @@ int _xtimer_set_absolute(xtimer_t *timer, uint32_t target)
     return res;
 }
 
+#ifdef MODULE_XTIMER_HEAP
+/*
+ * The "lists" are pairing heaps: the list head is the root, next links the
+ * siblings, child the first child and prev points to the left sibling or, for
+ * the first child, to the parent. All of them are ordered by long_target and
+ * target, within the short term lists long_target is the same for all timers.
+ * Insertion is O(1), removal of any timer O(log n) amortized.
+ */
+static inline int _before(const xtimer_t *a, const xtimer_t *b)
+{
+    return (a->long_target < b->long_target) ||
+           ((a->long_target == b->long_target) && (a->target < b->target));
+}
+
+/* links two roots, the one expiring later becomes the first child */
+static xtimer_t *_meld(xtimer_t *a, xtimer_t *b)
+{
+    if (!a) {
+        return b;
+    }
+    if (!b) {
+        return a;
+    }
+    if (_before(b, a)) {
+        xtimer_t *tmp = a;
+        a = b;
+        b = tmp;
+    }
+    b->prev = a;
+    b->next = a->child;
+    if (a->child) {
+        a->child->prev = b;
+    }
+    a->child = b;
+    return a;
+}
+
+/* melds a list of siblings into a single root, pairwise from left to right
+ * and then the pairs from right to left */
+static xtimer_t *_merge_pairs(xtimer_t *first)
+{
+    xtimer_t *pairs = NULL;
+    xtimer_t *root = NULL;
+
+    while (first) {
+        xtimer_t *a = first;
+        xtimer_t *b = first->next;
+
+        first = (b) ? b->next : NULL;
+        a->next = a->prev = NULL;
+        if (b) {
+            b->next = b->prev = NULL;
+        }
+        a = _meld(a, b);
+        a->next = pairs;
+        pairs = a;
+    }
+    while (pairs) {
+        xtimer_t *next = pairs->next;
+
+        pairs->next = NULL;
+        root = _meld(root, pairs);
+        pairs = next;
+    }
+    return root;
+}
+
+static void _add_timer_to_list(xtimer_t **list_head, xtimer_t *timer)
+{
+    timer->next = timer->prev = timer->child = NULL;
+    *list_head = _meld(*list_head, timer);
+}
+
+static void _add_timer_to_long_list(xtimer_t **list_head, xtimer_t *timer)
+{
+    _add_timer_to_list(list_head, timer);
+}
+
+static xtimer_t *_pop_timer_from_list(xtimer_t **list_head)
+{
+    xtimer_t *timer = *list_head;
+
+    *list_head = _merge_pairs(timer->child);
+    timer->child = NULL;
+    return timer;
+}
+
+static int _remove_timer_from_list(xtimer_t **list_head, xtimer_t *timer)
+{
+    xtimer_t *sub;
+
+    if (*list_head == timer) {
+        _pop_timer_from_list(list_head);
+        return 1;
+    }
+    if (!timer->prev) {
+        /* a root, but not of this heap, or in no heap at all */
+        return 0;
+    }
+    /* none of the children expires before the parent of timer, so they can
+     * take its place without touching the rest of the heap */
+    sub = _merge_pairs(timer->child);
+    if (sub) {
+        sub->prev = timer->prev;
+        sub->next = timer->next;
+        if (timer->next) {
+            timer->next->prev = sub;
+        }
+    }
+    else {
+        sub = timer->next;
+        if (sub) {
+            sub->prev = timer->prev;
+        }
+    }
+    if (timer->prev->child == timer) {
+        timer->prev->child = sub;
+    }
+    else {
+        timer->prev->next = sub;
+    }
+    timer->next = timer->prev = timer->child = NULL;
+    return 1;
+}
+#else
 static void _add_timer_to_list(xtimer_t **list_head, xtimer_t *timer)
 {
     while (*list_head && (*list_head)->target <= timer->target) {
@@ -234,6 +359,14 @@ static void _add_timer_to_list(xtimer_t **list_head, xtimer_t *timer)
     *list_head = timer;
 }
 
+static xtimer_t *_pop_timer_from_list(xtimer_t **list_head)
+{
+    xtimer_t *timer = *list_head;
+
+    *list_head = timer->next;
+    return timer;
+}
+
 static void _add_timer_to_long_list(xtimer_t **list_head, xtimer_t *timer)
 {
     while (*list_head
@@ -259,11 +392,13 @@ static int _remove_timer_from_list(xtimer_t **list_head, xtimer_t *timer)
     return 0;
 }
 
+#endif /* MODULE_XTIMER_HEAP */
+
 static void _remove(xtimer_t *timer)
 {
     if (timer_list_head == timer) {
         uint32_t next;
-        timer_list_head = timer->next;
+        _pop_timer_from_list(&timer_list_head);
         if (timer_list_head) {
             /* schedule callback on next timer target time */
             next = timer_list_head->target - XTIMER_OVERHEAD;
@@ -318,6 +453,19 @@ static inline int _this_high_period(uint32_t target)
 #endif
 }
 
+#ifdef MODULE_XTIMER_HEAP
+/**
+ * @brief move the long timers that will expire in the current short timer
+ *        period to the current timer list
+ */
+static void _select_long_timers(void)
+{
+    while (long_list_head && (long_list_head->long_target <= _long_cnt) &&
+           _this_high_period(long_list_head->target)) {
+        _add_timer_to_list(&timer_list_head, _pop_timer_from_list(&long_list_head));
+    }
+}
+#else
 /**
  * @brief compare two timers' target values, return the one with lower value.
  *
@@ -407,6 +555,7 @@ static void _select_long_timers(void)
         }
     }
 }
+#endif /* MODULE_XTIMER_HEAP */
 
 /**
  * @brief handle low-level timer overflow, advance to next short timer period
@@ -475,11 +624,8 @@ overflow:
         /* make sure we don't fire too early */
         while (_time_left(_xtimer_lltimer_mask(timer_list_head->target), reference)) {}
 
-        /* pick first timer in list */
-        xtimer_t *timer = timer_list_head;
-
-        /* advance list */
-        timer_list_head = timer->next;
+        /* pick first timer in list and advance list */
+        xtimer_t *timer = _pop_timer_from_list(&timer_list_head);
 
         /* make sure timer is recognized as being already fired */
         timer->target = 0;
@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2018 OverDriveGain
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures the CoAP request rate of nanocoap depending on the
+ *              number of resources
+ *
+ * @author      OverDriveGain
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "net/nanocoap.h"
+#include "xtimer.h"
+
+#ifndef TEST_REQUESTS
+#define TEST_REQUESTS       (20000U)
+#endif
+
+#define MAX_RESOURCES       (256U)
+#define PATH_LEN            (sizeof("/sensor/000/value"))
+#define BUF_SIZE            (64U)
+
+static const unsigned _numof[] = { 16, 64, 256 };
+
+static char _paths[MAX_RESOURCES][PATH_LEN];
+static coap_resource_t _resources[MAX_RESOURCES];
+static coap_resource_index_entry_t _entries[2 * MAX_RESOURCES];
+static coap_resource_index_t _index;
+static uint8_t _req[MAX_RESOURCES][BUF_SIZE];
+static size_t _req_len[MAX_RESOURCES];
+static uint8_t _resp[BUF_SIZE];
+
+/* nanocoap expects the application to provide a resource table */
+const coap_resource_t coap_resources[] = {
+    COAP_WELL_KNOWN_CORE_DEFAULT_HANDLER,
+};
+const unsigned coap_resources_numof = sizeof(coap_resources) / sizeof(coap_resources[0]);
+
+static ssize_t _handler(coap_pkt_t *pkt, uint8_t *buf, size_t len, void *context)
+{
+    (void)context;
+    return coap_reply_simple(pkt, COAP_CODE_205, buf, len,
+                             COAP_FORMAT_TEXT, (uint8_t *)"1", 1);
+}
+
+/* the search nanocoap and gcoap did before the index, on sorted resources */
+static const coap_resource_t *_find_linear(const char *path, unsigned method_flag,
+                                           unsigned numof)
+{
+    for (unsigned i = 0; i < numof; i++) {
+        const coap_resource_t *resource = &_resources[i];
+
+        if (!(resource->methods & method_flag)) {
+            continue;
+        }
+        int res = strcmp(path, resource->path);
+        if (res > 0) {
+            continue;
+        }
+        else if (res < 0) {
+            break;
+        }
+        return resource;
+    }
+    return NULL;
+}
+
+static int _handle(unsigned i, unsigned numof, bool indexed)
+{
+    coap_pkt_t pkt;
+    uint8_t uri[NANOCOAP_URI_MAX];
+    const coap_resource_t *resource = NULL;
+
+    if ((coap_parse(&pkt, _req[i], _req_len[i]) < 0) ||
+        (coap_get_uri_path(&pkt, uri) <= 0)) {
+        return -1;
+    }
+    unsigned method_flag = coap_method2flag(coap_get_code_detail(&pkt));
+    if (indexed) {
+        coap_resource_index_find(&_index, (char *)uri, method_flag, &resource);
+    }
+    else {
+        resource = _find_linear((char *)uri, method_flag, numof);
+    }
+    if (resource == NULL) {
+        return -1;
+    }
+    return resource->handler(&pkt, _resp, sizeof(_resp), resource->context);
+}
+
+static unsigned long _run(unsigned numof, bool indexed)
+{
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned n = 0; n < TEST_REQUESTS; n++) {
+        /* walk the resources with a stride, so each request hits another one */
+        if (_handle((n * 37) % numof, numof, indexed) <= 0) {
+            puts("request failed");
+            return 0;
+        }
+    }
+    uint32_t time = xtimer_now_usec() - start;
+    return (unsigned long)(((uint64_t)TEST_REQUESTS * US_PER_SEC) / (time ? time : 1));
+}
+
+int main(void)
+{
+    puts("nanocoap resource lookup benchmark");
+
+    for (unsigned i = 0; i < MAX_RESOURCES; i++) {
+        coap_pkt_t pkt;
+
+        snprintf(_paths[i], PATH_LEN, "/sensor/%03u/value", i);
+        _resources[i].path = _paths[i];
+        _resources[i].methods = COAP_GET;
+        _resources[i].handler = _handler;
+        _resources[i].context = NULL;
+
+        coap_pkt_init(&pkt, _req[i], BUF_SIZE,
+                      coap_build_hdr((coap_hdr_t *)_req[i], COAP_TYPE_NON, NULL, 0,
+                                     COAP_METHOD_GET, i));
+        coap_opt_add_string(&pkt, COAP_OPT_URI_PATH, _paths[i], '/');
+        _req_len[i] = coap_opt_finish(&pkt, COAP_OPT_FINISH_NONE);
+    }
+
+    for (unsigned n = 0; n < sizeof(_numof) / sizeof(_numof[0]); n++) {
+        unsigned numof = _numof[n];
+
+        coap_resource_index_init(&_index, _entries, 2 * MAX_RESOURCES);
+        for (unsigned i = 0; i < numof; i++) {
+            coap_resource_index_add(&_index, &_resources[i]);
+        }
+
+        unsigned long linear = _run(numof, false);
+        unsigned long indexed = _run(numof, true);
+        if (!linear || !indexed) {
+            return 1;
+        }
+        printf("{ \"resources\" : %u, \"linear\" : %lu, \"index\" : %lu }\n",
+               numof, linear, indexed);
+    }
+    puts("done");
+    return 0;
+}
@@ -0,0 +1,22 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2018 OverDriveGain
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact("nanocoap resource lookup benchmark")
+    for numof in (16, 64, 256):
+        child.expect(r"{ \"resources\" : %d, \"linear\" : \d+, \"index\" : \d+ }"
+                     % numof)
+    child.expect_exact("done")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc, timeout=120))
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2018 OverDriveGain
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures the throughput of AES in CTR and CCM mode
+ *
+ * @author      OverDriveGain
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "crypto/aes.h"
+#include "crypto/ciphers.h"
+#include "crypto/modes/ctr.h"
+#include "crypto/modes/ccm.h"
+#include "xtimer.h"
+
+#define MAX_BYTES       (4096U)
+#define ADATA_LEN       (16U)
+#define MAC_LEN         (8U)
+#define NONCE_LEN       (13U)
+#define LEN_ENCODING    (15U - NONCE_LEN)
+
+static const uint8_t _key[AES_KEY_SIZE] = {
+    0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+    0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c
+};
+static const char *_modes[] = { "ctr", "ccm" };
+static const uint16_t _sizes[] = { 64, 128, 256, 512, 1024, 2048, 4096 };
+
+static uint8_t _nonce[16];
+static uint8_t _adata[ADATA_LEN];
+static uint8_t _in[MAX_BYTES];
+static uint8_t _out[MAX_BYTES + MAC_LEN];
+
+static int _run(cipher_t *cipher, unsigned mode, size_t len, uint32_t *time)
+{
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < ITERATIONS; i++) {
+        int res;
+
+        if (mode == 0) {
+            /* the counter advances, as it would for consecutive messages */
+            res = cipher_encrypt_ctr(cipher, _nonce, NONCE_LEN, _in, len, _out);
+        }
+        else {
+            res = cipher_encrypt_ccm(cipher, _adata, ADATA_LEN, MAC_LEN,
+                                     LEN_ENCODING, _nonce, NONCE_LEN,
+                                     _in, len, _out);
+        }
+        if (res < 0) {
+            return res;
+        }
+    }
+    *time = xtimer_now_usec() - start;
+    return 0;
+}
+
+int main(void)
+{
+    cipher_t cipher;
+
+    puts("crypto benchmark");
+    for (unsigned i = 0; i < sizeof(_in); i++) {
+        _in[i] = i * 7;
+    }
+    if (cipher_init(&cipher, CIPHER_AES_128, _key, AES_KEY_SIZE) != 1) {
+        puts("cipher_init() failed");
+        return 1;
+    }
+    for (unsigned mode = 0; mode < sizeof(_modes) / sizeof(_modes[0]); mode++) {
+        for (unsigned i = 0; i < sizeof(_sizes) / sizeof(_sizes[0]); i++) {
+            uint32_t time = 0;
+            int res = _run(&cipher, mode, _sizes[i], &time);
+
+            if (res < 0) {
+                printf("%s : %d\n", _modes[mode], res);
+                return 1;
+            }
+            printf("{ \"mode\" : \"%s\", \"bytes\" : %u, \"us\" : %lu, "
+                   "\"bytes/s\" : %lu }\n", _modes[mode], _sizes[i],
+                   (unsigned long)time,
+                   (time > 0) ? (unsigned long)(((uint64_t)_sizes[i] * ITERATIONS
+                                                 * US_PER_SEC) / time)
+                              : 0UL);
+        }
+    }
+    puts("done");
+    return 0;
+}
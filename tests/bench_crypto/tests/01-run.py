@@ -0,0 +1,22 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2018 OverDriveGain
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact("crypto benchmark")
+    for _ in range(2 * 7):
+        child.expect(r"{ \"mode\" : \"(ctr|ccm)\", \"bytes\" : \d+, "
+                     r"\"us\" : \d+, \"bytes/s\" : \d+ }")
+    child.expect_exact("done")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc, timeout=300))
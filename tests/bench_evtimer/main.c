@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2018 OverDriveGain
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures evtimer with many pending events
+ *
+ * @author      OverDriveGain
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "evtimer.h"
+#include "mutex.h"
+#include "random.h"
+#include "xtimer.h"
+
+#define OFFSET_MIN      (10U * MS_PER_SEC)
+#define OFFSET_MAX      (1000U * MS_PER_SEC)
+#define BATCH_OFFSET    (100U)
+
+static evtimer_t _evtimer;
+static evtimer_event_t _events[EVENTS_MAX];
+static evtimer_event_t _probe;
+static mutex_t _done = MUTEX_INIT_LOCKED;
+static unsigned _fired;
+static uint32_t _first, _last;
+
+static void _cb(evtimer_event_t *event)
+{
+    (void)event;
+    _last = xtimer_now_usec();
+    if (_fired++ == 0) {
+        _first = _last;
+    }
+    if (_fired == EVENTS_MAX) {
+        mutex_unlock(&_done);
+    }
+}
+
+int main(void)
+{
+    unsigned pending = 0;
+
+    puts("evtimer benchmark");
+    random_init(0);
+    evtimer_init(&_evtimer, _cb);
+    for (unsigned numof = 0; numof <= EVENTS_MAX; numof = (numof) ? numof * 2 : 16) {
+        /* add pending events up to numof */
+        for (; pending < numof; pending++) {
+            _events[pending].offset = random_uint32_range(OFFSET_MIN, OFFSET_MAX);
+            evtimer_add(&_evtimer, &_events[pending]);
+        }
+
+        uint32_t start = xtimer_now_usec();
+        for (unsigned i = 0; i < ITERATIONS; i++) {
+            _probe.offset = random_uint32_range(OFFSET_MIN, OFFSET_MAX);
+            evtimer_add(&_evtimer, &_probe);
+            evtimer_del(&_evtimer, &_probe);
+        }
+        uint32_t time = xtimer_now_usec() - start;
+
+        printf("{ \"events\" : %u, \"ns/op\" : %lu }\n", numof,
+               (unsigned long)(((uint64_t)time * NS_PER_US) / ITERATIONS));
+    }
+    if (_fired) {
+        puts("an event fired during the measurement");
+        return 1;
+    }
+
+    /* reschedule all of them for the same millisecond */
+    for (unsigned i = 0; i < EVENTS_MAX; i++) {
+        evtimer_del(&_evtimer, &_events[i]);
+        _events[i].offset = BATCH_OFFSET;
+        evtimer_add(&_evtimer, &_events[i]);
+    }
+    mutex_lock(&_done);
+    printf("{ \"batch\" : %u, \"us\" : %lu }\n", EVENTS_MAX,
+           (unsigned long)(_last - _first));
+    puts("done");
+    return 0;
+}
@@ -0,0 +1,24 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2018 OverDriveGain
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact("evtimer benchmark")
+    while True:
+        idx = child.expect([r"{ \"events\" : \d+, \"ns/op\" : \d+ }",
+                            r"{ \"batch\" : \d+, \"us\" : \d+ }"])
+        if idx == 1:
+            break
+    child.expect_exact("done")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc, timeout=300))
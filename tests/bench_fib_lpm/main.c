@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2018 OverDriveGain
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Compares the FIB lookup latency of the linear table scan
+ *              with the longest-prefix-match index
+ *
+ * @author      OverDriveGain
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "net/fib.h"
+#include "net/fib/table.h"
+#include "net/ipv6/addr.h"
+#include "xtimer.h"
+
+#ifndef TEST_LOOKUPS
+#define TEST_LOOKUPS        (10000U)
+#endif
+
+#define TABLE_SIZE          (4096U)
+
+static const unsigned _routes[] = { 16, 256, 4096 };
+
+static fib_entry_t _entries[TABLE_SIZE];
+static fib_lpm_node_t _lpm_nodes[FIB_LPM_NODES_NUMOF(TABLE_SIZE)];
+static fib_table_t _table = {
+    .data.entries = _entries,
+    .table_type = FIB_TABLE_TYPE_SH,
+    .size = TABLE_SIZE,
+};
+
+/* spreads route i over the address space: 2001:db8:<i scrambled>::/64 */
+static void _route_prefix(ipv6_addr_t *addr, unsigned i)
+{
+    uint32_t scrambled = i * 2654435761U;
+
+    memset(addr, 0, sizeof(*addr));
+    addr->u16[0] = byteorder_htons(0x2001);
+    addr->u16[1] = byteorder_htons(0x0db8);
+    addr->u32[1] = byteorder_htonl(scrambled);
+}
+
+static void _fill(unsigned routes)
+{
+    ipv6_addr_t dst, next_hop;
+
+    ipv6_addr_from_str(&next_hop, "fe80::1");
+    for (unsigned i = 0; i < routes; i++) {
+        _route_prefix(&dst, i);
+        fib_add_entry(&_table, 6, dst.u8, sizeof(dst),
+                      (64UL << FIB_FLAG_NET_PREFIX_SHIFT),
+                      next_hop.u8, sizeof(next_hop), 0,
+                      (uint32_t)FIB_LIFETIME_NO_EXPIRE);
+    }
+}
+
+static uint32_t _lookup(unsigned routes)
+{
+    ipv6_addr_t dst, next_hop;
+    kernel_pid_t iface;
+    uint32_t next_hop_flags;
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < TEST_LOOKUPS; i++) {
+        size_t next_hop_size = sizeof(next_hop);
+
+        /* look up a host within one of the routes */
+        _route_prefix(&dst, (i * 7) % routes);
+        dst.u32[3] = byteorder_htonl(i + 1);
+        if (fib_get_next_hop(&_table, &iface, next_hop.u8, &next_hop_size,
+                             &next_hop_flags, dst.u8, sizeof(dst), 0) != 0) {
+            puts("lookup failed");
+        }
+    }
+
+    return xtimer_now_usec() - start;
+}
+
+static uint32_t _run(unsigned routes, bool lpm)
+{
+    fib_deinit(&_table);
+    _table.lpm_nodes = lpm ? _lpm_nodes : NULL;
+    _table.lpm_nodes_numof = lpm ? FIB_LPM_NODES_NUMOF(TABLE_SIZE) : 0;
+    fib_init(&_table);
+    _fill(routes);
+
+    return _lookup(routes);
+}
+
+int main(void)
+{
+    puts("FIB lookup benchmark");
+
+    for (unsigned i = 0; i < sizeof(_routes) / sizeof(_routes[0]); i++) {
+        uint32_t linear = _run(_routes[i], false);
+        uint32_t lpm = _run(_routes[i], true);
+
+        printf("{ \"routes\" : %u, \"lookups\" : %u, "
+               "\"linear_us\" : %" PRIu32 ", \"lpm_us\" : %" PRIu32 " }\n",
+               _routes[i], TEST_LOOKUPS, linear, lpm);
+    }
+
+    puts("done");
+
+    return 0;
+}
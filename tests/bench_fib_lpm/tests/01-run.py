@@ -0,0 +1,22 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2018 OverDriveGain
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact("FIB lookup benchmark")
+    for routes in (16, 256, 4096):
+        child.expect(r"{ \"routes\" : %d, \"lookups\" : \d+, "
+                     r"\"linear_us\" : \d+, \"lpm_us\" : \d+ }" % routes)
+    child.expect_exact("done")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc, timeout=120))
@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2018 OverDriveGain
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures the request rate of a gcoap client with a window of
+ *              requests in flight
+ *
+ * @author      OverDriveGain
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "msg.h"
+#include "thread.h"
+#include "net/gcoap.h"
+#include "net/ipv6/addr.h"
+#include "net/nanocoap_sock.h"
+#include "xtimer.h"
+
+#define SERVER_PORT         (5684U)
+/* receives a message per completed request, so must hold the whole window */
+#define MAIN_QUEUE_SIZE     (32U)
+
+static const char *_types[] = { "NON", "CON" };
+
+static msg_t _main_msg_queue[MAIN_QUEUE_SIZE];
+static char _server_stack[THREAD_STACKSIZE_DEFAULT];
+static uint8_t _server_buf[128];
+static kernel_pid_t _main_pid;
+
+static ssize_t _value_handler(coap_pkt_t *pkt, uint8_t *buf, size_t len,
+                              void *context)
+{
+    (void)context;
+    return coap_reply_simple(pkt, COAP_CODE_205, buf, len,
+                             COAP_FORMAT_TEXT, (uint8_t *)"42", 2);
+}
+
+/* must be sorted by path (alphabetically) */
+const coap_resource_t coap_resources[] = {
+    COAP_WELL_KNOWN_CORE_DEFAULT_HANDLER,
+    { "/value", COAP_GET, _value_handler, NULL },
+};
+
+const unsigned coap_resources_numof = sizeof(coap_resources) / sizeof(coap_resources[0]);
+
+static void *_server_thread(void *arg)
+{
+    (void)arg;
+    sock_udp_ep_t local = { .port = SERVER_PORT, .family = AF_INET6 };
+
+    nanocoap_server(&local, _server_buf, sizeof(_server_buf));
+    return NULL;
+}
+
+static void _resp_handler(unsigned req_state, coap_pkt_t *pdu,
+                          sock_udp_ep_t *remote)
+{
+    (void)pdu;
+    (void)remote;
+    msg_t msg;
+
+    msg.content.value = req_state;
+    msg_send(&msg, _main_pid);
+}
+
+static int _run(unsigned type, const sock_udp_ep_t *remote)
+{
+    unsigned sent = 0, done = 0, timeouts = 0;
+    uint32_t start = xtimer_now_usec();
+
+    while (done < TEST_REQUESTS) {
+        /* fill the window */
+        while ((sent < TEST_REQUESTS) && ((sent - done) < GCOAP_REQ_WAITING_MAX)) {
+            uint8_t buf[GCOAP_PDU_BUF_SIZE];
+            coap_pkt_t pdu;
+            ssize_t len = gcoap_request(&pdu, buf, sizeof(buf), COAP_METHOD_GET,
+                                        "/value");
+
+            coap_hdr_set_type(pdu.hdr, (type == 0) ? COAP_TYPE_NON : COAP_TYPE_CON);
+            if ((len <= 0) || !gcoap_req_send2(buf, len, remote, _resp_handler)) {
+                break;
+            }
+            sent++;
+        }
+        if (sent == done) {
+            puts("gcoap_req_send2() failed");
+            return -1;
+        }
+
+        msg_t msg;
+        msg_receive(&msg);
+        if (msg.content.value != GCOAP_MEMO_RESP) {
+            timeouts++;
+        }
+        done++;
+    }
+    uint32_t time = xtimer_now_usec() - start;
+
+    printf("{ \"type\" : \"%s\", \"requests\" : %u, \"us\" : %lu, "
+           "\"req/s\" : %lu, \"timeouts\" : %u }\n",
+           _types[type], done, (unsigned long)time,
+           (unsigned long)(((uint64_t)done * US_PER_SEC) / (time ? time : 1)),
+           timeouts);
+    return 0;
+}
+
+int main(void)
+{
+    sock_udp_ep_t remote = { .family = AF_INET6, .port = SERVER_PORT,
+                             .netif = SOCK_ADDR_ANY_NETIF };
+
+    msg_init_queue(_main_msg_queue, MAIN_QUEUE_SIZE);
+    _main_pid = thread_getpid();
+    puts("gcoap client benchmark");
+
+    if (GCOAP_REQ_WAITING_MAX > MAIN_QUEUE_SIZE) {
+        puts("window larger than the message queue");
+        return 1;
+    }
+    if (!ipv6_addr_from_str((ipv6_addr_t *)&remote.addr.ipv6, COAP_SERVER)) {
+        puts("invalid server address");
+        return 1;
+    }
+    thread_create(_server_stack, sizeof(_server_stack), THREAD_PRIORITY_MAIN - 1,
+                  THREAD_CREATE_STACKTEST, _server_thread, NULL, "coap server");
+
+    for (unsigned type = 0; type < sizeof(_types) / sizeof(_types[0]); type++) {
+        if (_run(type, &remote) < 0) {
+            return 1;
+        }
+    }
+    puts("done");
+    return 0;
+}
@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2018 OverDriveGain
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Per-packet cost of calculating and of updating UDP checksums
+ *
+ * @author      OverDriveGain
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "byteorder.h"
+#include "net/gnrc.h"
+#include "net/gnrc/ipv6.h"
+#include "net/gnrc/udp.h"
+#include "net/inet_csum.h"
+#include "xtimer.h"
+
+static const uint16_t _sizes[] = { 8, 64, 512, 1232 };
+
+static inline uint64_t _cycles(void)
+{
+#if defined(__i386__) || defined(__x86_64__)
+    return __builtin_ia32_rdtsc();
+#else
+    return 0;
+#endif
+}
+
+static gnrc_pktsnip_t *_build(uint16_t size)
+{
+    ipv6_addr_t src = { .u8 = { 0xfe, 0x80, [15] = 0x01 } };
+    ipv6_addr_t dst = { .u8 = { 0xfe, 0x80, [15] = 0x02 } };
+    gnrc_pktsnip_t *payload, *udp, *ipv6;
+
+    payload = gnrc_pktbuf_add(NULL, NULL, size, GNRC_NETTYPE_UNDEF);
+    if (payload == NULL) {
+        return NULL;
+    }
+    for (unsigned i = 0; i < size; i++) {
+        ((uint8_t *)payload->data)[i] = i * 7;
+    }
+    udp = gnrc_udp_hdr_build(payload, 1234, 5678);
+    if (udp == NULL) {
+        gnrc_pktbuf_release(payload);
+        return NULL;
+    }
+    ((udp_hdr_t *)udp->data)->length = byteorder_htons(gnrc_pkt_len(udp));
+    ipv6 = gnrc_ipv6_hdr_build(udp, &src, &dst);
+    if (ipv6 == NULL) {
+        gnrc_pktbuf_release(udp);
+        return NULL;
+    }
+    return ipv6;
+}
+
+static void _print(const char *method, uint16_t size, uint32_t us,
+                   uint64_t cycles)
+{
+    printf("{ \"method\" : \"%s\", \"payload\" : %u, \"ns/pkt\" : %lu, "
+           "\"cycles/pkt\" : %lu }\n", method, size,
+           (unsigned long)(((uint64_t)us * 1000) / ITERATIONS),
+           (unsigned long)(cycles / ITERATIONS));
+}
+
+static int _bench(uint16_t size)
+{
+    gnrc_pktsnip_t *ipv6 = _build(size);
+
+    if (ipv6 == NULL) {
+        puts("packet buffer full");
+        return 1;
+    }
+
+    gnrc_pktsnip_t *udp = ipv6->next;
+    udp_hdr_t *hdr = udp->data;
+
+    /* full calculation, as done for every packet sent: the checksum field
+     * is part of the sum, so it must be zero as on an unsent packet */
+    uint32_t start = xtimer_now_usec();
+    uint64_t cycles = _cycles();
+    for (unsigned i = 0; i < ITERATIONS; i++) {
+        hdr->checksum = byteorder_htons(0);
+        gnrc_udp_calc_csum(udp, ipv6);
+    }
+    cycles = _cycles() - cycles;
+    _print("calc", size, xtimer_now_usec() - start, cycles);
+
+    /* RFC 1624 update after a header field changed, here the source port */
+    start = xtimer_now_usec();
+    cycles = _cycles();
+    for (unsigned i = 0; i < ITERATIONS; i++) {
+        uint16_t old_port = byteorder_ntohs(hdr->src_port);
+        uint16_t csum = inet_csum_update(byteorder_ntohs(hdr->checksum),
+                                         old_port, old_port + 1);
+
+        hdr->src_port = byteorder_htons(old_port + 1);
+        hdr->checksum = byteorder_htons((csum == 0) ? 0xffff : csum);
+    }
+    cycles = _cycles() - cycles;
+    _print("update", size, xtimer_now_usec() - start, cycles);
+
+    /* the updated checksum must match a full calculation */
+    network_uint16_t updated = hdr->checksum;
+    int res = 0;
+
+    hdr->checksum = byteorder_htons(0);
+    gnrc_udp_calc_csum(udp, ipv6);
+    if (updated.u16 != hdr->checksum.u16) {
+        printf("checksum mismatch: 0x%04x != 0x%04x\n",
+               byteorder_ntohs(updated), byteorder_ntohs(hdr->checksum));
+        res = 1;
+    }
+    gnrc_pktbuf_release(ipv6);
+    return res;
+}
+
+int main(void)
+{
+    puts("gnrc checksum benchmark");
+    for (unsigned i = 0; i < sizeof(_sizes) / sizeof(_sizes[0]); i++) {
+        if (_bench(_sizes[i]) != 0) {
+            return 1;
+        }
+    }
+    puts("done");
+    return 0;
+}
@@ -0,0 +1,23 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2018 OverDriveGain
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact("gnrc checksum benchmark")
+    for _ in range(4):
+        for method in ("calc", "update"):
+            child.expect(r"{ \"method\" : \"%s\", \"payload\" : \d+, "
+                         r"\"ns/pkt\" : \d+, \"cycles/pkt\" : \d+ }" % method)
+    child.expect_exact("done")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc, timeout=120))
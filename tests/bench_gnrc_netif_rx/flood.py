@@ -0,0 +1,43 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2018 OverDriveGain
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+# Sends broadcast frames of an experimental ethertype to a tap interface as
+# fast as possible. Needs root privileges (or CAP_NET_RAW).
+
+import argparse
+import socket
+import time
+
+ETHERTYPE = 0x88b5
+
+
+def flood(iface, duration, size):
+    sock = socket.socket(socket.AF_PACKET, socket.SOCK_RAW)
+    sock.bind((iface, 0))
+    frame = (b"\xff" * 6) + sock.getsockname()[4] + ETHERTYPE.to_bytes(2, "big")
+    frame += bytes(max(size - len(frame), 0))
+    sent = 0
+    end = time.monotonic() + duration
+    while time.monotonic() < end:
+        for _ in range(100):
+            try:
+                sock.send(frame)
+                sent += 1
+            except BlockingIOError:
+                pass
+    return sent
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("iface", nargs="?", default="tap0")
+    parser.add_argument("-d", "--duration", type=float, default=10)
+    parser.add_argument("-s", "--size", type=int, default=64)
+    args = parser.parse_args()
+    sent = flood(args.iface, args.duration, args.size)
+    print("sent %u frames in %.1f s" % (sent, args.duration))
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2018 OverDriveGain
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures the rate of frames a network interface passes on
+ *              under a flood
+ *
+ * @author      OverDriveGain
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "msg.h"
+#include "net/gnrc.h"
+#include "net/gnrc/netif.h"
+#include "net/netstats.h"
+#include "xtimer.h"
+
+#define MAIN_QUEUE_SIZE     (64U)
+
+static msg_t _main_msg_queue[MAIN_QUEUE_SIZE];
+
+static netstats_t *_get_stats(gnrc_netif_t *netif)
+{
+    netstats_t *stats = NULL;
+
+    gnrc_netapi_get(netif->pid, NETOPT_STATS, 0, &stats, sizeof(stats));
+    return stats;
+}
+
+int main(void)
+{
+    gnrc_netreg_entry_t entry = GNRC_NETREG_ENTRY_INIT_PID(GNRC_NETREG_DEMUX_CTX_ALL,
+                                                           sched_active_pid);
+    gnrc_netif_t *netif = gnrc_netif_iter(NULL);
+    netstats_t *stats;
+    unsigned frames = 0;
+    uint32_t start, rx_start, time;
+    msg_t msg;
+
+    msg_init_queue(_main_msg_queue, MAIN_QUEUE_SIZE);
+    puts("gnrc_netif receive benchmark");
+    if (!netif || !(stats = _get_stats(netif))) {
+        puts("no interface with statistics");
+        return 1;
+    }
+    /* frames of unknown ethertypes are dispatched as GNRC_NETTYPE_UNDEF */
+    gnrc_netreg_register(GNRC_NETTYPE_UNDEF, &entry);
+
+    puts("waiting for frames");
+    do {
+        msg_receive(&msg);
+    } while (msg.type != GNRC_NETAPI_MSG_TYPE_RCV);
+    gnrc_pktbuf_release(msg.content.ptr);
+
+    start = xtimer_now_usec();
+    rx_start = stats->rx_count;
+    while ((time = xtimer_now_usec() - start) < (DURATION * US_PER_SEC)) {
+        if (xtimer_msg_receive_timeout(&msg, (DURATION * US_PER_SEC) - time) < 0) {
+            continue;
+        }
+        if (msg.type == GNRC_NETAPI_MSG_TYPE_RCV) {
+            gnrc_pktbuf_release(msg.content.ptr);
+            frames++;
+        }
+    }
+    gnrc_netreg_unregister(GNRC_NETTYPE_UNDEF, &entry);
+
+    printf("{ \"frames\" : %u, \"read\" : %lu, \"us\" : %lu, \"frames/s\" : %lu }\n",
+           frames, (unsigned long)(stats->rx_count - rx_start), (unsigned long)time,
+           (unsigned long)(((uint64_t)frames * US_PER_SEC) / time));
+    puts("done");
+    return 0;
+}
@@ -0,0 +1,30 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2018 OverDriveGain
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import subprocess
+import sys
+from testrunner import run
+
+FLOOD = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "flood.py")
+
+
+def testfunc(child):
+    child.expect_exact("gnrc_netif receive benchmark")
+    child.expect_exact("waiting for frames")
+    flood = subprocess.Popen([FLOOD, os.environ.get("TAP", "tap0"), "-d", "30"])
+    try:
+        child.expect(r"{ \"frames\" : \d+, \"read\" : \d+, \"us\" : \d+, "
+                     r"\"frames/s\" : \d+ }")
+        child.expect_exact("done")
+    finally:
+        flood.terminate()
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc, timeout=60))
@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2018 OverDriveGain
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures the dispatch cost of the network registry depending
+ *              on the number of registered demultiplexing contexts
+ *
+ * @author      OverDriveGain
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "msg.h"
+#include "thread.h"
+#include "net/gnrc/netreg.h"
+#include "xtimer.h"
+
+#ifndef TEST_LOOKUPS
+#define TEST_LOOKUPS        (10000U)
+#endif
+
+#define MAX_PORTS           (256U)
+#define FIRST_PORT          (1024U)
+/* registering the ports as UDP would pull in the whole network stack */
+#define NETTYPE             (GNRC_NETTYPE_UNDEF)
+#define MAIN_QUEUE_SIZE     (8U)
+
+static const unsigned _ports[] = { 1, 16, 64, 256 };
+
+static msg_t _main_msg_queue[MAIN_QUEUE_SIZE];
+static gnrc_netreg_entry_t _entries[MAX_PORTS];
+
+static void _register(unsigned ports)
+{
+    for (unsigned i = 0; i < ports; i++) {
+        gnrc_netreg_entry_init_pid(&_entries[i], FIRST_PORT + i,
+                                   sched_active_pid);
+        gnrc_netreg_register(NETTYPE, &_entries[i]);
+    }
+}
+
+static void _unregister(unsigned ports)
+{
+    for (unsigned i = 0; i < ports; i++) {
+        gnrc_netreg_unregister(NETTYPE, &_entries[i]);
+    }
+}
+
+static uint32_t _dispatch(unsigned ports)
+{
+    unsigned found = 0;
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < TEST_LOOKUPS; i++) {
+        /* iterate all subscribers as gnrc_netapi_dispatch() does */
+        gnrc_netreg_entry_t *entry = gnrc_netreg_lookup(NETTYPE,
+                                                        FIRST_PORT + (i % ports));
+        while (entry) {
+            found++;
+            entry = gnrc_netreg_getnext(entry);
+        }
+    }
+
+    uint32_t duration = xtimer_now_usec() - start;
+    if (found != TEST_LOOKUPS) {
+        puts("dispatch failed");
+    }
+    return duration;
+}
+
+int main(void)
+{
+    /* the registry checks for a message queue on registration */
+    msg_init_queue(_main_msg_queue, MAIN_QUEUE_SIZE);
+    puts("gnrc_netreg dispatch benchmark");
+
+    for (unsigned i = 0; i < sizeof(_ports) / sizeof(_ports[0]); i++) {
+        _register(_ports[i]);
+        printf("{ \"ports\" : %u, \"lookups\" : %u, \"us\" : %" PRIu32 " }\n",
+               _ports[i], TEST_LOOKUPS, _dispatch(_ports[i]));
+        _unregister(_ports[i]);
+    }
+
+    puts("done");
+
+    return 0;
+}
@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2018 OverDriveGain
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Stress benchmark for the packet buffer replaying a mix of
+ *              packet sizes as seen by a 6LoWPAN border router
+ *
+ * @author      OverDriveGain
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "net/gnrc/pktbuf.h"
+#include "xtimer.h"
+
+#ifndef TEST_ROUNDS
+#define TEST_ROUNDS         (100000U)
+#endif
+
+/* maximum number of packets held at the same time */
+#define SLOTS               (24U)
+
+/* header sizes of IPv6, UDP and the 6LoWPAN fragmentation header */
+#define IPV6_HDR_LEN        (40U)
+#define UDP_HDR_LEN         (8U)
+#define FRAG_HDR_LEN        (5U)
+
+static gnrc_pktsnip_t *_slots[SLOTS];
+static uint32_t _state = 0x2f6b1d37U;
+
+/* xorshift32, keeps the replayed sequence the same for both allocators */
+static uint32_t _rand(void)
+{
+    _state ^= _state << 13;
+    _state ^= _state >> 17;
+    _state ^= _state << 5;
+    return _state;
+}
+
+/* payload sizes: mostly small control messages and single IEEE 802.15.4
+ * frames, some full-MTU packets */
+static size_t _payload_size(void)
+{
+    uint32_t r = _rand();
+
+    switch (r % 10) {
+        case 0:
+        case 1:
+        case 2:
+        case 3:
+            return 1 + ((r >> 8) % 48);
+        case 4:
+        case 5:
+        case 6:
+        case 7:
+            return 60 + ((r >> 8) % 68);
+        default:
+            return 1280 - IPV6_HDR_LEN - UDP_HDR_LEN;
+    }
+}
+
+static gnrc_pktsnip_t *_build(void)
+{
+    gnrc_pktsnip_t *pkt, *hdr;
+    size_t size = _payload_size();
+
+    pkt = gnrc_pktbuf_add(NULL, NULL, size, GNRC_NETTYPE_UNDEF);
+    if (pkt == NULL) {
+        return NULL;
+    }
+    if (size > 100) {
+        /* split off the first fragment as the 6LoWPAN layer would do */
+        gnrc_pktbuf_mark(pkt, 96, GNRC_NETTYPE_UNDEF);
+        hdr = gnrc_pktbuf_add(pkt, NULL, FRAG_HDR_LEN, GNRC_NETTYPE_UNDEF);
+        if (hdr == NULL) {
+            gnrc_pktbuf_release(pkt);
+            return NULL;
+        }
+        pkt = hdr;
+    }
+    hdr = gnrc_pktbuf_add(pkt, NULL, UDP_HDR_LEN, GNRC_NETTYPE_UNDEF);
+    if (hdr == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    pkt = hdr;
+    hdr = gnrc_pktbuf_add(pkt, NULL, IPV6_HDR_LEN, GNRC_NETTYPE_UNDEF);
+    if (hdr == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    return hdr;
+}
+
+int main(void)
+{
+    unsigned failed = 0;
+    uint32_t start;
+
+    puts("gnrc_pktbuf stress benchmark");
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < TEST_ROUNDS; i++) {
+        unsigned slot = _rand() % SLOTS;
+
+        if (_slots[slot] != NULL) {
+            gnrc_pktbuf_release(_slots[slot]);
+            _slots[slot] = NULL;
+        }
+        else if ((_slots[slot] = _build()) == NULL) {
+            failed++;
+        }
+    }
+    uint32_t duration = xtimer_now_usec() - start;
+
+    printf("{ \"rounds\" : %u, \"failed\" : %u, \"us\" : %" PRIu32 " }\n",
+           TEST_ROUNDS, failed, duration);
+#ifdef DEVELHELP
+    gnrc_pktbuf_stats();
+#endif
+
+    for (unsigned i = 0; i < SLOTS; i++) {
+        gnrc_pktbuf_release(_slots[i]);
+    }
+
+    puts("done");
+
+    return 0;
+}
@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2018 OverDriveGain
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures the GNRC TCP throughput depending on the send window
+ *
+ * @author      OverDriveGain
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <errno.h>
+#include <string.h>
+
+#include "net/af.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/tcp.h"
+#include "xtimer.h"
+
+#ifdef SERVER
+/* the server reads one segment at a time */
+static uint8_t _buf[GNRC_TCP_MSS];
+
+/* "ifconfig" shell command */
+extern int _gnrc_netif_config(int argc, char **argv);
+
+static void _server(void)
+{
+    gnrc_tcp_tcb_t tcb;
+    gnrc_netif_t *netif;
+
+    if (!(netif = gnrc_netif_iter(NULL))) {
+        puts("No valid network interface found");
+        return;
+    }
+
+    /* Set pre-configured IP address */
+    char if_pid[] = {netif->pid + '0', '\0'};
+    char *cmd[] = {"ifconfig", if_pid, "add", "unicast", SERVER_ADDR};
+    _gnrc_netif_config(5, cmd);
+
+    printf("Server: SERVER_ADDR=%s, TARGET_PORT=%d, NBYTE=%d\n",
+           SERVER_ADDR, TARGET_PORT, NBYTE);
+    while (1) {
+        size_t rcvd = 0;
+        int ret;
+
+        gnrc_tcp_tcb_init(&tcb);
+        ret = gnrc_tcp_open_passive(&tcb, AF_INET6, NULL, TARGET_PORT);
+        if (ret < 0) {
+            printf("gnrc_tcp_open_passive() : %d\n", ret);
+            return;
+        }
+        while (rcvd < NBYTE) {
+            ret = gnrc_tcp_recv(&tcb, _buf, sizeof(_buf), GNRC_TCP_CONNECTION_TIMEOUT_DURATION);
+            if ((ret < 0) && (ret != -EAGAIN)) {
+                printf("gnrc_tcp_recv() : %d\n", ret);
+                break;
+            }
+            rcvd += (ret > 0) ? ret : 0;
+        }
+        gnrc_tcp_close(&tcb);
+        printf("{ \"received\" : %u }\n", (unsigned)rcvd);
+    }
+}
+#else
+static uint8_t _buf[NBYTE];
+
+static void _client(void)
+{
+    gnrc_tcp_tcb_t tcb;
+    /* gnrc_tcp_open_active() strips the interface identifier from the address */
+    char target_addr[] = TARGET_ADDR;
+    size_t sent = 0;
+    int ret;
+
+    printf("Client: TARGET_ADDR=%s, TARGET_PORT=%d, NBYTE=%d\n",
+           TARGET_ADDR, TARGET_PORT, NBYTE);
+    memset(_buf, 0xF0, sizeof(_buf));
+
+    gnrc_tcp_tcb_init(&tcb);
+    while ((ret = gnrc_tcp_open_active(&tcb, AF_INET6, target_addr, TARGET_PORT, 0)) < 0) {
+        if ((ret != -ECONNREFUSED) && (ret != -ETIMEDOUT)) {
+            printf("gnrc_tcp_open_active() : %d\n", ret);
+            return;
+        }
+        /* server is not up yet */
+        xtimer_sleep(1);
+        strcpy(target_addr, TARGET_ADDR);
+        gnrc_tcp_tcb_init(&tcb);
+    }
+
+    uint32_t start = xtimer_now_usec();
+    while (sent < sizeof(_buf)) {
+        ret = gnrc_tcp_send(&tcb, _buf + sent, sizeof(_buf) - sent, 0);
+        if (ret < 0) {
+            printf("gnrc_tcp_send() : %d\n", ret);
+            break;
+        }
+        sent += ret;
+    }
+    uint32_t time = xtimer_now_usec() - start;
+    gnrc_tcp_close(&tcb);
+
+    printf("{ \"window\" : %u, \"bytes\" : %u, \"us\" : %lu, \"bytes/s\" : %lu }\n",
+           (unsigned)GNRC_TCP_RETRANSMIT_QUEUE_SIZE, (unsigned)sent, (unsigned long)time,
+           (time > 0) ? (unsigned long)(((uint64_t)sent * US_PER_SEC) / time) : 0UL);
+}
+#endif
+
+int main(void)
+{
+#ifdef SERVER
+    _server();
+#else
+    _client();
+#endif
+    return 0;
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2018 OverDriveGain
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures the segment demultiplexing cost of GNRC TCP depending
+ *              on the number of open connections
+ *
+ * @author      OverDriveGain
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <errno.h>
+
+#include "msg.h"
+#include "thread.h"
+#include "net/af.h"
+#include "net/gnrc/tcp.h"
+#include "xtimer.h"
+
+#ifndef TEST_SEGMENTS
+#define TEST_SEGMENTS       (1000U)
+#endif
+
+#define MAX_CONNS           (256U)
+#define FIRST_PORT          (20000U)
+#define MAIN_QUEUE_SIZE     (8U)
+
+static const unsigned _conns[] = { 1, 16, 64, 256 };
+
+static gnrc_tcp_tcb_t _cli[MAX_CONNS];
+static gnrc_tcp_tcb_t _srv[MAX_CONNS + 1];
+static msg_t _main_msg_queue[MAIN_QUEUE_SIZE];
+static char _srv_stack[THREAD_STACKSIZE_MAIN];
+static kernel_pid_t _main_pid;
+
+static void *_srv_thread(void *arg)
+{
+    (void)arg;
+    for (unsigned i = 0; i <= MAX_CONNS; i++) {
+        msg_t msg;
+        int ret;
+
+        gnrc_tcp_tcb_init(&_srv[i]);
+        ret = gnrc_tcp_open_passive(&_srv[i], AF_INET6, NULL, FIRST_PORT + i);
+        msg.content.value = (uint32_t)ret;
+        msg_send(&msg, _main_pid);
+    }
+    return NULL;
+}
+
+static int _connect(unsigned i)
+{
+    msg_t msg;
+    int ret;
+
+    do {
+        char addr[] = "::1";
+
+        gnrc_tcp_tcb_init(&_cli[i]);
+        ret = gnrc_tcp_open_active(&_cli[i], AF_INET6, addr, FIRST_PORT + i, 0);
+    } while (ret == -ECONNREFUSED);
+    if (ret < 0) {
+        printf("gnrc_tcp_open_active() : %d\n", ret);
+        return ret;
+    }
+    /* wait for the server to accept the connection */
+    msg_receive(&msg);
+    if ((int)msg.content.value < 0) {
+        printf("gnrc_tcp_open_passive() : %d\n", (int)msg.content.value);
+        return (int)msg.content.value;
+    }
+    return 0;
+}
+
+int main(void)
+{
+    unsigned open = 0;
+
+    msg_init_queue(_main_msg_queue, MAIN_QUEUE_SIZE);
+    _main_pid = thread_getpid();
+    puts("gnrc_tcp demultiplexing benchmark");
+
+    thread_create(_srv_stack, sizeof(_srv_stack), THREAD_PRIORITY_MAIN - 1,
+                  THREAD_CREATE_STACKTEST, _srv_thread, NULL, "server");
+
+    for (unsigned i = 0; i < sizeof(_conns) / sizeof(_conns[0]); i++) {
+        uint8_t byte = 0;
+        uint32_t start;
+
+        for (; open < _conns[i]; open++) {
+            if (_connect(open) < 0) {
+                return 1;
+            }
+        }
+
+        start = xtimer_now_usec();
+        for (unsigned j = 0; j < TEST_SEGMENTS; j++) {
+            if ((gnrc_tcp_send(&_cli[0], &byte, sizeof(byte), 0) != sizeof(byte)) ||
+                (gnrc_tcp_recv(&_srv[0], &byte, sizeof(byte), 0) != sizeof(byte))) {
+                puts("transmission failed");
+                return 1;
+            }
+        }
+        printf("{ \"connections\" : %u, \"segments\" : %u, \"us\" : %lu }\n",
+               _conns[i], TEST_SEGMENTS, (unsigned long)(xtimer_now_usec() - start));
+    }
+    puts("done");
+    return 0;
+}
@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2018 OverDriveGain
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Compares the copying and the zero-copy receive API of GNRC TCP
+ *
+ * @author      OverDriveGain
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <errno.h>
+#include <string.h>
+
+#include "msg.h"
+#include "thread.h"
+#include "net/af.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/tcp.h"
+#include "xtimer.h"
+
+#define FIRST_PORT          (20000U)
+#define MAIN_QUEUE_SIZE     (4U)
+
+static const char *_modes[] = { "copy", "pkt" };
+
+static gnrc_tcp_tcb_t _snd_tcb;
+static gnrc_tcp_tcb_t _rcv_tcb;
+static uint8_t _snd_buf[GNRC_TCP_MSS];
+static uint8_t _rcv_buf[GNRC_TCP_MSS];
+static msg_t _main_msg_queue[MAIN_QUEUE_SIZE];
+static char _rcv_stack[THREAD_STACKSIZE_MAIN];
+static kernel_pid_t _main_pid;
+/* the receiver reads every payload byte into this sum */
+static uint32_t _sum;
+
+static ssize_t _recv_copy(void)
+{
+    ssize_t ret = gnrc_tcp_recv(&_rcv_tcb, _rcv_buf, sizeof(_rcv_buf),
+                                GNRC_TCP_CONNECTION_TIMEOUT_DURATION);
+
+    for (ssize_t i = 0; i < ret; i++) {
+        _sum += _rcv_buf[i];
+    }
+    return ret;
+}
+
+static ssize_t _recv_pkt(void)
+{
+    gnrc_pktsnip_t *pkt;
+    ssize_t ret = gnrc_tcp_recv_pkt(&_rcv_tcb, &pkt, GNRC_TCP_CONNECTION_TIMEOUT_DURATION);
+
+    if (ret > 0) {
+        for (gnrc_pktsnip_t *snp = pkt; snp && snp->type == GNRC_NETTYPE_UNDEF;
+             snp = snp->next) {
+            for (size_t i = 0; i < snp->size; i++) {
+                _sum += ((uint8_t *)snp->data)[i];
+            }
+        }
+        gnrc_pktbuf_release(pkt);
+    }
+    return ret;
+}
+
+static void *_rcv_thread(void *arg)
+{
+    (void)arg;
+    for (unsigned mode = 0; mode < sizeof(_modes) / sizeof(_modes[0]); mode++) {
+        size_t rcvd = 0;
+        uint32_t start;
+        msg_t msg;
+        int ret;
+
+        gnrc_tcp_tcb_init(&_rcv_tcb);
+        ret = gnrc_tcp_open_passive(&_rcv_tcb, AF_INET6, NULL, FIRST_PORT + mode);
+        if (ret < 0) {
+            printf("gnrc_tcp_open_passive() : %d\n", ret);
+            msg.content.value = (uint32_t)ret;
+            msg_send(&msg, _main_pid);
+            return NULL;
+        }
+
+        start = xtimer_now_usec();
+        while (rcvd < NBYTE) {
+            ret = (mode == 0) ? _recv_copy() : _recv_pkt();
+            if (ret < 0) {
+                printf("receive : %d\n", ret);
+                break;
+            }
+            rcvd += ret;
+        }
+        uint32_t time = xtimer_now_usec() - start;
+        gnrc_tcp_close(&_rcv_tcb);
+
+        printf("{ \"mode\" : \"%s\", \"bytes\" : %u, \"us\" : %lu, \"us/KiB\" : %lu }\n",
+               _modes[mode], (unsigned)rcvd, (unsigned long)time,
+               (rcvd > 0) ? (unsigned long)(((uint64_t)time * 1024) / rcvd) : 0UL);
+        msg.content.value = (rcvd == NBYTE) ? 0 : (uint32_t)-EIO;
+        msg_send(&msg, _main_pid);
+    }
+    return NULL;
+}
+
+static int _send(unsigned mode)
+{
+    size_t sent = 0;
+    int ret;
+
+    do {
+        char addr[] = "::1";
+
+        gnrc_tcp_tcb_init(&_snd_tcb);
+        ret = gnrc_tcp_open_active(&_snd_tcb, AF_INET6, addr, FIRST_PORT + mode, 0);
+    } while (ret == -ECONNREFUSED);
+    if (ret < 0) {
+        printf("gnrc_tcp_open_active() : %d\n", ret);
+        return ret;
+    }
+
+    while (sent < NBYTE) {
+        size_t len = NBYTE - sent;
+
+        len = (len < sizeof(_snd_buf)) ? len : sizeof(_snd_buf);
+        ret = gnrc_tcp_send(&_snd_tcb, _snd_buf, len, 0);
+        if (ret < 0) {
+            printf("gnrc_tcp_send() : %d\n", ret);
+            break;
+        }
+        sent += ret;
+    }
+    gnrc_tcp_close(&_snd_tcb);
+    return (ret < 0) ? ret : 0;
+}
+
+int main(void)
+{
+    msg_init_queue(_main_msg_queue, MAIN_QUEUE_SIZE);
+    _main_pid = thread_getpid();
+    puts("gnrc_tcp receive benchmark");
+    memset(_snd_buf, 0xA5, sizeof(_snd_buf));
+
+    thread_create(_rcv_stack, sizeof(_rcv_stack), THREAD_PRIORITY_MAIN - 1,
+                  THREAD_CREATE_STACKTEST, _rcv_thread, NULL, "receiver");
+
+    for (unsigned mode = 0; mode < sizeof(_modes) / sizeof(_modes[0]); mode++) {
+        msg_t msg;
+
+        if (_send(mode) < 0) {
+            return 1;
+        }
+        /* wait for the receiver to report */
+        msg_receive(&msg);
+        if ((int)msg.content.value < 0) {
+            return 1;
+        }
+    }
+    puts("done");
+    return 0;
+}
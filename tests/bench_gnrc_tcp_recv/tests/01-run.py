@@ -0,0 +1,22 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2018 OverDriveGain
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact("gnrc_tcp receive benchmark")
+    for mode in ("copy", "pkt"):
+        child.expect(r"{ \"mode\" : \"%s\", \"bytes\" : \d+, \"us\" : \d+, \"us/KiB\" : \d+ }"
+                     % mode)
+    child.expect_exact("done")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc, timeout=120))
@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2018 OverDriveGain
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Compares inet_csum_slice() to a byte-wise reference
+ *
+ * @author      OverDriveGain
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "net/inet_csum.h"
+#include "xtimer.h"
+
+/* the largest size is an IPv6 MTU, +1 for the unaligned runs */
+static uint8_t _buf[1280 + 1];
+static const uint16_t _sizes[] = { 40, 128, 512, 1280 };
+
+/* the byte-wise implementation inet_csum_slice() replaced */
+static uint16_t _ref_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len,
+                                size_t accum_len)
+{
+    uint32_t csum = sum;
+
+    if (len == 0) {
+        return csum;
+    }
+    if (accum_len & 1) {
+        csum += *buf;
+        buf++;
+        len--;
+        accum_len++;
+    }
+    for (unsigned i = 0; i < (len >> 1); buf += 2, i++) {
+        csum += (uint16_t)(*buf << 8) + *(buf + 1);
+    }
+    if ((accum_len + len) & 1) {
+        csum += (uint16_t)(*buf << 8);
+    }
+    while (csum >> 16) {
+        csum = (csum & 0xffff) + (csum >> 16);
+    }
+    return csum;
+}
+
+static uint32_t _run(uint16_t (*csum)(uint16_t, const uint8_t *, uint16_t, size_t),
+                     const uint8_t *buf, uint16_t len, uint16_t *res)
+{
+    uint32_t start = xtimer_now_usec();
+    uint16_t sum = 0;
+
+    for (unsigned i = 0; i < ITERATIONS; i++) {
+        /* chaining the results keeps the compiler from hoisting the call */
+        sum = csum(sum, buf, len, 0);
+    }
+    *res = sum;
+    return xtimer_now_usec() - start;
+}
+
+int main(void)
+{
+    int res = 0;
+
+    puts("inet_csum benchmark");
+    for (unsigned i = 0; i < sizeof(_buf); i++) {
+        _buf[i] = i * 7;
+    }
+    for (unsigned i = 0; i < sizeof(_sizes) / sizeof(_sizes[0]); i++) {
+        for (unsigned off = 0; off < 2; off++) {
+            uint16_t len = _sizes[i], ref_sum, sum;
+            uint32_t ref = _run(_ref_csum_slice, _buf + off, len, &ref_sum);
+            uint32_t opt = _run(inet_csum_slice, _buf + off, len, &sum);
+
+            printf("{ \"bytes\" : %u, \"aligned\" : %u, \"ref_us\" : %lu, "
+                   "\"us\" : %lu, \"MB/s\" : %lu }\n", len, 1 - off,
+                   (unsigned long)ref, (unsigned long)opt,
+                   (opt > 0) ? (unsigned long)(((uint64_t)len * ITERATIONS) / opt)
+                             : 0UL);
+            if (sum != ref_sum) {
+                printf("checksum mismatch: 0x%04x != 0x%04x\n", sum, ref_sum);
+                res = 1;
+            }
+        }
+    }
+    if (res == 0) {
+        puts("done");
+    }
+    return res;
+}
@@ -67,7 +67,7 @@ int main(void)
     mutex_lock(&_mutex);
     thread_yield_higher();
 
-    xtimer_t timer;
+    xtimer_t timer = { 0 };
     timer.callback = _timer_callback;
 
     uint32_t n = 0;
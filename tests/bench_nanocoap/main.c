@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2018 OverDriveGain
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures building, parsing and reading the options of a CoAP
+ *              request with nanocoap
+ *
+ * @author      OverDriveGain
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "net/nanocoap.h"
+#include "xtimer.h"
+
+#ifndef TEST_ITERATIONS
+#define TEST_ITERATIONS     (10000U)
+#endif
+
+#define BUF_SIZE            (128U)
+
+static uint8_t _buf[BUF_SIZE];
+static size_t _len;
+static coap_pkt_t _pkt;
+/* keeps the compiler from dropping the reads */
+static volatile uint32_t _sink;
+
+/* nanocoap expects the application to provide a resource table */
+const coap_resource_t coap_resources[] = {
+    COAP_WELL_KNOWN_CORE_DEFAULT_HANDLER,
+};
+const unsigned coap_resources_numof = sizeof(coap_resources) / sizeof(coap_resources[0]);
+
+static void _build(void)
+{
+    uint8_t token[2] = { 0xDA, 0xEC };
+
+    coap_pkt_init(&_pkt, _buf, BUF_SIZE,
+                  coap_build_hdr((coap_hdr_t *)_buf, COAP_TYPE_CON, token,
+                                 sizeof(token), COAP_METHOD_GET, 0x1234));
+    coap_opt_add_uint(&_pkt, COAP_OPT_OBSERVE, 0);
+    coap_opt_add_string(&_pkt, COAP_OPT_URI_PATH, "/sensors/temp/value", '/');
+    coap_opt_add_uint(&_pkt, COAP_OPT_CONTENT_FORMAT, COAP_FORMAT_TEXT);
+    coap_opt_add_string(&_pkt, COAP_OPT_URI_QUERY, "&unit=C&avg=10", '&');
+    coap_opt_add_uint(&_pkt, COAP_OPT_BLOCK2, (1 << 4) | 2);
+    _len = coap_opt_finish(&_pkt, COAP_OPT_FINISH_NONE);
+}
+
+static void _parse(void)
+{
+    coap_parse(&_pkt, _buf, _len);
+}
+
+/* reads the options a handler typically looks at */
+static void _access(void)
+{
+    uint8_t str[NANOCOAP_URI_MAX];
+    uint32_t value;
+    unsigned szx;
+
+    coap_get_uri_path(&_pkt, str);
+    _sink = str[1];
+    coap_get_uri_query(&_pkt, str);
+    _sink = str[1];
+    coap_get_blockopt(&_pkt, COAP_OPT_BLOCK2, &value, &szx);
+    _sink = value;
+    coap_opt_get_uint(&_pkt, COAP_OPT_OBSERVE, &value);
+    _sink = value;
+    _sink = coap_get_content_type(&_pkt);
+}
+
+static unsigned long _measure(void (*func)(void))
+{
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < TEST_ITERATIONS; i++) {
+        func();
+    }
+    return (unsigned long)((uint64_t)(xtimer_now_usec() - start) * 1000 /
+                           TEST_ITERATIONS);
+}
+
+int main(void)
+{
+    puts("nanocoap parse/build benchmark");
+
+    unsigned long build = _measure(_build);
+    unsigned long parse = _measure(_parse);
+    unsigned long access = _measure(_access);
+
+    printf("{ \"bytes\" : %u, \"build ns\" : %lu, \"parse ns\" : %lu, \"access ns\" : %lu }\n",
+           (unsigned)_len, build, parse, access);
+    puts("done");
+    return 0;
+}
@@ -40,7 +40,7 @@ int main(void)
 {
     printf("main starting\n");
 
-    xtimer_t timer;
+    xtimer_t timer = { 0 };
     timer.callback = _timer_callback;
 
     uint32_t n = 0;
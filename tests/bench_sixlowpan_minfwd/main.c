@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2018 OverDriveGain
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures the round trip time of fragmented UDP datagrams
+ *              through a line of 6LoWPAN nodes
+ *
+ * @author      OverDriveGain
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "msg.h"
+#include "shell.h"
+#include "thread.h"
+#include "net/ipv6/addr.h"
+#include "net/sock/udp.h"
+#include "xtimer.h"
+
+#define ECHO_PORT           (6000U)
+#define MAIN_QUEUE_SIZE     (8U)
+/* largest UDP payload that fits into the IPv6 minimum MTU */
+#define PAYLOAD_MAX         (1232U)
+#define TIMEOUT_US          (2U * US_PER_SEC)
+
+static msg_t _main_msg_queue[MAIN_QUEUE_SIZE];
+static char _echo_stack[THREAD_STACKSIZE_DEFAULT];
+static uint8_t _echo_buf[PAYLOAD_MAX];
+static uint8_t _buf[PAYLOAD_MAX];
+
+static void *_echo_thread(void *arg)
+{
+    (void)arg;
+    sock_udp_ep_t local = { .family = AF_INET6, .port = ECHO_PORT };
+    sock_udp_t sock;
+
+    if (sock_udp_create(&sock, &local, NULL, 0) < 0) {
+        puts("unable to create echo server");
+        return NULL;
+    }
+    while (1) {
+        sock_udp_ep_t remote;
+        ssize_t res = sock_udp_recv(&sock, _echo_buf, sizeof(_echo_buf),
+                                    SOCK_NO_TIMEOUT, &remote);
+
+        if (res > 0) {
+            sock_udp_send(&sock, _echo_buf, res, &remote);
+        }
+    }
+    return NULL;
+}
+
+static int _udpbench(int argc, char **argv)
+{
+    sock_udp_ep_t local = SOCK_IPV6_EP_ANY;
+    sock_udp_ep_t remote = { .family = AF_INET6, .port = ECHO_PORT,
+                             .netif = SOCK_ADDR_ANY_NETIF };
+    uint32_t min = UINT32_MAX, max = 0;
+    uint64_t sum = 0;
+    unsigned size, count, lost = 0;
+    sock_udp_t sock;
+
+    if (argc < 4) {
+        printf("usage: %s <addr> <bytes> <count>\n", argv[0]);
+        return 1;
+    }
+    if (ipv6_addr_from_str((ipv6_addr_t *)&remote.addr.ipv6, argv[1]) == NULL) {
+        puts("invalid address");
+        return 1;
+    }
+    size = atoi(argv[2]);
+    count = atoi(argv[3]);
+    if ((size < sizeof(uint32_t)) || (size > PAYLOAD_MAX) || (count == 0)) {
+        printf("<bytes> must be between %u and %u\n",
+               (unsigned)sizeof(uint32_t), PAYLOAD_MAX);
+        return 1;
+    }
+    if (sock_udp_create(&sock, &local, NULL, 0) < 0) {
+        puts("unable to create socket");
+        return 1;
+    }
+    for (unsigned i = 0; i < count; i++) {
+        uint32_t start = xtimer_now_usec(), time;
+        ssize_t res;
+
+        memset(_buf, i, size);
+        memcpy(_buf, &i, sizeof(uint32_t));
+        if (sock_udp_send(&sock, _buf, size, &remote) < 0) {
+            lost++;
+            continue;
+        }
+        /* skip late echoes of earlier datagrams */
+        do {
+            res = sock_udp_recv(&sock, _buf, sizeof(_buf), TIMEOUT_US, NULL);
+        } while ((res > 0) && (memcmp(_buf, &i, sizeof(uint32_t)) != 0));
+        time = xtimer_now_usec() - start;
+        if (res != (ssize_t)size) {
+            lost++;
+            continue;
+        }
+        sum += time;
+        if (time < min) {
+            min = time;
+        }
+        if (time > max) {
+            max = time;
+        }
+    }
+    sock_udp_close(&sock);
+
+    if (lost == count) {
+        min = 0;
+    }
+    printf("{ \"bytes\" : %u, \"count\" : %u, \"lost\" : %u, "
+           "\"us\" : { \"min\" : %lu, \"avg\" : %lu, \"max\" : %lu } }\n",
+           size, count, lost, (unsigned long)min,
+           (unsigned long)((lost == count) ? 0 : (sum / (count - lost))),
+           (unsigned long)max);
+    return 0;
+}
+
+static const shell_command_t _commands[] = {
+    { "udpbench", "measure the round trip time of UDP echoes", _udpbench },
+    { NULL, NULL, NULL }
+};
+
+int main(void)
+{
+    char line_buf[SHELL_DEFAULT_BUFSIZE];
+
+    msg_init_queue(_main_msg_queue, MAIN_QUEUE_SIZE);
+    puts("6LoWPAN fragment forwarding benchmark");
+    thread_create(_echo_stack, sizeof(_echo_stack), THREAD_PRIORITY_MAIN - 1,
+                  THREAD_CREATE_STACKTEST, _echo_thread, NULL, "udp echo");
+    shell_run(_commands, line_buf, SHELL_DEFAULT_BUFSIZE);
+    return 0;
+}
@@ -0,0 +1,23 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2018 OverDriveGain
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact("6LoWPAN fragment forwarding benchmark")
+    # checks the measurement via the loopback interface only, the line of
+    # nodes is set up by hand (see README.md)
+    child.sendline("udpbench ::1 1000 10")
+    child.expect(r"{ \"bytes\" : 1000, \"count\" : 10, \"lost\" : 0, "
+                 r"\"us\" : { \"min\" : \d+, \"avg\" : \d+, \"max\" : \d+ } }")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc, timeout=30))
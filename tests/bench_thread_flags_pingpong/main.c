@@ -63,7 +63,7 @@ int main(void)
 
     thread_t *tcb = (thread_t *)sched_threads[other];
 
-    xtimer_t timer;
+    xtimer_t timer = { 0 };
     timer.callback = _timer_callback;
 
     uint32_t n = 0;
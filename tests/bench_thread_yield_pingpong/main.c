@@ -60,7 +60,7 @@ int main(void)
                   NULL,
                   "second_thread");
 
-    xtimer_t timer;
+    xtimer_t timer = { 0 };
     timer.callback = _timer_callback;
 
     uint32_t n = 0;
@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2018 OverDriveGain
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures xtimer_set() and xtimer_remove() with many live timers
+ *
+ * @author      OverDriveGain
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "random.h"
+#include "xtimer.h"
+
+#define OFFSET_MIN      (1U * US_PER_SEC)
+#define OFFSET_MAX      (100U * US_PER_SEC)
+
+static xtimer_t _timers[TIMERS_MAX];
+static xtimer_t _probe;
+
+static void _cb(void *arg)
+{
+    /* a live timer fired, the measurement is not meaningful anymore */
+    *(unsigned *)arg = 1;
+}
+
+int main(void)
+{
+    unsigned fired = 0;
+    unsigned live = 0;
+
+    puts("xtimer set/remove benchmark");
+    random_init(0);
+    _probe.callback = _cb;
+    _probe.arg = &fired;
+    for (unsigned numof = 0; numof <= TIMERS_MAX; numof = (numof) ? numof * 2 : 8) {
+        /* add live timers up to numof */
+        for (; live < numof; live++) {
+            _timers[live].callback = _cb;
+            _timers[live].arg = &fired;
+            xtimer_set(&_timers[live], random_uint32_range(OFFSET_MIN, OFFSET_MAX));
+        }
+
+        uint32_t start = xtimer_now_usec();
+        for (unsigned i = 0; i < ITERATIONS; i++) {
+            xtimer_set(&_probe, random_uint32_range(OFFSET_MIN, OFFSET_MAX));
+            xtimer_remove(&_probe);
+        }
+        uint32_t time = xtimer_now_usec() - start;
+
+        printf("{ \"timers\" : %u, \"ns/op\" : %lu }\n", numof,
+               (unsigned long)(((uint64_t)time * NS_PER_US) / ITERATIONS));
+    }
+    for (unsigned i = 0; i < live; i++) {
+        xtimer_remove(&_timers[i]);
+    }
+    if (fired) {
+        puts("a timer fired during the measurement");
+        return 1;
+    }
+    puts("done");
+    return 0;
+}
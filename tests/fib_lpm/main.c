@@ -0,0 +1,31 @@
+/*
+ * Copyright (C) 2018 OverDriveGain
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Runs the FIB unit tests with the longest-prefix-match index
+ *
+ * @author      OverDriveGain
+ *
+ * @}
+ */
+
+#include "embUnit.h"
+#include "tests-fib.h"
+
+int main(void)
+{
+    TESTS_START();
+    tests_fib();
+    TESTS_END();
+
+    return 0;
+}
@@ -19,6 +19,7 @@
  */
 
 #include <errno.h>
+#include <inttypes.h>
 #include <stdio.h>
 
 #include "cib.h"
@@ -32,6 +33,7 @@
 #include "net/gnrc/netif/internal.h"
 #include "net/ndp.h"
 #include "sched.h"
+#include "xtimer.h"
 
 #define _BUFFER_SIZE    (128)
 #define _CUR_HL         (155)
@@ -41,6 +43,7 @@
 #define _LOC_GB_PFX_LEN (45U)
 #define _REM_GB_PFX_LEN (37U)
 #define _PIO_PFX_LTIME  (0x8476fedf)
+#define _LOOKUPS        (10000U)
 
 static const uint8_t _loc_l2[] = { _LL0, _LL1, _LL2, _LL3, _LL4, _LL5 };
 static const ipv6_addr_t _loc_ll = { {
@@ -1344,6 +1347,80 @@ static Test *tests_gnrc_ipv6_nib(void)
     return (Test *)&tests;
 }
 
+/* fills the prefix list with a growing number of /64 prefixes and measures
+ * how long it takes to look up the route to a destination */
+static void _measure_route_lookup(void)
+{
+    static const unsigned numof[] = { 4, 16, 64, 256 };
+    ipv6_addr_t pfx = { .u8 = { 0x20, 0x01, 0x0d, 0xb8 } };
+
+    for (unsigned i = 0; i < sizeof(numof) / sizeof(numof[0]); i++) {
+        gnrc_ipv6_nib_ft_t fte;
+        uint32_t start;
+
+        if (numof[i] > GNRC_IPV6_NIB_OFFL_NUMOF) {
+            break;
+        }
+        _common_set_up();
+        for (unsigned j = 0; j < numof[i]; j++) {
+            pfx.u16[2] = byteorder_htons(j * 0x9e37);
+            if (gnrc_ipv6_nib_pl_set(_mock_netif->pid, &pfx, 64,
+                                     UINT32_MAX, UINT32_MAX) < 0) {
+                puts("adding prefix failed");
+                return;
+            }
+        }
+        start = xtimer_now_usec();
+        for (unsigned j = 0; j < _LOOKUPS; j++) {
+            /* look up a host within the last added prefix */
+            pfx.u16[7] = byteorder_htons(j);
+            if (gnrc_ipv6_nib_ft_get(&pfx, NULL, &fte) < 0) {
+                puts("route lookup failed");
+                return;
+            }
+        }
+        printf("{ \"prefixes\" : %u, \"lookups\" : %u, \"us\" : %" PRIu32 " }\n",
+               numof[i], _LOOKUPS, xtimer_now_usec() - start);
+        pfx.u16[7] = byteorder_htons(0);
+    }
+}
+
+static void _measure_neighbor_lookup(void)
+{
+    static const unsigned numof[] = { 4, 16, 64, 256 };
+    ipv6_addr_t addr = _rem_ll;
+
+    for (unsigned i = 0; i < sizeof(numof) / sizeof(numof[0]); i++) {
+        gnrc_ipv6_nib_nc_t nce;
+        uint32_t start;
+
+        if (numof[i] > GNRC_IPV6_NIB_NUMOF) {
+            break;
+        }
+        _common_set_up();
+        for (unsigned j = 0; j < numof[i]; j++) {
+            addr.u16[7] = byteorder_htons(j);
+            if (gnrc_ipv6_nib_nc_set(&addr, _mock_netif->pid, _rem_l2,
+                                     sizeof(_rem_l2)) < 0) {
+                puts("adding neighbor failed");
+                return;
+            }
+        }
+        start = xtimer_now_usec();
+        for (unsigned j = 0; j < _LOOKUPS; j++) {
+            /* resolve the neighbors added last */
+            addr.u16[7] = byteorder_htons(numof[i] - 1 - (j % 4));
+            if (gnrc_ipv6_nib_get_next_hop_l2addr(&addr, _mock_netif, NULL,
+                                                  &nce) < 0) {
+                puts("neighbor resolution failed");
+                return;
+            }
+        }
+        printf("{ \"neighbors\" : %u, \"lookups\" : %u, \"us\" : %" PRIu32 " }\n",
+               numof[i], _LOOKUPS, xtimer_now_usec() - start);
+    }
+}
+
 int main(void)
 {
     _tests_init();
@@ -1352,6 +1429,9 @@ int main(void)
     TESTS_RUN(tests_gnrc_ipv6_nib());
     TESTS_END();
 
+    _measure_route_lookup();
+    _measure_neighbor_lookup();
+
     return 0;
 }
 
@@ -13,6 +13,8 @@ from testrunner import run
 
 def testfunc(child):
     child.expect(r"OK \(\d+ tests\)")
+    child.expect(r"{ \"prefixes\" : 4, \"lookups\" : \d+, \"us\" : \d+ }")
+    child.expect(r"{ \"neighbors\" : 4, \"lookups\" : \d+, \"us\" : \d+ }")
 
 
 if __name__ == "__main__":
@@ -0,0 +1,233 @@
+/*
+ * Copyright (C) 2018 OverDriveGain
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests the prioritized transmit queue of gnrc_netif
+ *
+ * @author      OverDriveGain
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "embUnit.h"
+#include "msg.h"
+#include "net/gnrc/neterr.h"
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/netdev_test.h"
+#include "xtimer.h"
+
+#define MSG_QUEUE_SIZE  (32U)
+/* gives the interface the chance to retry */
+#define RETRY_WAIT      (4U * GNRC_NETIF_TXQ_RETRY)
+
+static char _netif_stack[THREAD_STACKSIZE_DEFAULT];
+static msg_t _main_msg_queue[MSG_QUEUE_SIZE];
+static netdev_test_t _dev;
+static gnrc_netif_t *_netif;
+static bool _busy;
+static uint8_t _sent[2 * GNRC_NETIF_TXQ_SIZE];
+static unsigned _sent_numof;
+
+static int _send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
+{
+    (void)netif;
+    if (_busy) {
+        gnrc_pktbuf_release(pkt);
+        return -EBUSY;
+    }
+    if (_sent_numof < sizeof(_sent)) {
+        _sent[_sent_numof++] = *((uint8_t *)pkt->data);
+    }
+    gnrc_pktbuf_release(pkt);
+    return 0;
+}
+
+static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif)
+{
+    (void)netif;
+    return NULL;
+}
+
+static const gnrc_netif_ops_t _ops = {
+    .send = _send,
+    .recv = _recv,
+    .get = gnrc_netif_get_from_netdev,
+    .set = gnrc_netif_set_from_netdev,
+};
+
+static int _get_netdev_device_type(netdev_t *netdev, void *value,
+                                   size_t max_len)
+{
+    (void)netdev;
+    (void)max_len;
+    assert(max_len == sizeof(uint16_t));
+    *((uint16_t *)value) = NETDEV_TYPE_UNKNOWN;
+    return sizeof(uint16_t);
+}
+
+static void _send_pkt(uint8_t id, gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, &id, sizeof(id), type);
+
+    TEST_ASSERT_NOT_NULL(pkt);
+    gnrc_neterr_reg(pkt);
+    TEST_ASSERT_EQUAL_INT(1, gnrc_netapi_send(_netif->pid, pkt));
+}
+
+/* returns the number of packets reported dropped with ENOBUFS since the last
+ * call */
+static unsigned _dropped(void)
+{
+    unsigned res = 0;
+    msg_t msg;
+
+    while (msg_try_receive(&msg) > 0) {
+        if ((msg.type == GNRC_NETERR_MSG_TYPE) &&
+            (msg.content.value == ENOBUFS)) {
+            res++;
+        }
+    }
+    return res;
+}
+
+static void _flush(void)
+{
+    _busy = false;
+    xtimer_usleep(RETRY_WAIT);
+    _dropped();
+}
+
+static void set_up(void)
+{
+    _busy = true;
+    _sent_numof = 0;
+    memset(&_dev.netdev.stats, 0, sizeof(netstats_t));
+}
+
+static void tear_down(void)
+{
+    _flush();
+}
+
+static void test_txq__retry_busy(void)
+{
+    _send_pkt(0, GNRC_NETTYPE_UNDEF);
+    _send_pkt(1, GNRC_NETTYPE_UNDEF);
+    TEST_ASSERT_EQUAL_INT(2, _netif->txq_len);
+    _busy = false;
+    xtimer_usleep(RETRY_WAIT);
+    TEST_ASSERT_EQUAL_INT(2, _sent_numof);
+    TEST_ASSERT_EQUAL_INT(0, _sent[0]);
+    TEST_ASSERT_EQUAL_INT(1, _sent[1]);
+    TEST_ASSERT_EQUAL_INT(0, _netif->txq_len);
+    TEST_ASSERT_EQUAL_INT(0, _dropped());
+}
+
+static void test_txq__control_first(void)
+{
+    _send_pkt(0, GNRC_NETTYPE_UNDEF);
+    _send_pkt(1, GNRC_NETTYPE_UNDEF);
+    _send_pkt(2, GNRC_NETTYPE_ICMPV6);
+    _send_pkt(3, GNRC_NETTYPE_UNDEF);
+    _busy = false;
+    xtimer_usleep(RETRY_WAIT);
+    TEST_ASSERT_EQUAL_INT(4, _sent_numof);
+    TEST_ASSERT_EQUAL_INT(2, _sent[0]);
+    TEST_ASSERT_EQUAL_INT(0, _sent[1]);
+    TEST_ASSERT_EQUAL_INT(1, _sent[2]);
+    TEST_ASSERT_EQUAL_INT(3, _sent[3]);
+}
+
+static void test_txq__full_drop_lowest_priority(void)
+{
+    netstats_t *stats = &_dev.netdev.stats;
+
+    for (unsigned i = 0; i < GNRC_NETIF_TXQ_SIZE; i++) {
+        _send_pkt(i, GNRC_NETTYPE_UNDEF);
+    }
+    TEST_ASSERT_EQUAL_INT(GNRC_NETIF_TXQ_SIZE, _netif->txq_len);
+    TEST_ASSERT_EQUAL_INT(0, _dropped());
+    /* a control packet replaces the last data packet */
+    _send_pkt(GNRC_NETIF_TXQ_SIZE, GNRC_NETTYPE_ICMPV6);
+    TEST_ASSERT_EQUAL_INT(1, _dropped());
+    TEST_ASSERT_EQUAL_INT(1, stats->tx_queue_drops);
+    /* a data packet finds no packet of a lower priority */
+    _send_pkt(GNRC_NETIF_TXQ_SIZE + 1, GNRC_NETTYPE_UNDEF);
+    TEST_ASSERT_EQUAL_INT(1, _dropped());
+    TEST_ASSERT_EQUAL_INT(2, stats->tx_queue_drops);
+    TEST_ASSERT_EQUAL_INT(GNRC_NETIF_TXQ_SIZE, _netif->txq_len);
+    TEST_ASSERT_EQUAL_INT(GNRC_NETIF_TXQ_SIZE, stats->tx_queue_max);
+    _busy = false;
+    xtimer_usleep(RETRY_WAIT);
+    TEST_ASSERT_EQUAL_INT(GNRC_NETIF_TXQ_SIZE, _sent_numof);
+    TEST_ASSERT_EQUAL_INT(GNRC_NETIF_TXQ_SIZE, _sent[0]);
+    for (unsigned i = 1; i < GNRC_NETIF_TXQ_SIZE; i++) {
+        TEST_ASSERT_EQUAL_INT(i - 1, _sent[i]);
+    }
+    TEST_ASSERT_EQUAL_INT(0, _netif->txq_len);
+}
+
+static void test_txq__stats_reset(void)
+{
+    netstats_t *stats = &_dev.netdev.stats;
+
+    _send_pkt(0, GNRC_NETTYPE_UNDEF);
+    _send_pkt(1, GNRC_NETTYPE_UNDEF);
+    /* what the shell's `ifconfig <if> stats l2 reset` does */
+    memset(stats, 0, sizeof(netstats_t));
+    _busy = false;
+    xtimer_usleep(RETRY_WAIT);
+    TEST_ASSERT_EQUAL_INT(2, _sent_numof);
+    TEST_ASSERT_EQUAL_INT(0, _netif->txq_len);
+    TEST_ASSERT_EQUAL_INT(0, stats->tx_queue_max);
+    _busy = true;
+    _send_pkt(2, GNRC_NETTYPE_UNDEF);
+    TEST_ASSERT_EQUAL_INT(1, _netif->txq_len);
+    TEST_ASSERT_EQUAL_INT(1, stats->tx_queue_max);
+}
+
+static Test *tests_gnrc_netif_txq(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_txq__retry_busy),
+        new_TestFixture(test_txq__control_first),
+        new_TestFixture(test_txq__full_drop_lowest_priority),
+        new_TestFixture(test_txq__stats_reset),
+    };
+
+    EMB_UNIT_TESTCALLER(gnrc_netif_txq_tests, set_up, tear_down, fixtures);
+
+    return (Test *)&gnrc_netif_txq_tests;
+}
+
+int main(void)
+{
+    msg_init_queue(_main_msg_queue, MSG_QUEUE_SIZE);
+    netdev_test_setup(&_dev, NULL);
+    netdev_test_set_get_cb(&_dev, NETOPT_DEVICE_TYPE, _get_netdev_device_type);
+    /* higher priority than main, so every packet is queued when
+     * gnrc_netapi_send() returns */
+    _netif = gnrc_netif_create(_netif_stack, sizeof(_netif_stack),
+                               THREAD_PRIORITY_MAIN - 1, "txq",
+                               (netdev_t *)&_dev, &_ops);
+
+    TESTS_START();
+    TESTS_RUN(tests_gnrc_netif_txq());
+    TESTS_END();
+
+    return 0;
+}
@@ -0,0 +1,292 @@
+/*
+ * Copyright (C) 2018 OverDriveGain
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests forwarding of 6LoWPAN fragments without reassembly
+ *
+ * @author      OverDriveGain
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "embUnit.h"
+#include "msg.h"
+#include "thread.h"
+#include "net/gnrc.h"
+#include "net/gnrc/ipv6/nib.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/sixlowpan/frag.h"
+#include "net/ipv6/hdr.h"
+#include "net/netdev_test.h"
+#include "net/sixlowpan.h"
+
+#define MAIN_QUEUE_SIZE     (16U)
+/* datagram bytes per received fragment, must be a multiple of 8 */
+#define FRAG_SIZE           (48U)
+/* makes the fragments to the next hop smaller than the received ones */
+#define MAX_FRAG_SIZE       (40U)
+#define DATAGRAM_SIZE       (200U)
+#define TAG                 (0x4711U)
+
+#define FRAG_NUMOF          ((DATAGRAM_SIZE + FRAG_SIZE - 1) / FRAG_SIZE)
+
+static uint8_t _src_l2[] = { 0x02, 0x00, 0x00, 0xff, 0xfe, 0x00, 0x01, 0x01 };
+static uint8_t _dst_l2[] = { 0x02, 0x00, 0x00, 0xff, 0xfe, 0x00, 0x00, 0x01 };
+static const uint8_t _next_hop_l2[] = { 0x02, 0x00, 0x00, 0xff,
+                                        0xfe, 0x00, 0x02, 0x01 };
+static const ipv6_addr_t _src = { .u8 = { 0x20, 0x01, 0x0d, 0xb8, [15] = 0x01 } };
+static const ipv6_addr_t _dst = { .u8 = { 0x20, 0x01, 0x0d, 0xb8, 0x00, 0x01,
+                                          [15] = 0x01 } };
+static char _netif_stack[THREAD_STACKSIZE_DEFAULT];
+static msg_t _main_msg_queue[MAIN_QUEUE_SIZE];
+static gnrc_netreg_entry_t _ipv6;
+static netdev_test_t _dev;
+static gnrc_netif_t *_netif;
+static uint8_t _datagram[DATAGRAM_SIZE];
+/* the datagram as the next hop receives it */
+static uint8_t _fwd[DATAGRAM_SIZE];
+static unsigned _fwd_bytes;
+
+static int _send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
+{
+    gnrc_netif_hdr_t *netif_hdr = pkt->data;
+    sixlowpan_frag_n_t *hdr = pkt->next->data;
+    uint16_t offset = 0;
+    uint8_t *data;
+
+    (void)netif;
+    if ((netif_hdr->dst_l2addr_len != sizeof(_next_hop_l2)) ||
+        (memcmp(gnrc_netif_hdr_get_dst_addr(netif_hdr), _next_hop_l2,
+                sizeof(_next_hop_l2)) != 0) ||
+        !sixlowpan_frag_is(pkt->next->data)) {
+        gnrc_pktbuf_release(pkt);
+        return 0;
+    }
+    if ((hdr->disp_size.u8[0] & SIXLOWPAN_FRAG_DISP_MASK) ==
+        SIXLOWPAN_FRAG_1_DISP) {
+        data = ((uint8_t *)pkt->next->data) + sizeof(sixlowpan_frag_t);
+        /* the IPv6 header is forwarded uncompressed */
+        if (*(data++) != SIXLOWPAN_UNCOMP) {
+            gnrc_pktbuf_release(pkt);
+            return 0;
+        }
+    }
+    else {
+        offset = hdr->offset * 8U;
+        data = (uint8_t *)(hdr + 1);
+    }
+    /* both headers are one byte longer than sixlowpan_frag_t */
+    size_t len = pkt->next->size - sizeof(sixlowpan_frag_n_t);
+
+    if ((offset + len) <= sizeof(_fwd)) {
+        memcpy(&_fwd[offset], data, len);
+        _fwd_bytes += len;
+    }
+    gnrc_pktbuf_release(pkt);
+    return 0;
+}
+
+static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif)
+{
+    (void)netif;
+    return NULL;
+}
+
+static const gnrc_netif_ops_t _ops = {
+    .send = _send,
+    .recv = _recv,
+    .get = gnrc_netif_get_from_netdev,
+    .set = gnrc_netif_set_from_netdev,
+};
+
+static int _get_netdev_device_type(netdev_t *netdev, void *value,
+                                   size_t max_len)
+{
+    (void)netdev;
+    (void)max_len;
+    assert(max_len == sizeof(uint16_t));
+    *((uint16_t *)value) = NETDEV_TYPE_UNKNOWN;
+    return sizeof(uint16_t);
+}
+
+/* passes fragment number frag of the datagram to 6LoWPAN */
+static void _recv_frag(uint16_t tag, unsigned frag)
+{
+    uint16_t offset = frag * FRAG_SIZE;
+    size_t len = DATAGRAM_SIZE - offset;
+    size_t hdr_len = (offset == 0) ? (sizeof(sixlowpan_frag_t) + 1)
+                                   : sizeof(sixlowpan_frag_n_t);
+    gnrc_pktsnip_t *netif, *pkt;
+    sixlowpan_frag_t *hdr;
+    uint8_t *data;
+
+    if (len > FRAG_SIZE) {
+        len = FRAG_SIZE;
+    }
+    netif = gnrc_netif_hdr_build(_src_l2, sizeof(_src_l2),
+                                 _dst_l2, sizeof(_dst_l2));
+    TEST_ASSERT_NOT_NULL(netif);
+    ((gnrc_netif_hdr_t *)netif->data)->if_pid = _netif->pid;
+    pkt = gnrc_pktbuf_add(netif, NULL, hdr_len + len, GNRC_NETTYPE_SIXLOWPAN);
+    TEST_ASSERT_NOT_NULL(pkt);
+    hdr = pkt->data;
+    hdr->disp_size = byteorder_htons(DATAGRAM_SIZE);
+    hdr->tag = byteorder_htons(tag);
+    if (offset == 0) {
+        hdr->disp_size.u8[0] |= SIXLOWPAN_FRAG_1_DISP;
+        data = (uint8_t *)(hdr + 1);
+        *(data++) = SIXLOWPAN_UNCOMP;
+    }
+    else {
+        sixlowpan_frag_n_t *hdr_n = pkt->data;
+
+        hdr_n->disp_size.u8[0] |= SIXLOWPAN_FRAG_N_DISP;
+        hdr_n->offset = offset / 8;
+        data = (uint8_t *)(hdr_n + 1);
+    }
+    memcpy(data, &_datagram[offset], len);
+    gnrc_sixlowpan_frag_recv(pkt, NULL, 0);
+}
+
+/* returns the number of datagrams that were reassembled instead of
+ * forwarded */
+static unsigned _reassembled(void)
+{
+    unsigned count = 0;
+    msg_t msg;
+
+    while (msg_try_receive(&msg) > 0) {
+        if (msg.type == GNRC_SIXLOWPAN_MSG_FRAG_GC_RBUF) {
+            gnrc_sixlowpan_frag_rbuf_gc();
+        }
+        else if (msg.type == GNRC_NETAPI_MSG_TYPE_RCV) {
+            gnrc_pktbuf_release(msg.content.ptr);
+            count++;
+        }
+    }
+    return count;
+}
+
+static void _check_forwarded(void)
+{
+    ipv6_hdr_t *ipv6_hdr = (ipv6_hdr_t *)_datagram;
+
+    TEST_ASSERT_EQUAL_INT(0, _reassembled());
+    TEST_ASSERT_EQUAL_INT(DATAGRAM_SIZE, _fwd_bytes);
+    /* the only change on the way is the hop limit */
+    ipv6_hdr->hl--;
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_datagram, _fwd, DATAGRAM_SIZE));
+    ipv6_hdr->hl++;
+    /* no fragment is left in the reassembly buffer */
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void _set_up(void)
+{
+    _reassembled();
+    memset(_fwd, 0, sizeof(_fwd));
+    _fwd_bytes = 0;
+}
+
+static void test_minfwd__in_order(void)
+{
+    for (unsigned i = 0; i < FRAG_NUMOF; i++) {
+        _recv_frag(TAG, i);
+    }
+    _check_forwarded();
+}
+
+static void test_minfwd__duplicate_first(void)
+{
+    _recv_frag(TAG + 1, 2);
+    _recv_frag(TAG + 1, 0);
+    _recv_frag(TAG + 1, 1);
+    _recv_frag(TAG + 1, 3);
+    /* retransmission after later fragments must not be relayed as a
+     * subsequent fragment */
+    _recv_frag(TAG + 1, 0);
+    _recv_frag(TAG + 1, 4);
+    _check_forwarded();
+}
+
+static void test_minfwd__duplicate_middle(void)
+{
+    _recv_frag(TAG + 2, 0);
+    _recv_frag(TAG + 2, 1);
+    _recv_frag(TAG + 2, 2);
+    _recv_frag(TAG + 2, 3);
+    /* retransmissions must not count towards the size of the datagram, or
+     * the last fragment would find its datagram forgotten */
+    _recv_frag(TAG + 2, 1);
+    _recv_frag(TAG + 2, 2);
+    _recv_frag(TAG + 2, 4);
+    _check_forwarded();
+}
+
+static Test *tests_gnrc_sixlowpan_frag_minfwd(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_minfwd__in_order),
+        new_TestFixture(test_minfwd__duplicate_first),
+        new_TestFixture(test_minfwd__duplicate_middle),
+    };
+
+    EMB_UNIT_TESTCALLER(tests, _set_up, NULL, fixtures);
+
+    return (Test *)&tests;
+}
+
+int main(void)
+{
+    ipv6_hdr_t *ipv6_hdr = (ipv6_hdr_t *)_datagram;
+    gnrc_netreg_entry_t *entry;
+
+    msg_init_queue(_main_msg_queue, MAIN_QUEUE_SIZE);
+    /* reassembled datagrams go to this thread only */
+    while ((entry = gnrc_netreg_lookup(GNRC_NETTYPE_IPV6,
+                                       GNRC_NETREG_DEMUX_CTX_ALL)) != NULL) {
+        gnrc_netreg_unregister(GNRC_NETTYPE_IPV6, entry);
+    }
+    gnrc_netreg_entry_init_pid(&_ipv6, GNRC_NETREG_DEMUX_CTX_ALL, thread_getpid());
+    gnrc_netreg_register(GNRC_NETTYPE_IPV6, &_ipv6);
+
+    netdev_test_setup(&_dev, NULL);
+    netdev_test_set_get_cb(&_dev, NETOPT_DEVICE_TYPE, _get_netdev_device_type);
+    /* higher priority than main, so every fragment is recorded when it is
+     * relayed */
+    _netif = gnrc_netif_create(_netif_stack, sizeof(_netif_stack),
+                               THREAD_PRIORITY_MAIN - 1, "minfwd",
+                               (netdev_t *)&_dev, &_ops);
+    _netif->sixlo.max_frag_size = MAX_FRAG_SIZE;
+    /* the destination is a neighbor behind the interface */
+    gnrc_ipv6_nib_nc_set(&_dst, _netif->pid, _next_hop_l2,
+                         sizeof(_next_hop_l2));
+
+    for (unsigned i = sizeof(ipv6_hdr_t); i < DATAGRAM_SIZE; i++) {
+        _datagram[i] = (uint8_t)(i * 3);
+    }
+    ipv6_hdr_set_version(ipv6_hdr);
+    ipv6_hdr->len = byteorder_htons(DATAGRAM_SIZE - sizeof(ipv6_hdr_t));
+    ipv6_hdr->nh = PROTNUM_UDP;
+    ipv6_hdr->hl = 64;
+    ipv6_hdr->src = _src;
+    ipv6_hdr->dst = _dst;
+
+    TESTS_START();
+    TESTS_RUN(tests_gnrc_sixlowpan_frag_minfwd());
+    TESTS_END();
+
+    return 0;
+}
@@ -0,0 +1,274 @@
+/*
+ * Copyright (C) 2018 OverDriveGain
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests the order and timing in which the 6LoWPAN thread sends
+ *              the fragments of concurrent datagrams
+ *
+ * @author      OverDriveGain
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "embUnit.h"
+#include "msg.h"
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/netreg.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/sixlowpan.h"
+#include "net/gnrc/sixlowpan/frag.h"
+#include "net/ipv6/hdr.h"
+#include "net/netdev_test.h"
+#include "net/sixlowpan.h"
+#include "thread.h"
+#include "utlist.h"
+#include "xtimer.h"
+
+#define MAX_FRAG_SIZE       (48U)
+#define PAYLOAD_SIZE        (120U)
+#define DATAGRAM_SIZE       (sizeof(ipv6_hdr_t) + PAYLOAD_SIZE)
+#define FRAGS_MAX           (16U)
+/* time for all fragments of a datagram, and an extra interval */
+#define WAIT                (((DATAGRAM_SIZE / 8U) + 2U) * \
+                             GNRC_SIXLOWPAN_FRAG_PACING)
+
+typedef struct {
+    uint32_t time;
+    uint16_t tag;
+    uint16_t offset;
+    uint16_t len;
+} frag_t;
+
+static uint8_t _dst[] = { 0xaf, 0xfe };
+static char _netif_stack[THREAD_STACKSIZE_DEFAULT];
+static char _sender_stack[THREAD_STACKSIZE_DEFAULT];
+static netdev_test_t _dev;
+static gnrc_netif_t *_netif;
+static frag_t _frags[FRAGS_MAX];
+static unsigned _frags_numof;
+static gnrc_pktsnip_t *_datagrams[2];
+static unsigned _datagrams_numof;
+/* keep the 6LoWPAN thread's message queue full after the first fragment */
+static bool _fill_queue;
+
+static int _send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
+{
+    sixlowpan_frag_n_t *hdr = pkt->next->data;
+
+    (void)netif;
+    if (sixlowpan_frag_is(pkt->next->data) &&
+        (_frags_numof < FRAGS_MAX)) {
+        frag_t *frag = &_frags[_frags_numof++];
+
+        frag->time = xtimer_now_usec();
+        frag->tag = byteorder_ntohs(hdr->tag);
+        if ((hdr->disp_size.u8[0] & SIXLOWPAN_FRAG_DISP_MASK) ==
+            SIXLOWPAN_FRAG_1_DISP) {
+            /* the first fragment carries the uncompressed dispatch */
+            frag->offset = 0;
+            frag->len = gnrc_pkt_len(pkt->next) - sizeof(sixlowpan_frag_t) - 1;
+        }
+        else {
+            frag->offset = hdr->offset * 8U;
+            frag->len = gnrc_pkt_len(pkt->next) - sizeof(sixlowpan_frag_n_t);
+        }
+    }
+    gnrc_pktbuf_release(pkt);
+    return 0;
+}
+
+static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif)
+{
+    (void)netif;
+    return NULL;
+}
+
+static const gnrc_netif_ops_t _ops = {
+    .send = _send,
+    .recv = _recv,
+    .get = gnrc_netif_get_from_netdev,
+    .set = gnrc_netif_set_from_netdev,
+};
+
+static int _get_netdev_device_type(netdev_t *netdev, void *value,
+                                   size_t max_len)
+{
+    (void)netdev;
+    (void)max_len;
+    assert(max_len == sizeof(uint16_t));
+    *((uint16_t *)value) = NETDEV_TYPE_UNKNOWN;
+    return sizeof(uint16_t);
+}
+
+static void _build_datagram(gnrc_pktsnip_t **datagram)
+{
+    gnrc_pktsnip_t *pkt, *netif_hdr;
+
+    pkt = gnrc_pktbuf_add(NULL, NULL, PAYLOAD_SIZE, GNRC_NETTYPE_UNDEF);
+    TEST_ASSERT_NOT_NULL(pkt);
+    pkt = gnrc_pktbuf_add(pkt, NULL, sizeof(ipv6_hdr_t), GNRC_NETTYPE_IPV6);
+    TEST_ASSERT_NOT_NULL(pkt);
+    netif_hdr = gnrc_netif_hdr_build(NULL, 0, _dst, sizeof(_dst));
+    TEST_ASSERT_NOT_NULL(netif_hdr);
+    ((gnrc_netif_hdr_t *)netif_hdr->data)->if_pid = _netif->pid;
+    LL_PREPEND(pkt, netif_hdr);
+    *datagram = pkt;
+}
+
+/* runs with a higher priority than the 6LoWPAN thread, so all datagrams are
+ * queued before the first fragment is sent */
+static void *_sender(void *arg)
+{
+    kernel_pid_t sixlowpan_pid;
+
+    (void)arg;
+    sixlowpan_pid = gnrc_netreg_lookup(GNRC_NETTYPE_SIXLOWPAN,
+                                       GNRC_NETREG_DEMUX_CTX_ALL)->target.pid;
+    for (unsigned i = 0; i < _datagrams_numof; i++) {
+        gnrc_netapi_send(sixlowpan_pid, _datagrams[i]);
+    }
+    if (_fill_queue) {
+        msg_t msg = { .type = GNRC_SIXLOWPAN_MSG_FRAG_GC_RBUF };
+
+        /* let the first fragment go out */
+        xtimer_usleep(GNRC_SIXLOWPAN_FRAG_PACING / 2);
+        while (msg_try_send(&msg, sixlowpan_pid) > 0) {}
+        /* don't let the 6LoWPAN thread empty its queue until the next
+         * fragment is due */
+        xtimer_spin(xtimer_ticks_from_usec(GNRC_SIXLOWPAN_FRAG_PACING));
+    }
+    return NULL;
+}
+
+static void _run(unsigned datagrams, bool fill_queue)
+{
+    for (unsigned i = 0; i < datagrams; i++) {
+        _build_datagram(&_datagrams[i]);
+    }
+    _datagrams_numof = datagrams;
+    _fill_queue = fill_queue;
+    thread_create(_sender_stack, sizeof(_sender_stack),
+                  GNRC_SIXLOWPAN_PRIO - 1, THREAD_CREATE_STACKTEST,
+                  _sender, NULL, "sender");
+    xtimer_usleep(WAIT);
+}
+
+/* checks that the fragments of tag cover the datagram with at least
+ * GNRC_SIXLOWPAN_FRAG_PACING between them, counts them in numof */
+static void _check_datagram(uint16_t tag, unsigned *numof)
+{
+    const frag_t *last = NULL;
+    uint16_t offset = 0;
+
+    *numof = 0;
+
+    for (unsigned i = 0; i < _frags_numof; i++) {
+        const frag_t *frag = &_frags[i];
+
+        if (frag->tag != tag) {
+            continue;
+        }
+        TEST_ASSERT_EQUAL_INT(offset, frag->offset);
+        if (last != NULL) {
+            TEST_ASSERT((frag->time - last->time) >=
+                        GNRC_SIXLOWPAN_FRAG_PACING);
+        }
+        offset += frag->len;
+        last = frag;
+        (*numof)++;
+    }
+    TEST_ASSERT_EQUAL_INT(DATAGRAM_SIZE, offset);
+}
+
+static void set_up(void)
+{
+    _frags_numof = 0;
+}
+
+static void test_frag__pacing(void)
+{
+    unsigned numof;
+
+    _run(1, false);
+    _check_datagram(_frags[0].tag, &numof);
+    TEST_ASSERT(numof > 2);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_frag__interleave(void)
+{
+    unsigned numof, numof_other;
+
+    _run(2, false);
+    TEST_ASSERT(_frags[0].tag != _frags[1].tag);
+    _check_datagram(_frags[0].tag, &numof);
+    _check_datagram(_frags[1].tag, &numof_other);
+    TEST_ASSERT_EQUAL_INT(numof, numof_other);
+    TEST_ASSERT_EQUAL_INT(2 * numof, _frags_numof);
+    /* the datagrams take turns and don't wait for each other */
+    for (unsigned i = 2; i < _frags_numof; i++) {
+        TEST_ASSERT_EQUAL_INT(_frags[i - 2].tag, _frags[i].tag);
+    }
+    TEST_ASSERT((_frags[1].time - _frags[0].time) <
+                GNRC_SIXLOWPAN_FRAG_PACING);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_frag__queue_full(void)
+{
+    unsigned numof;
+
+    _run(1, true);
+    TEST_ASSERT(_frags_numof > 0);
+    /* the next fragment came an interval late, but the datagram is complete */
+    _check_datagram(_frags[0].tag, &numof);
+    TEST_ASSERT(numof > 2);
+    TEST_ASSERT((_frags[1].time - _frags[0].time) >=
+                (2 * GNRC_SIXLOWPAN_FRAG_PACING));
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static Test *tests_gnrc_sixlowpan_frag_pacing(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_frag__pacing),
+        new_TestFixture(test_frag__interleave),
+        new_TestFixture(test_frag__queue_full),
+    };
+
+    EMB_UNIT_TESTCALLER(gnrc_sixlowpan_frag_pacing_tests, set_up, NULL,
+                        fixtures);
+
+    return (Test *)&gnrc_sixlowpan_frag_pacing_tests;
+}
+
+int main(void)
+{
+    netdev_test_setup(&_dev, NULL);
+    netdev_test_set_get_cb(&_dev, NETOPT_DEVICE_TYPE, _get_netdev_device_type);
+    /* higher priority than the 6LoWPAN thread and the sender, so every
+     * fragment is recorded when it is sent */
+    _netif = gnrc_netif_create(_netif_stack, sizeof(_netif_stack),
+                               GNRC_SIXLOWPAN_PRIO - 2, "6lo",
+                               (netdev_t *)&_dev, &_ops);
+    _netif->sixlo.max_frag_size = MAX_FRAG_SIZE;
+
+    TESTS_START();
+    TESTS_RUN(tests_gnrc_sixlowpan_frag_pacing());
+    TESTS_END();
+
+    return 0;
+}
@@ -0,0 +1,314 @@
+/*
+ * Copyright (C) 2018 OverDriveGain
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Stress test for the 6LoWPAN reassembly buffer
+ *
+ * Replays interleaved, reordered and duplicated fragments of datagrams from
+ * several sources and checks the reassembled datagrams.
+ *
+ * @author      OverDriveGain
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "embUnit.h"
+#include "msg.h"
+#include "thread.h"
+#include "net/gnrc.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/sixlowpan/frag.h"
+#include "net/sixlowpan.h"
+#include "xtimer.h"
+
+#define MAIN_QUEUE_SIZE     (16U)
+#define SRC_NUMOF           (GNRC_SIXLOWPAN_FRAG_RBUF_SIZE)
+/* datagram bytes per fragment, must be a multiple of 8 */
+#define FRAG_SIZE           (48U)
+#define DATAGRAM_SIZE       (200U)
+/* only GNRC_SIXLOWPAN_FRAG_RBUF_MEM / LARGE_SIZE of these fit */
+#define LARGE_SIZE          (520U)
+#define TAG                 (0x4711U)
+/* packet buffer space taken by other layers, in chunks of */
+#define BLOCKER_SIZE        (64U)
+/* chunks given back, enough for fragments but not for a LARGE_SIZE datagram */
+#define BLOCKER_FREE        (3U)
+/* same as RBUF_TIMEOUT of the reassembly buffer */
+#define RBUF_TIMEOUT_US     (3U * US_PER_SEC)
+
+#define FRAG_NUMOF(size)    (((size) + FRAG_SIZE - 1) / FRAG_SIZE)
+
+static uint8_t _dst_l2[] = { 0x02, 0x00, 0x00, 0xff, 0xfe, 0x00, 0x00, 0x01 };
+static msg_t _main_msg_queue[MAIN_QUEUE_SIZE];
+static gnrc_netreg_entry_t _ipv6;
+/* bit field of the sources of the datagrams found by _received() */
+static unsigned _received_from;
+
+static uint8_t _byte(unsigned src, uint16_t tag, unsigned i)
+{
+    switch (i) {
+        case 0:
+            return src;
+        case 1:
+            return tag & 0xff;
+        default:
+            return (uint8_t)((src * 31) + (tag * 7) + i);
+    }
+}
+
+/* passes len bytes at offset of a datagram to 6LoWPAN */
+static void _send_frag(unsigned src, uint16_t tag, uint16_t size,
+                       uint16_t offset, size_t len)
+{
+    uint8_t src_l2[] = { 0x02, 0x00, 0x00, 0xff, 0xfe, 0x00, 0x01, src };
+    size_t hdr_len = (offset == 0) ? (sizeof(sixlowpan_frag_t) + 1)
+                                   : sizeof(sixlowpan_frag_n_t);
+    gnrc_pktsnip_t *netif, *pkt;
+    sixlowpan_frag_t *hdr;
+    uint8_t *data;
+
+    netif = gnrc_netif_hdr_build(src_l2, sizeof(src_l2), _dst_l2, sizeof(_dst_l2));
+    TEST_ASSERT_NOT_NULL(netif);
+    pkt = gnrc_pktbuf_add(netif, NULL, hdr_len + len, GNRC_NETTYPE_SIXLOWPAN);
+    TEST_ASSERT_NOT_NULL(pkt);
+    hdr = pkt->data;
+    hdr->disp_size = byteorder_htons(size);
+    hdr->tag = byteorder_htons(tag);
+    if (offset == 0) {
+        hdr->disp_size.u8[0] |= SIXLOWPAN_FRAG_1_DISP;
+        data = (uint8_t *)(hdr + 1);
+        *(data++) = SIXLOWPAN_UNCOMP;
+    }
+    else {
+        sixlowpan_frag_n_t *hdr_n = pkt->data;
+
+        hdr_n->disp_size.u8[0] |= SIXLOWPAN_FRAG_N_DISP;
+        hdr_n->offset = offset / 8;
+        data = (uint8_t *)(hdr_n + 1);
+    }
+    for (unsigned i = 0; i < len; i++) {
+        data[i] = _byte(src, tag, offset + i);
+    }
+    gnrc_sixlowpan_frag_recv(pkt, NULL, 0);
+}
+
+/* passes fragment number frag of a datagram to 6LoWPAN */
+static void _send(unsigned src, uint16_t tag, uint16_t size, unsigned frag)
+{
+    uint16_t offset = frag * FRAG_SIZE;
+    size_t len = size - offset;
+
+    if (len > FRAG_SIZE) {
+        len = FRAG_SIZE;
+    }
+    _send_frag(src, tag, size, offset, len);
+}
+
+static bool _valid(gnrc_pktsnip_t *pkt)
+{
+    uint8_t *data = pkt->data;
+    unsigned src = data[0];
+    /* the upper byte of the tag is the same for all complete datagrams */
+    uint16_t tag = (TAG & 0xff00) | data[1];
+    for (unsigned i = 0; i < pkt->size; i++) {
+        if (data[i] != _byte(src, tag, i)) {
+            return false;
+        }
+    }
+    _received_from |= (1U << src);
+    return true;
+}
+
+/* counts and releases the valid datagrams that were reassembled */
+static unsigned _received(void)
+{
+    unsigned count = 0;
+    msg_t msg;
+
+    _received_from = 0;
+    while (msg_try_receive(&msg) > 0) {
+        if (msg.type == GNRC_SIXLOWPAN_MSG_FRAG_GC_RBUF) {
+            gnrc_sixlowpan_frag_rbuf_gc();
+        }
+        else if (msg.type == GNRC_NETAPI_MSG_TYPE_RCV) {
+            if (_valid(msg.content.ptr)) {
+                count++;
+            }
+            gnrc_pktbuf_release(msg.content.ptr);
+        }
+    }
+    return count;
+}
+
+/* lets all incomplete datagrams time out */
+static void _flush(void)
+{
+    xtimer_usleep(RBUF_TIMEOUT_US + (10U * US_PER_MS));
+    gnrc_sixlowpan_frag_rbuf_gc();
+    _received();
+}
+
+static void _set_up(void)
+{
+    _received();
+}
+
+static void test_rbuf__interleaved(void)
+{
+    for (unsigned i = 0; i < FRAG_NUMOF(DATAGRAM_SIZE); i++) {
+        for (unsigned src = 0; src < SRC_NUMOF; src++) {
+            /* every other source sends its fragments in reverse order */
+            unsigned frag = (src & 1) ? (FRAG_NUMOF(DATAGRAM_SIZE) - 1 - i) : i;
+
+            _send(src, TAG + src, DATAGRAM_SIZE, frag);
+        }
+    }
+    TEST_ASSERT_EQUAL_INT(SRC_NUMOF, _received());
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_rbuf__duplicates(void)
+{
+    for (unsigned i = 0; i < FRAG_NUMOF(DATAGRAM_SIZE); i++) {
+        _send(0, TAG, DATAGRAM_SIZE, i);
+        if (i < (FRAG_NUMOF(DATAGRAM_SIZE) - 1)) {
+            /* must not count towards the size of the datagram */
+            _send(0, TAG, DATAGRAM_SIZE, i);
+        }
+    }
+    TEST_ASSERT_EQUAL_INT(1, _received());
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_rbuf__per_src(void)
+{
+    _send(1, TAG + 1, DATAGRAM_SIZE, 0);
+    /* source 0 starts more datagrams than the buffer holds */
+    for (unsigned i = 0; i < (2 * GNRC_SIXLOWPAN_FRAG_RBUF_SIZE); i++) {
+        _send(0, TAG + (i << 8), DATAGRAM_SIZE, 0);
+    }
+    for (unsigned i = 1; i < FRAG_NUMOF(DATAGRAM_SIZE); i++) {
+        _send(1, TAG + 1, DATAGRAM_SIZE, i);
+    }
+    TEST_ASSERT_EQUAL_INT(1, _received());
+    TEST_ASSERT_EQUAL_INT(1U << 1, _received_from);
+    _flush();
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_rbuf__mem(void)
+{
+    _send(0, TAG, GNRC_SIXLOWPAN_FRAG_RBUF_MEM + 8, 0);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+    for (unsigned src = 0; src < 4; src++) {
+        _send(src, TAG + src, LARGE_SIZE, 0);
+    }
+    /* the datagram of source 0 made room for the one of source 3 */
+    for (unsigned src = 1; src < 4; src++) {
+        for (unsigned i = 1; i < FRAG_NUMOF(LARGE_SIZE); i++) {
+            _send(src, TAG + src, LARGE_SIZE, i);
+        }
+    }
+    TEST_ASSERT_EQUAL_INT(3, _received());
+    TEST_ASSERT_EQUAL_INT(0xe, _received_from);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_rbuf__too_big(void)
+{
+    _send(0, TAG, DATAGRAM_SIZE, 0);
+    /* ends beyond the datagram */
+    _send_frag(0, TAG, DATAGRAM_SIZE, DATAGRAM_SIZE - 8, 16);
+    TEST_ASSERT_EQUAL_INT(0, _received());
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_rbuf__pktbuf_full(void)
+{
+    gnrc_pktsnip_t *blocker[GNRC_PKTBUF_SIZE / BLOCKER_SIZE];
+    unsigned blocker_numof = 0;
+
+    _send(0, TAG, DATAGRAM_SIZE, 0);
+    _send(1, TAG + 1, DATAGRAM_SIZE, 0);
+    /* other layers take the rest of the packet buffer ... */
+    while ((blocker_numof < (sizeof(blocker) / sizeof(blocker[0]))) &&
+           ((blocker[blocker_numof] = gnrc_pktbuf_add(NULL, NULL, BLOCKER_SIZE,
+                                                      GNRC_NETTYPE_UNDEF)))) {
+        blocker_numof++;
+    }
+    TEST_ASSERT(blocker_numof > BLOCKER_FREE);
+    /* ... but leave enough for the fragments */
+    for (unsigned i = 0; i < BLOCKER_FREE; i++) {
+        gnrc_pktbuf_release(blocker[--blocker_numof]);
+    }
+    /* the incomplete datagrams don't add up to the new one */
+    _send(2, TAG + 2, LARGE_SIZE, 0);
+    for (unsigned src = 0; src < 2; src++) {
+        for (unsigned i = 1; i < FRAG_NUMOF(DATAGRAM_SIZE); i++) {
+            _send(src, TAG + src, DATAGRAM_SIZE, i);
+        }
+    }
+    TEST_ASSERT_EQUAL_INT(2, _received());
+    TEST_ASSERT_EQUAL_INT(0x3, _received_from);
+    while (blocker_numof > 0) {
+        gnrc_pktbuf_release(blocker[--blocker_numof]);
+    }
+    _flush();
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_rbuf__timeout(void)
+{
+    _send(0, TAG, DATAGRAM_SIZE, 0);
+    TEST_ASSERT(!gnrc_pktbuf_is_empty());
+    _flush();
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static Test *tests_gnrc_sixlowpan_frag_rbuf(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_rbuf__interleaved),
+        new_TestFixture(test_rbuf__duplicates),
+        new_TestFixture(test_rbuf__per_src),
+        new_TestFixture(test_rbuf__mem),
+        new_TestFixture(test_rbuf__too_big),
+        new_TestFixture(test_rbuf__pktbuf_full),
+        new_TestFixture(test_rbuf__timeout),
+    };
+
+    EMB_UNIT_TESTCALLER(tests, _set_up, NULL, fixtures);
+
+    return (Test *)&tests;
+}
+
+int main(void)
+{
+    gnrc_netreg_entry_t *entry;
+
+    msg_init_queue(_main_msg_queue, MAIN_QUEUE_SIZE);
+    /* reassembled datagrams go to this thread only */
+    while ((entry = gnrc_netreg_lookup(GNRC_NETTYPE_IPV6,
+                                       GNRC_NETREG_DEMUX_CTX_ALL)) != NULL) {
+        gnrc_netreg_unregister(GNRC_NETTYPE_IPV6, entry);
+    }
+    gnrc_netreg_entry_init_pid(&_ipv6, GNRC_NETREG_DEMUX_CTX_ALL, thread_getpid());
+    gnrc_netreg_register(GNRC_NETTYPE_IPV6, &_ipv6);
+
+    TESTS_START();
+    TESTS_RUN(tests_gnrc_sixlowpan_frag_rbuf());
+    TESTS_END();
+
+    return 0;
+}
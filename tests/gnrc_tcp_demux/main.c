@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2018 OverDriveGain
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests that GNRC TCP maps segments to the right connection
+ *              while passive and active opens go through its hash tables
+ *
+ * @author      OverDriveGain
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdint.h>
+
+#include "embUnit.h"
+#include "msg.h"
+#include "thread.h"
+#include "net/af.h"
+#include "net/gnrc/tcp.h"
+#include "xtimer.h"
+
+#define CONNS               (4U)
+#define PORT                (20000U)
+/* fits into the initial receive window */
+#define DATA_SIZE           (200U)
+#define TIMEOUT             (US_PER_SEC)
+#define MAIN_QUEUE_SIZE     (4U)
+
+static gnrc_tcp_tcb_t _srv[CONNS];
+static gnrc_tcp_tcb_t _cli[CONNS];
+static uint8_t _data[DATA_SIZE];
+static char _srv_stack[THREAD_STACKSIZE_MAIN];
+static msg_t _main_msg_queue[MAIN_QUEUE_SIZE];
+static kernel_pid_t _main_pid;
+
+/* runs with a higher priority than main, so each listener is open before
+ * main connects to it */
+static void *_server(void *arg)
+{
+    (void)arg;
+    for (unsigned i = 0; i < CONNS; i++) {
+        msg_t msg;
+
+        gnrc_tcp_tcb_init(&_srv[i]);
+        msg.content.value = (uint32_t)gnrc_tcp_open_passive(&_srv[i], AF_INET6,
+                                                            NULL, PORT + i);
+        msg_send(&msg, _main_pid);
+    }
+    return NULL;
+}
+
+/* connects all clients, each with its own listener */
+static void _connect(void)
+{
+    thread_create(_srv_stack, sizeof(_srv_stack), THREAD_PRIORITY_MAIN - 1,
+                  THREAD_CREATE_STACKTEST, _server, NULL, "server");
+    for (unsigned i = 0; i < CONNS; i++) {
+        char addr[] = "::1";
+        msg_t msg;
+
+        gnrc_tcp_tcb_init(&_cli[i]);
+        TEST_ASSERT_EQUAL_INT(0, gnrc_tcp_open_active(&_cli[i], AF_INET6, addr,
+                                                      PORT + i, 0));
+        msg_receive(&msg);
+        TEST_ASSERT_EQUAL_INT(0, (int)msg.content.value);
+    }
+}
+
+static void _exchange(gnrc_tcp_tcb_t *from, gnrc_tcp_tcb_t *to, uint8_t byte)
+{
+    uint8_t rcvd = ~byte;
+
+    TEST_ASSERT_EQUAL_INT(1, gnrc_tcp_send(from, &byte, sizeof(byte), TIMEOUT));
+    TEST_ASSERT_EQUAL_INT(1, gnrc_tcp_recv(to, &rcvd, sizeof(rcvd), TIMEOUT));
+    TEST_ASSERT_EQUAL_INT(byte, rcvd);
+}
+
+static void tear_down(void)
+{
+    for (unsigned i = 0; i < CONNS; i++) {
+        gnrc_tcp_abort(&_cli[i]);
+        gnrc_tcp_abort(&_srv[i]);
+    }
+}
+
+static void test_tcp_demux__handshake(void)
+{
+    _connect();
+    /* all connections are established at the same time now, every byte must
+     * arrive at the peer of its sender only */
+    for (unsigned i = 0; i < CONNS; i++) {
+        _exchange(&_cli[i], &_srv[i], (uint8_t)i);
+        _exchange(&_srv[i], &_cli[i], (uint8_t)(0x80 | i));
+    }
+    for (unsigned i = 0; i < CONNS; i++) {
+        uint8_t byte;
+
+        TEST_ASSERT_EQUAL_INT(-EAGAIN, gnrc_tcp_recv(&_cli[i], &byte, 1, 0));
+        TEST_ASSERT_EQUAL_INT(-EAGAIN, gnrc_tcp_recv(&_srv[i], &byte, 1, 0));
+    }
+}
+
+static void _recv_all(gnrc_tcp_tcb_t *tcb, uint8_t offset)
+{
+    uint8_t buf[DATA_SIZE];
+    size_t rcvd = 0;
+
+    while (rcvd < sizeof(buf)) {
+        ssize_t res = gnrc_tcp_recv(tcb, buf + rcvd, sizeof(buf) - rcvd, TIMEOUT);
+
+        TEST_ASSERT(res > 0);
+        rcvd += res;
+    }
+    for (unsigned i = 0; i < sizeof(buf); i++) {
+        TEST_ASSERT_EQUAL_INT((uint8_t)(_data[i] + offset), buf[i]);
+    }
+}
+
+static void test_tcp_demux__rcv_buffers(void)
+{
+    /* twice as many TCBs as GNRC_TCP_RCV_BUFFERS are open ... */
+    _connect();
+    /* ... and all of them hold received data at the same time */
+    for (unsigned i = 0; i < CONNS; i++) {
+        uint8_t data[DATA_SIZE];
+
+        for (unsigned j = 0; j < sizeof(data); j++) {
+            data[j] = _data[j] + i;
+        }
+        TEST_ASSERT_EQUAL_INT(DATA_SIZE, gnrc_tcp_send(&_cli[i], data, sizeof(data),
+                                                       TIMEOUT));
+        for (unsigned j = 0; j < sizeof(data); j++) {
+            data[j] = _data[j] + CONNS + i;
+        }
+        TEST_ASSERT_EQUAL_INT(DATA_SIZE, gnrc_tcp_send(&_srv[i], data, sizeof(data),
+                                                       TIMEOUT));
+    }
+    for (unsigned i = 0; i < CONNS; i++) {
+        _recv_all(&_srv[i], i);
+        _recv_all(&_cli[i], CONNS + i);
+    }
+}
+
+static Test *tests_gnrc_tcp_demux(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_tcp_demux__handshake),
+        new_TestFixture(test_tcp_demux__rcv_buffers),
+    };
+
+    EMB_UNIT_TESTCALLER(gnrc_tcp_demux_tests, NULL, tear_down, fixtures);
+
+    return (Test *)&gnrc_tcp_demux_tests;
+}
+
+int main(void)
+{
+    msg_init_queue(_main_msg_queue, MAIN_QUEUE_SIZE);
+    _main_pid = thread_getpid();
+    for (unsigned i = 0; i < DATA_SIZE; i++) {
+        _data[i] = (uint8_t)(i * 7);
+    }
+
+    TESTS_START();
+    TESTS_RUN(tests_gnrc_tcp_demux());
+    TESTS_END();
+
+    return 0;
+}
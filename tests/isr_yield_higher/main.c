@@ -57,7 +57,7 @@ int main(void)
 
     puts("first thread started");
 
-    xtimer_t timer;
+    xtimer_t timer = { 0 };
     timer.callback = _cb;
     xtimer_set(&timer, TEST_TIME/2);
 
@@ -0,0 +1,211 @@
+/*
+ * Copyright (C) 2018 OverDriveGain
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests the receive path of netdev_tap
+ *
+ * The driver reads from a datagram socket pair instead of a TAP, which
+ * likewise returns one frame per read().
+ *
+ * @author      OverDriveGain
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdbool.h>
+#include <string.h>
+#include <sys/socket.h>
+
+/* needs to be included before native's declarations of ntohl etc. */
+#include "byteorder.h"
+
+#include "native_internal.h"
+
+#include "async_read.h"
+#include "embUnit.h"
+#include "netdev_tap.h"
+
+#define FRAME_MIN_LEN   (60U)
+
+static const uint8_t _addr[] = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x01 };
+static const uint8_t _other[] = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x02 };
+static const uint8_t _bcast[] = { 0xff, 0xff, 0xff, 0xff, 0xff, 0xff };
+
+static char *_tap_name = "test";
+static const netdev_tap_params_t _params = { .tap_name = &_tap_name };
+static netdev_tap_t _dev;
+static int _peer;
+static uint8_t _frame[ETHERNET_FRAME_LEN];
+static uint8_t _buf[ETHERNET_FRAME_LEN];
+/* receive the frames right in the event callback */
+static bool _consume;
+static unsigned _rx_events;
+static int _rx_len[NETDEV_TAP_RX_FRAMES + 1];
+static unsigned _rx_numof;
+
+static int _recv(void *buf, size_t len)
+{
+    netdev_t *netdev = (netdev_t *)&_dev;
+
+    return netdev->driver->recv(netdev, buf, len, NULL);
+}
+
+static void _isr(void)
+{
+    netdev_t *netdev = (netdev_t *)&_dev;
+
+    netdev->driver->isr(netdev);
+}
+
+static void _event_cb(netdev_t *dev, netdev_event_t event)
+{
+    (void)dev;
+    if (event != NETDEV_EVENT_RX_COMPLETE) {
+        return;
+    }
+    _rx_events++;
+    if (_consume) {
+        int len = _recv(NULL, 0);
+
+        TEST_ASSERT(len > 0);
+        TEST_ASSERT(_rx_numof < (sizeof(_rx_len) / sizeof(_rx_len[0])));
+        _rx_len[_rx_numof++] = _recv(_buf, sizeof(_buf));
+        TEST_ASSERT_EQUAL_INT(len, _rx_len[_rx_numof - 1]);
+    }
+}
+
+static void _send_frame(const uint8_t *dst, size_t len)
+{
+    ssize_t res;
+
+    memset(_frame, (uint8_t)len, len);
+    if (len >= ETHERNET_ADDR_LEN) {
+        memcpy(_frame, dst, ETHERNET_ADDR_LEN);
+    }
+    _native_in_syscall++;
+    res = real_write(_peer, _frame, len);
+    _native_in_syscall--;
+    TEST_ASSERT_EQUAL_INT(len, res);
+}
+
+static void set_up(void)
+{
+    /* discard what a failed test left */
+    while (_recv(NULL, 0) > 0) {
+        _recv(NULL, 1);
+    }
+    _consume = false;
+    _rx_events = 0;
+    _rx_numof = 0;
+}
+
+static void test_recv__filter_exact_size(void)
+{
+    _consume = true;
+    _send_frame(_other, 100);
+    _send_frame(_addr, sizeof(ethernet_hdr_t) - 1);
+    _send_frame(_addr, 64);
+    _send_frame(_bcast, ETHERNET_FRAME_LEN);
+    _isr();
+    TEST_ASSERT_EQUAL_INT(2, _rx_events);
+    TEST_ASSERT_EQUAL_INT(2, _rx_numof);
+    TEST_ASSERT_EQUAL_INT(64, _rx_len[0]);
+    TEST_ASSERT_EQUAL_INT(ETHERNET_FRAME_LEN, _rx_len[1]);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_buf, _frame, ETHERNET_FRAME_LEN));
+    /* nothing left */
+    TEST_ASSERT_EQUAL_INT(0, _recv(NULL, 0));
+    TEST_ASSERT_EQUAL_INT(-1, _recv(_buf, sizeof(_buf)));
+}
+
+static void test_recv__ring_full(void)
+{
+    for (unsigned i = 0; i <= NETDEV_TAP_RX_FRAMES; i++) {
+        _send_frame(_addr, FRAME_MIN_LEN + i);
+    }
+    _isr();
+    /* one event per staged frame, the last frame is still in the socket */
+    TEST_ASSERT_EQUAL_INT(NETDEV_TAP_RX_FRAMES, _rx_events);
+    for (unsigned i = 0; i <= NETDEV_TAP_RX_FRAMES; i++) {
+        TEST_ASSERT_EQUAL_INT(FRAME_MIN_LEN + i, _recv(NULL, 0));
+        TEST_ASSERT_EQUAL_INT(FRAME_MIN_LEN + i, _recv(_buf, sizeof(_buf)));
+        TEST_ASSERT_EQUAL_INT(FRAME_MIN_LEN + i, _buf[ETHERNET_ADDR_LEN]);
+    }
+    TEST_ASSERT_EQUAL_INT(0, _recv(NULL, 0));
+}
+
+static void test_recv__drop(void)
+{
+    _send_frame(_addr, FRAME_MIN_LEN);
+    _send_frame(_addr, FRAME_MIN_LEN + 1);
+    _isr();
+    TEST_ASSERT_EQUAL_INT(2, _rx_events);
+    /* no buffer but a length drops the frame */
+    TEST_ASSERT_EQUAL_INT(FRAME_MIN_LEN, _recv(NULL, FRAME_MIN_LEN));
+    TEST_ASSERT_EQUAL_INT(FRAME_MIN_LEN + 1, _recv(NULL, 0));
+    TEST_ASSERT_EQUAL_INT(FRAME_MIN_LEN + 1, _recv(_buf, sizeof(_buf)));
+}
+
+static void test_recv__buffer_too_small(void)
+{
+    _send_frame(_addr, FRAME_MIN_LEN + 1);
+    _send_frame(_addr, FRAME_MIN_LEN);
+    _isr();
+    TEST_ASSERT_EQUAL_INT(-ENOBUFS, _recv(_buf, FRAME_MIN_LEN));
+    /* the frame was dropped */
+    TEST_ASSERT_EQUAL_INT(FRAME_MIN_LEN, _recv(NULL, 0));
+    TEST_ASSERT_EQUAL_INT(FRAME_MIN_LEN, _recv(_buf, FRAME_MIN_LEN));
+}
+
+static Test *tests_netdev_tap(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_recv__filter_exact_size),
+        new_TestFixture(test_recv__ring_full),
+        new_TestFixture(test_recv__drop),
+        new_TestFixture(test_recv__buffer_too_small),
+    };
+
+    EMB_UNIT_TESTCALLER(netdev_tap_tests, set_up, NULL, fixtures);
+
+    return (Test *)&netdev_tap_tests;
+}
+
+int main(void)
+{
+    int fds[2];
+    int res;
+
+    _native_in_syscall++;
+    res = socketpair(AF_UNIX, SOCK_DGRAM, 0, fds);
+    _native_in_syscall--;
+    if (res < 0) {
+        puts("unable to create socket pair");
+        return 1;
+    }
+    real_fcntl(fds[0], F_SETFL, O_NONBLOCK);
+    _peer = fds[1];
+
+    netdev_tap_setup(&_dev, &_params);
+    _dev.tap_fd = fds[0];
+    memcpy(_dev.addr, _addr, sizeof(_addr));
+    _dev.netdev.event_callback = _event_cb;
+    /* the driver re-arms the asynchronous read of the descriptor */
+    native_async_read_setup();
+
+    TESTS_START();
+    TESTS_RUN(tests_netdev_tap());
+    TESTS_END();
+
+    return 0;
+}
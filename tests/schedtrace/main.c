@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2018 OverDriveGain
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for the scheduler trace
+ *
+ * @author      OverDriveGain
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "msg.h"
+#include "mutex.h"
+#include "thread.h"
+#include "thread_flags.h"
+#include "schedtrace.h"
+
+#define MSG_TYPE_MUTEX      (1U)
+#define MSG_TYPE_FLAGS      (2U)
+
+static char _stack[THREAD_STACKSIZE_MAIN];
+static char _yield_stack[THREAD_STACKSIZE_MAIN];
+static mutex_t _mutex = MUTEX_INIT;
+static kernel_pid_t _main_pid, _second_pid;
+static uint32_t _pos;
+static unsigned _failed;
+
+static void *_second_thread(void *arg)
+{
+    (void)arg;
+    while (1) {
+        msg_t msg;
+
+        msg_receive(&msg);
+        if (msg.type == MSG_TYPE_MUTEX) {
+            mutex_lock(&_mutex);
+            mutex_unlock(&_mutex);
+        }
+        else if (msg.type == MSG_TYPE_FLAGS) {
+            thread_flags_wait_any(0x1);
+        }
+    }
+    return NULL;
+}
+
+static void *_yield_thread(void *arg)
+{
+    (void)arg;
+    return NULL;
+}
+
+static void _expect(kernel_pid_t from, kernel_pid_t to, schedtrace_reason_t reason)
+{
+    schedtrace_event_t event;
+
+    if (schedtrace_read(&_pos, &event, 1) != 1) {
+        printf("expected %d -> %d (%s), got nothing\n", (int)from, (int)to,
+               schedtrace_reason_str(reason));
+        _failed++;
+        return;
+    }
+    if ((event.from != from) || (event.to != to) || (event.reason != reason)) {
+        printf("expected %d -> %d (%s), got %d -> %d (%s)\n", (int)from, (int)to,
+               schedtrace_reason_str(reason), (int)event.from, (int)event.to,
+               schedtrace_reason_str(event.reason));
+        _failed++;
+    }
+}
+
+int main(void)
+{
+    msg_t msg;
+    kernel_pid_t yield_pid;
+
+    puts("schedtrace test");
+    _main_pid = thread_getpid();
+    _pos = schedtrace_count();
+
+    /* the new thread preempts main and blocks on msg_receive() */
+    _second_pid = thread_create(_stack, sizeof(_stack), THREAD_PRIORITY_MAIN - 1,
+                                THREAD_CREATE_STACKTEST, _second_thread, NULL, "second");
+    msg.type = 0;
+    msg_send(&msg, _second_pid);
+    msg.type = MSG_TYPE_MUTEX;
+    mutex_lock(&_mutex);
+    msg_send(&msg, _second_pid);
+    mutex_unlock(&_mutex);
+    msg.type = MSG_TYPE_FLAGS;
+    msg_send(&msg, _second_pid);
+    thread_flags_set((thread_t *)thread_get(_second_pid), 0x1);
+
+    /* a thread of the same priority runs only if main yields */
+    yield_pid = thread_create(_yield_stack, sizeof(_yield_stack), THREAD_PRIORITY_MAIN,
+                              THREAD_CREATE_STACKTEST, _yield_thread, NULL, "yield");
+    thread_yield();
+
+    _expect(_main_pid, _second_pid, SCHEDTRACE_PREEMPT);
+    _expect(_second_pid, _main_pid, SCHEDTRACE_MSG);
+    /* msg */
+    _expect(_main_pid, _second_pid, SCHEDTRACE_PREEMPT);
+    _expect(_second_pid, _main_pid, SCHEDTRACE_MSG);
+    /* mutex */
+    _expect(_main_pid, _second_pid, SCHEDTRACE_PREEMPT);
+    _expect(_second_pid, _main_pid, SCHEDTRACE_MUTEX);
+    _expect(_main_pid, _second_pid, SCHEDTRACE_PREEMPT);
+    _expect(_second_pid, _main_pid, SCHEDTRACE_MSG);
+    /* thread flags */
+    _expect(_main_pid, _second_pid, SCHEDTRACE_PREEMPT);
+    _expect(_second_pid, _main_pid, SCHEDTRACE_FLAGS);
+    _expect(_main_pid, _second_pid, SCHEDTRACE_PREEMPT);
+    _expect(_second_pid, _main_pid, SCHEDTRACE_MSG);
+    /* yield and exit */
+    _expect(_main_pid, yield_pid, SCHEDTRACE_YIELD);
+    _expect(KERNEL_PID_UNDEF, _main_pid, SCHEDTRACE_EXIT);
+
+    schedtrace_print();
+    puts(_failed ? "FAILURE" : "SUCCESS");
+    return 0;
+}
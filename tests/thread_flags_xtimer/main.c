@@ -35,7 +35,7 @@ static void time_evt(void *arg)
 int main(void)
 {
     puts("START");
-    xtimer_t timer;
+    xtimer_t timer = { 0 };
     timer.callback = time_evt;
     timer.arg = (void *)sched_active_thread;
     uint32_t last = xtimer_now_usec();
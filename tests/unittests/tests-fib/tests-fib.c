@@ -21,11 +21,19 @@
 
 #define TEST_FIB_TABLE_SIZE (20)
 static fib_entry_t _entries[TEST_FIB_TABLE_SIZE];
+#ifdef MODULE_FIB_LPM
+static fib_lpm_node_t _lpm_nodes[FIB_LPM_NODES_NUMOF(TEST_FIB_TABLE_SIZE)];
+#endif
 static fib_table_t test_fib_table = { .data.entries = _entries,
                                       .table_type = FIB_TABLE_TYPE_SH,
                                       .size = TEST_FIB_TABLE_SIZE,
                                       .mtx_access = MUTEX_INIT,
-                                      .notify_rp_pos = 0 };
+                                      .notify_rp_pos = 0,
+#ifdef MODULE_FIB_LPM
+                                      .lpm_nodes = _lpm_nodes,
+                                      .lpm_nodes_numof = FIB_LPM_NODES_NUMOF(TEST_FIB_TABLE_SIZE),
+#endif
+                                    };
 
 /*
 * @brief helper to fill FIB with unique entries
@@ -976,6 +984,124 @@ static void test_fib_20_replace_prefix(void)
     fib_deinit(&test_fib_table);
 }
 
+/*
+* @brief testing that the longest matching prefix wins over shorter ones
+* and the default gateway, regardless of the order of insertion
+*/
+static void test_fib_21_longest_prefix_match(void)
+{
+    size_t add_buf_size = 16;
+    char addr_dst[add_buf_size];
+    char addr_nxt_hop[add_buf_size];
+    char addr_nxt[add_buf_size];
+    char addr_lookup[add_buf_size];
+    kernel_pid_t iface_id = KERNEL_PID_UNDEF;
+    uint32_t next_hop_flags = 0;
+
+    memset(addr_dst, 0, add_buf_size);
+    memset(addr_nxt, 0, add_buf_size);
+    memset(addr_lookup, 0, add_buf_size);
+
+    /* set the bytes to 0x01..0x0e of the lookup address */
+    for(size_t i = 0; i < 14; i++) {
+        addr_lookup[i] = i+1;
+    }
+
+    /* add a default gateway entry with next-hop 0x01.. */
+    addr_nxt[0] = 0x01;
+    fib_add_entry(&test_fib_table, 42, (uint8_t *)addr_dst,
+                  add_buf_size, 0x123,
+                  (uint8_t *)addr_nxt, add_buf_size, 0x23,
+                  100000);
+
+    /* add a /96 prefix entry with next-hop 0x03.. */
+    memcpy(addr_dst, addr_lookup, 12);
+    addr_nxt[0] = 0x03;
+    fib_add_entry(&test_fib_table, 42, (uint8_t *)addr_dst,
+                  add_buf_size, ((96UL << FIB_FLAG_NET_PREFIX_SHIFT) | 0x123),
+                  (uint8_t *)addr_nxt, add_buf_size, 0x23,
+                  100000);
+
+    /* add a /64 prefix entry with next-hop 0x02.. */
+    memset(addr_dst, 0, add_buf_size);
+    memcpy(addr_dst, addr_lookup, 8);
+    addr_nxt[0] = 0x02;
+    fib_add_entry(&test_fib_table, 42, (uint8_t *)addr_dst,
+                  add_buf_size, ((64UL << FIB_FLAG_NET_PREFIX_SHIFT) | 0x123),
+                  (uint8_t *)addr_nxt, add_buf_size, 0x23,
+                  100000);
+
+    /* the /96 prefix must win */
+    memset(addr_nxt_hop, 0, add_buf_size);
+    int ret = fib_get_next_hop(&test_fib_table, &iface_id,
+                               (uint8_t *)addr_nxt_hop, &add_buf_size,
+                               &next_hop_flags, (uint8_t *)addr_lookup,
+                               add_buf_size, 0x123);
+
+    TEST_ASSERT_EQUAL_INT(0, ret);
+    TEST_ASSERT_EQUAL_INT(0x03, addr_nxt_hop[0]);
+
+    /* a lookup outside of the /96 prefix must match the /64 prefix */
+    addr_lookup[10] += 1;
+    memset(addr_nxt_hop, 0, add_buf_size);
+    ret = fib_get_next_hop(&test_fib_table, &iface_id,
+                           (uint8_t *)addr_nxt_hop, &add_buf_size,
+                           &next_hop_flags, (uint8_t *)addr_lookup,
+                           add_buf_size, 0x123);
+
+    TEST_ASSERT_EQUAL_INT(0, ret);
+    TEST_ASSERT_EQUAL_INT(0x02, addr_nxt_hop[0]);
+
+    /* without the /64 prefix only the default gateway is left */
+    fib_remove_entry(&test_fib_table, (uint8_t *)addr_dst, add_buf_size);
+    memset(addr_nxt_hop, 0, add_buf_size);
+    ret = fib_get_next_hop(&test_fib_table, &iface_id,
+                           (uint8_t *)addr_nxt_hop, &add_buf_size,
+                           &next_hop_flags, (uint8_t *)addr_lookup,
+                           add_buf_size, 0x123);
+
+    TEST_ASSERT_EQUAL_INT(0, ret);
+    TEST_ASSERT_EQUAL_INT(0x01, addr_nxt_hop[0]);
+
+#if (TEST_FIB_SHOW_OUTPUT == 1)
+    fib_print_fib_table(&test_fib_table);
+    puts("");
+    universal_address_print_table();
+    puts("");
+#endif
+    fib_deinit(&test_fib_table);
+}
+
+/*
+* @brief testing that entries are gone once their lifetime expired
+*/
+static void test_fib_22_lifetime_expired(void)
+{
+    size_t add_buf_size = 16;
+    char addr_dst[] = "Test address221";
+    char addr_nxt[] = "Test address222";
+    char addr_nxt_hop[add_buf_size];
+    kernel_pid_t iface_id = KERNEL_PID_UNDEF;
+    uint32_t next_hop_flags = 0;
+
+    TEST_ASSERT_EQUAL_INT(0, fib_add_entry(&test_fib_table, 42,
+                          (uint8_t *)addr_dst, add_buf_size - 1, 0x0,
+                          (uint8_t *)addr_nxt, add_buf_size - 1, 0x0, 1));
+    TEST_ASSERT_EQUAL_INT(1, fib_get_num_used_entries(&test_fib_table));
+
+    xtimer_usleep(2 * US_PER_MS);
+
+    int ret = fib_get_next_hop(&test_fib_table, &iface_id,
+                               (uint8_t *)addr_nxt_hop, &add_buf_size,
+                               &next_hop_flags, (uint8_t *)addr_dst,
+                               add_buf_size - 1, 0x0);
+
+    TEST_ASSERT_EQUAL_INT(-EHOSTUNREACH, ret);
+    TEST_ASSERT_EQUAL_INT(0, fib_get_num_used_entries(&test_fib_table));
+
+    fib_deinit(&test_fib_table);
+}
+
 Test *tests_fib_tests(void)
 {
     fib_init(&test_fib_table);
@@ -1000,6 +1126,8 @@ Test *tests_fib_tests(void)
                         new_TestFixture(test_fib_18_get_next_hop_invalid_parameters),
                         new_TestFixture(test_fib_19_default_gateway),
                         new_TestFixture(test_fib_20_replace_prefix),
+                        new_TestFixture(test_fib_21_longest_prefix_match),
+                        new_TestFixture(test_fib_22_lifetime_expired),
     };
 
     EMB_UNIT_TESTCALLER(fib_tests, NULL, NULL, fixtures);
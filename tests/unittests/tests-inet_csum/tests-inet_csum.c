@@ -13,6 +13,7 @@
  */
 #include <errno.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "embUnit.h"
 
@@ -21,6 +22,41 @@
 #include "unittests-constants.h"
 #include "tests-inet_csum.h"
 
+/* byte-wise reference implementation the optimized one is compared to */
+static uint16_t _ref_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len,
+                                size_t accum_len)
+{
+    uint32_t csum = sum;
+
+    if (len == 0) {
+        return csum;
+    }
+    if (accum_len & 1) {
+        csum += *buf;
+        buf++;
+        len--;
+        accum_len++;
+    }
+    for (unsigned i = 0; i < (len >> 1); buf += 2, i++) {
+        csum += (uint16_t)(*buf << 8) + *(buf + 1);
+    }
+    if ((accum_len + len) & 1) {
+        csum += (uint16_t)(*buf << 8);
+    }
+    while (csum >> 16) {
+        csum = (csum & 0xffff) + (csum >> 16);
+    }
+    return csum;
+}
+
+static void _fill_pattern(uint8_t *buf, size_t len, uint32_t seed)
+{
+    for (size_t i = 0; i < len; i++) {
+        seed = seed * 1103515245 + 12345;
+        buf[i] = seed >> 16;
+    }
+}
+
 static void test_inet_csum__rfc_example(void)
 {
     /* source: https://tools.ietf.org/html/rfc1071#section-3 */
@@ -165,6 +201,92 @@ static void test_inet_csum__empty_app_buffer(void)
     TEST_ASSERT_EQUAL_INT(hdr_expected, pyld_sum);
 }
 
+static void test_inet_csum__reference(void)
+{
+    static uint8_t data[260 + 8];
+    const uint16_t sums[] = { 0x0000, 0xffff, 0x1234 };
+
+    _fill_pattern(data, sizeof(data), 0x2a);
+    /* all alignments, lengths covering every tail of the word-wise loops,
+     * both parities of the accumulated length */
+    for (unsigned off = 0; off < 8; off++) {
+        for (uint16_t len = 0; len <= 260; len++) {
+            for (size_t accum_len = 0; accum_len < 2; accum_len++) {
+                for (unsigned i = 0; i < sizeof(sums) / sizeof(sums[0]); i++) {
+                    TEST_ASSERT_EQUAL_INT(
+                        _ref_csum_slice(sums[i], data + off, len, accum_len),
+                        inet_csum_slice(sums[i], data + off, len, accum_len));
+                }
+            }
+        }
+    }
+}
+
+static void test_inet_csum__reference_all_ones(void)
+{
+    /* maximizes the carries of every partial sum */
+    static uint8_t data[1500];
+
+    memset(data, 0xff, sizeof(data));
+    for (uint16_t len = sizeof(data) - 33; len <= sizeof(data); len++) {
+        TEST_ASSERT_EQUAL_INT(_ref_csum_slice(0xffff, data, len, 0),
+                              inet_csum_slice(0xffff, data, len, 0));
+        TEST_ASSERT_EQUAL_INT(_ref_csum_slice(0xffff, data + 1, len - 1, 1),
+                              inet_csum_slice(0xffff, data + 1, len - 1, 1));
+    }
+}
+
+static void test_inet_csum__reference_slices(void)
+{
+    static uint8_t data[200];
+    uint16_t expected;
+
+    _fill_pattern(data, sizeof(data), 0x1b);
+    expected = _ref_csum_slice(0, data, sizeof(data), 0);
+    /* splitting the domain at any point yields the same checksum */
+    for (uint16_t split = 0; split <= sizeof(data); split++) {
+        uint16_t sum = inet_csum_slice(0, data, split, 0);
+
+        sum = inet_csum_slice(sum, data + split, sizeof(data) - split, split);
+        TEST_ASSERT_EQUAL_INT(expected, sum);
+    }
+}
+
+static void test_inet_csum__update(void)
+{
+    /* source: https://tools.ietf.org/html/rfc1624#section-4 */
+    TEST_ASSERT_EQUAL_INT(0x0000, inet_csum_update(0xdd2f, 0x5555, 0x3285));
+
+    uint8_t data[] = {
+        0x45, 0x00, 0x00, 0x73, 0x00, 0x00, 0x40, 0x00,
+        0x40, 0x11, 0x00, 0x00, 0xc0, 0xa8, 0x00, 0x01,
+        0xc0, 0xa8, 0x00, 0xc7,
+    };
+    uint16_t csum = ~inet_csum(0, data, sizeof(data));
+
+    /* decrement the TTL as a router would */
+    csum = inet_csum_update(csum, 0x4011, 0x3f11);
+    data[8] = 0x3f;
+    TEST_ASSERT_EQUAL_INT((uint16_t)~inet_csum(0, data, sizeof(data)), csum);
+}
+
+static void test_inet_csum__update_slice(void)
+{
+    static uint8_t data[64];
+    const uint8_t addr[] = {
+        0xfe, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x5a, 0x6d, 0x8f, 0xff, 0xfe, 0x56, 0x30, 0x09,
+    };
+
+    _fill_pattern(data, sizeof(data), 0x3c);
+    uint16_t csum = ~inet_csum(0, data, sizeof(data));
+
+    /* replace an address in the middle of the domain */
+    csum = inet_csum_update_slice(csum, data + 16, addr, sizeof(addr));
+    memcpy(data + 16, addr, sizeof(addr));
+    TEST_ASSERT_EQUAL_INT((uint16_t)~inet_csum(0, data, sizeof(data)), csum);
+}
+
 Test *tests_inet_csum_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -176,6 +298,11 @@ Test *tests_inet_csum_tests(void)
         new_TestFixture(test_inet_csum__odd_len),
         new_TestFixture(test_inet_csum__two_app_snips),
         new_TestFixture(test_inet_csum__empty_app_buffer),
+        new_TestFixture(test_inet_csum__reference),
+        new_TestFixture(test_inet_csum__reference_all_ones),
+        new_TestFixture(test_inet_csum__reference_slices),
+        new_TestFixture(test_inet_csum__update),
+        new_TestFixture(test_inet_csum__update_slice),
     };
 
     EMB_UNIT_TESTCALLER(inet_csum_tests, NULL, NULL, fixtures);
@@ -26,6 +26,11 @@
 
 #define _BUF_SIZE (128U)
 
+/* options not defined in net/coap.h */
+#define _OPT_ETAG   (4)
+#define _OPT_SIZE1  (60)
+#define _OPT_EXP    (2048)
+
 /*
  * Validates encoded message ID byte order and put/get URI option.
  */
@@ -358,6 +363,179 @@ static void test_nanocoap__server_reply_simple_con(void)
     TEST_ASSERT_EQUAL_INT(COAP_TYPE_ACK, coap_get_type(&pkt));
 }
 
+/*
+ * Resources for the resource index tests, ordered by path.
+ */
+static const coap_resource_t _resources[] = {
+    { "/", COAP_GET | COAP_MATCH_SUBTREE, NULL, NULL },
+    { "/a", COAP_GET, NULL, NULL },
+    { "/a/b", COAP_GET | COAP_MATCH_SUBTREE, NULL, NULL },
+    { "/a/b", COAP_POST, NULL, NULL },
+    { "/a/bc", COAP_PUT, NULL, NULL },
+    { "/fw", COAP_POST | COAP_MATCH_SUBTREE, NULL, NULL },
+};
+
+static const struct {
+    const char *path;
+    unsigned method_flag;
+    int res;
+    int resource;
+} _lookups[] = {
+    { "/a", COAP_GET, 0, 1 },
+    { "/a", COAP_POST, -ENOTSUP, -1 },
+    { "/a/b", COAP_GET, 0, 2 },
+    { "/a/b", COAP_POST, 0, 3 },
+    { "/a/b/c/d", COAP_GET, 0, 2 },
+    { "/a/bc", COAP_PUT, 0, 4 },
+    { "/a/bcd", COAP_GET, 0, 0 },
+    { "/fw/1/data", COAP_POST, 0, 5 },
+    { "/fwx", COAP_POST, -ENOTSUP, -1 },
+    { "/", COAP_GET, 0, 0 },
+};
+
+/*
+ * Looks up exact and subtree paths in a resource index and checks the linear
+ * search with coap_match_path() gives the same resource.
+ */
+static void test_nanocoap__resource_index(void)
+{
+    coap_resource_index_entry_t entries[16];
+    coap_resource_index_t index;
+    const coap_resource_t *resource;
+
+    coap_resource_index_init(&index, entries, 16);
+    for (unsigned i = 0; i < (sizeof(_resources) / sizeof(_resources[0])); i++) {
+        TEST_ASSERT_EQUAL_INT(0, coap_resource_index_add(&index, &_resources[i]));
+    }
+
+    for (unsigned i = 0; i < (sizeof(_lookups) / sizeof(_lookups[0])); i++) {
+        int best = -1;
+        const coap_resource_t *linear = NULL;
+
+        resource = NULL;
+        TEST_ASSERT_EQUAL_INT(_lookups[i].res,
+                              coap_resource_index_find(&index, _lookups[i].path,
+                                                       _lookups[i].method_flag,
+                                                       &resource));
+        if (_lookups[i].resource >= 0) {
+            TEST_ASSERT(&_resources[_lookups[i].resource] == resource);
+        }
+
+        for (unsigned j = 0; j < (sizeof(_resources) / sizeof(_resources[0])); j++) {
+            int res = coap_match_path(&_resources[j], _lookups[i].path);
+            if ((_resources[j].methods & _lookups[i].method_flag) && (res > best)) {
+                best = res;
+                linear = &_resources[j];
+            }
+        }
+        TEST_ASSERT(linear == ((_lookups[i].res == 0) ? resource : NULL));
+    }
+}
+
+/*
+ * Without a subtree resource at the root, unknown paths are not found.
+ */
+static void test_nanocoap__resource_index_no_path(void)
+{
+    coap_resource_index_entry_t entries[8];
+    coap_resource_index_t index;
+    const coap_resource_t *resource = NULL;
+
+    coap_resource_index_init(&index, entries, 8);
+    for (unsigned i = 1; i < (sizeof(_resources) / sizeof(_resources[0])); i++) {
+        TEST_ASSERT_EQUAL_INT(0, coap_resource_index_add(&index, &_resources[i]));
+    }
+    TEST_ASSERT_EQUAL_INT(-ENOENT,
+                          coap_resource_index_find(&index, "/x", COAP_GET, &resource));
+    TEST_ASSERT_EQUAL_INT(-ENOENT,
+                          coap_resource_index_find(&index, "/a/bc/d", COAP_PUT, &resource));
+    TEST_ASSERT_NULL(resource);
+}
+
+/*
+ * An index keeps one entry free and flags the resources that did not fit.
+ */
+static void test_nanocoap__resource_index_overflow(void)
+{
+    coap_resource_index_entry_t entries[4];
+    coap_resource_index_t index;
+
+    coap_resource_index_init(&index, entries, 4);
+    for (unsigned i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL_INT(0, coap_resource_index_add(&index, &_resources[i]));
+    }
+    TEST_ASSERT(!index.overflow);
+    TEST_ASSERT_EQUAL_INT(-ENOMEM, coap_resource_index_add(&index, &_resources[3]));
+    TEST_ASSERT(index.overflow);
+}
+
+/*
+ * Reads options by number from a parsed and from a built packet, including
+ * repeated options, an option missing in between and options above 64.
+ */
+static void _check_options(coap_pkt_t *pkt)
+{
+    uint8_t *value;
+    uint32_t num;
+    unsigned szx;
+    char str[NANOCOAP_URI_MAX];
+
+    TEST_ASSERT_EQUAL_INT(0, coap_opt_get_uint(pkt, COAP_OPT_OBSERVE, &num));
+    TEST_ASSERT_EQUAL_INT(0x1234, num);
+    TEST_ASSERT_EQUAL_INT(COAP_FORMAT_JSON, coap_get_content_type(pkt));
+    TEST_ASSERT_EQUAL_INT(-ENOENT, coap_opt_get_uint(pkt, _OPT_ETAG, &num));
+
+    coap_get_uri_path(pkt, (uint8_t *)str);
+    TEST_ASSERT_EQUAL_STRING("/a/bc/def", (char *)str);
+    coap_get_uri_query(pkt, (uint8_t *)str);
+    TEST_ASSERT_EQUAL_STRING("&x=1&y=2", (char *)str);
+
+    TEST_ASSERT_EQUAL_INT(1, coap_get_blockopt(pkt, COAP_OPT_BLOCK2, &num, &szx));
+    TEST_ASSERT_EQUAL_INT(3, num);
+    TEST_ASSERT_EQUAL_INT(2, szx);
+
+    TEST_ASSERT_EQUAL_INT(0, coap_opt_get_uint(pkt, _OPT_SIZE1, &num));
+    TEST_ASSERT_EQUAL_INT(300, num);
+    TEST_ASSERT_EQUAL_INT(3, coap_opt_get_opaque(pkt, _OPT_EXP, &value));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(value, "xyz", 3));
+    TEST_ASSERT_EQUAL_INT(-ENOENT, coap_opt_get_opaque(pkt, _OPT_EXP + 1, &value));
+}
+
+static void test_nanocoap__options(void)
+{
+    uint8_t buf[_BUF_SIZE];
+    coap_pkt_t pkt;
+    uint8_t *pktpos = &buf[0];
+    coap_block_slicer_t slicer = { .start = 3 * 64, .end = 4 * 64 };
+
+    pktpos += coap_build_hdr((coap_hdr_t *)pktpos, COAP_TYPE_CON, NULL, 0,
+                             COAP_METHOD_GET, 1);
+    pktpos += coap_put_option(pktpos, 0, COAP_OPT_OBSERVE,
+                              (uint8_t *)"\x12\x34", 2);
+    pktpos += coap_opt_put_uri_path(pktpos, COAP_OPT_OBSERVE, "/a/bc/def");
+    pktpos += coap_put_option_ct(pktpos, COAP_OPT_URI_PATH, COAP_FORMAT_JSON);
+    pktpos += coap_opt_put_uri_query(pktpos, COAP_OPT_CONTENT_FORMAT, "&x=1&y=2");
+    pktpos += coap_opt_put_block2(pktpos, COAP_OPT_URI_QUERY, &slicer, true);
+    pktpos += coap_put_option(pktpos, COAP_OPT_BLOCK2, _OPT_SIZE1,
+                              (uint8_t *)"\x01\x2c", 2);
+    pktpos += coap_put_option(pktpos, _OPT_SIZE1, _OPT_EXP, (uint8_t *)"xyz", 3);
+
+    TEST_ASSERT_EQUAL_INT(0, coap_parse(&pkt, &buf[0], pktpos - &buf[0]));
+    _check_options(&pkt);
+
+    coap_pkt_init(&pkt, &buf[0], sizeof(buf),
+                  coap_build_hdr((coap_hdr_t *)&buf[0], COAP_TYPE_CON, NULL, 0,
+                                 COAP_METHOD_GET, 1));
+    coap_opt_add_uint(&pkt, COAP_OPT_OBSERVE, 0x1234);
+    coap_opt_add_string(&pkt, COAP_OPT_URI_PATH, "/a/bc/def", '/');
+    coap_opt_add_uint(&pkt, COAP_OPT_CONTENT_FORMAT, COAP_FORMAT_JSON);
+    coap_opt_add_string(&pkt, COAP_OPT_URI_QUERY, "&x=1&y=2", '&');
+    coap_opt_add_uint(&pkt, COAP_OPT_BLOCK2, (3 << 4) | 0x8 | 2);
+    coap_opt_add_uint(&pkt, _OPT_SIZE1, 300);
+    coap_opt_add_string(&pkt, _OPT_EXP, "/xyz", '/');
+    _check_options(&pkt);
+}
+
 Test *tests_nanocoap_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -373,6 +551,10 @@ Test *tests_nanocoap_tests(void)
         new_TestFixture(test_nanocoap__server_reply_simple),
         new_TestFixture(test_nanocoap__server_get_req_con),
         new_TestFixture(test_nanocoap__server_reply_simple_con),
+        new_TestFixture(test_nanocoap__resource_index),
+        new_TestFixture(test_nanocoap__resource_index_no_path),
+        new_TestFixture(test_nanocoap__resource_index_overflow),
+        new_TestFixture(test_nanocoap__options),
     };
 
     EMB_UNIT_TESTCALLER(nanocoap_tests, NULL, NULL, fixtures);
@@ -32,7 +32,7 @@
 int main(void)
 {
     msg_t m, tmsg;
-    xtimer_t t;
+    xtimer_t t = { 0 };
     int64_t offset = -(TEST_PERIOD/10);
     tmsg.type = 42;
     puts("[START]");